@@ -0,0 +1,71 @@
+/*    This file is part of turing_machine_solver
+      Copyright (C) 2024  Julien Thevenon ( julien_thevenon at yahoo.fr )
+
+      This program is free software: you can redistribute it and/or modify
+      it under the terms of the GNU General Public License as published by
+      the Free Software Foundation, either version 3 of the License, or
+      (at your option) any later version.
+
+      This program is distributed in the hope that it will be useful,
+      but WITHOUT ANY WARRANTY; without even the implied warranty of
+      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+      GNU General Public License for more details.
+
+      You should have received a copy of the GNU General Public License
+      along with this program.  If not, see <http://www.gnu.org/licenses/>
+*/
+
+#ifndef TURING_MACHINE_SOLVER_ALLOCATION_COUNTER_H
+#define TURING_MACHINE_SOLVER_ALLOCATION_COUNTER_H
+
+#include <cstdint>
+
+namespace turing_machine_solver
+{
+    /**
+     * Number of heap allocations done by each thread. Allocations are only
+     * counted when ENABLE_ALLOCATION_CHECK is defined, the executable then
+     * replaces global operator new to call record
+     */
+    class allocation_counter
+    {
+    public:
+
+#ifdef ENABLE_ALLOCATION_CHECK
+        static constexpr bool m_enabled = true;
+#else // ENABLE_ALLOCATION_CHECK
+        static constexpr bool m_enabled = false;
+#endif // ENABLE_ALLOCATION_CHECK
+
+        inline static
+        void
+        record();
+
+        /**
+         * Number of allocations done by current thread
+         */
+        [[nodiscard]] inline static
+        uint64_t
+        get_nb_allocations();
+
+    private:
+
+        inline static thread_local uint64_t m_nb_allocations = 0;
+    };
+
+    //-------------------------------------------------------------------------
+    void
+    allocation_counter::record()
+    {
+        ++m_nb_allocations;
+    }
+
+    //-------------------------------------------------------------------------
+    uint64_t
+    allocation_counter::get_nb_allocations()
+    {
+        return m_nb_allocations;
+    }
+}
+#endif //TURING_MACHINE_SOLVER_ALLOCATION_COUNTER_H
+// EOF
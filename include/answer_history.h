@@ -0,0 +1,303 @@
+/*    This file is part of turing_machine_solver
+      Copyright (C) 2024  Julien Thevenon ( julien_thevenon at yahoo.fr )
+
+      This program is free software: you can redistribute it and/or modify
+      it under the terms of the GNU General Public License as published by
+      the Free Software Foundation, either version 3 of the License, or
+      (at your option) any later version.
+
+      This program is distributed in the hope that it will be useful,
+      but WITHOUT ANY WARRANTY; without even the implied warranty of
+      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+      GNU General Public License for more details.
+
+      You should have received a copy of the GNU General Public License
+      along with this program.  If not, see <http://www.gnu.org/licenses/>
+*/
+
+#ifndef TURING_MACHINE_SOLVER_ANSWER_HISTORY_H
+#define TURING_MACHINE_SOLVER_ANSWER_HISTORY_H
+
+#include "solver.h"
+#include "criteria_space.h"
+#include "contradiction_detector.h"
+#include <functional>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace turing_machine_solver
+{
+    /**
+     * Answers of a game grouped by rounds, so that a set of conflicting
+     * answers can be rolled back by replaying remaining ones from initial
+     * solver. Interactive mode and scripted games share it so that they
+     * consume rollback tokens the same way. Answers are recorded up to
+     * contradiction_detector::m_max_answers, rollback is disabled beyond
+     */
+    class answer_history
+    {
+    public:
+        /**
+         * @param p_initial_solver solver before any answer
+         * @param p_checkers_id ids of game checkers
+         * @param p_space criteria of game checkers, built on first
+         * contradiction check if null
+         */
+        inline
+        answer_history(solver p_initial_solver
+                      ,const std::vector<unsigned int> & p_checkers_id
+                      ,const criteria_space * p_space = nullptr
+                      );
+
+        /**
+         * Next answers are checks of this code until next round
+         */
+        inline
+        void
+        start_round(unsigned int p_code_index);
+
+        /**
+         * Proposed code is no longer checked
+         */
+        inline
+        void
+        end_round();
+
+        inline
+        void
+        add(unsigned int p_checker_index
+           ,bool p_result
+           );
+
+        [[nodiscard]] inline
+        bool
+        is_rollback_enabled() const;
+
+        [[nodiscard]] inline
+        const std::vector<checker_answer> &
+        get_answers() const;
+
+        [[nodiscard]] inline
+        bool
+        is_contradictory();
+
+        /**
+         * Smallest sets of conflicting answers, see contradiction_detector
+         */
+        [[nodiscard]] inline
+        std::vector<uint64_t>
+        get_minimal_conflicts();
+
+        /**
+         * Remove answers, remaining ones keep their order and round
+         * @param p_answers bitfield of answer indexes
+         */
+        inline
+        void
+        remove(uint64_t p_answers);
+
+        /**
+         * Reset solver to initial state without display and analyze
+         * recorded answers. Conditions of a code are those of the state
+         * preceding the first answer of its round, like during game
+         * @param p_solver solver to reset
+         * @param p_replayed called for each analyzed answer
+         * @return conditions of code of current round if any
+         */
+        [[nodiscard]] inline
+        std::optional<potential_checkers>
+        replay(solver & p_solver
+              ,const std::function<void(const checker_answer &)> & p_replayed = {}
+              ) const;
+
+    private:
+
+        [[nodiscard]] inline
+        contradiction_detector &
+        get_detector();
+
+        solver m_initial_solver;
+
+        std::vector<unsigned int> m_checkers_id;
+
+        const criteria_space * m_space;
+
+        std::unique_ptr<criteria_space> m_own_space;
+
+        /**
+         * Built when answers are first checked as it needs criteria
+         */
+        std::optional<contradiction_detector> m_detector;
+
+        std::vector<checker_answer> m_answers;
+
+        /**
+         * Round of each answer
+         */
+        std::vector<unsigned int> m_rounds;
+
+        unsigned int m_nb_rounds;
+
+        std::optional<unsigned int> m_current_code;
+
+        bool m_rollback_enabled;
+    };
+
+    //-------------------------------------------------------------------------
+    answer_history::answer_history(solver p_initial_solver
+                                  ,const std::vector<unsigned int> & p_checkers_id
+                                  ,const criteria_space * p_space
+                                  )
+    :m_initial_solver{std::move(p_initial_solver)}
+    ,m_checkers_id{p_checkers_id}
+    ,m_space{p_space}
+    ,m_nb_rounds{0}
+    ,m_rollback_enabled{true}
+    {
+        m_initial_solver.set_output(nullptr);
+    }
+
+    //-------------------------------------------------------------------------
+    void
+    answer_history::start_round(unsigned int p_code_index)
+    {
+        m_current_code = p_code_index;
+        ++m_nb_rounds;
+    }
+
+    //-------------------------------------------------------------------------
+    void
+    answer_history::end_round()
+    {
+        m_current_code.reset();
+    }
+
+    //-------------------------------------------------------------------------
+    void
+    answer_history::add(unsigned int p_checker_index
+                       ,bool p_result
+                       )
+    {
+        if(!m_current_code)
+        {
+            throw quicky_exception::quicky_logic_exception("No code being checked", __LINE__, __FILE__);
+        }
+        m_rollback_enabled = m_rollback_enabled && m_answers.size() < contradiction_detector::m_max_answers;
+        if(!m_rollback_enabled)
+        {
+            return;
+        }
+        m_answers.push_back({*m_current_code, p_checker_index, p_result});
+        m_rounds.emplace_back(m_nb_rounds);
+        if(m_detector)
+        {
+            m_detector->add(m_answers.back());
+        }
+    }
+
+    //-------------------------------------------------------------------------
+    bool
+    answer_history::is_rollback_enabled() const
+    {
+        return m_rollback_enabled;
+    }
+
+    //-------------------------------------------------------------------------
+    const std::vector<checker_answer> &
+    answer_history::get_answers() const
+    {
+        return m_answers;
+    }
+
+    //-------------------------------------------------------------------------
+    contradiction_detector &
+    answer_history::get_detector()
+    {
+        if(!m_detector)
+        {
+            std::vector<std::shared_ptr<checker_if>> l_checkers;
+            for(auto l_id: m_checkers_id)
+            {
+                l_checkers.emplace_back(solver::get_checker(l_id));
+            }
+            if(!m_space)
+            {
+                m_own_space = std::make_unique<criteria_space>(l_checkers);
+                m_space = m_own_space.get();
+            }
+            m_detector.emplace(condition_table{l_checkers}, m_initial_solver.get_remaining_codes(), m_space);
+            for(const auto & l_answer: m_answers)
+            {
+                m_detector->add(l_answer);
+            }
+        }
+        return *m_detector;
+    }
+
+    //-------------------------------------------------------------------------
+    bool
+    answer_history::is_contradictory()
+    {
+        return get_detector().is_contradictory();
+    }
+
+    //-------------------------------------------------------------------------
+    std::vector<uint64_t>
+    answer_history::get_minimal_conflicts()
+    {
+        return get_detector().get_minimal_conflicts();
+    }
+
+    //-------------------------------------------------------------------------
+    void
+    answer_history::remove(uint64_t p_answers)
+    {
+        get_detector().remove(p_answers);
+        std::vector<unsigned int> l_rounds;
+        for(unsigned int l_index = 0; l_index < m_rounds.size(); ++l_index)
+        {
+            if(!(p_answers >> l_index & 1))
+            {
+                l_rounds.emplace_back(m_rounds[l_index]);
+            }
+        }
+        m_rounds = std::move(l_rounds);
+        m_answers = m_detector->get_answers();
+    }
+
+    //-------------------------------------------------------------------------
+    std::optional<potential_checkers>
+    answer_history::replay(solver & p_solver
+                          ,const std::function<void(const checker_answer &)> & p_replayed
+                          ) const
+    {
+        p_solver = m_initial_solver;
+        std::optional<potential_checkers> l_conditions;
+        std::optional<potential_checkers> l_current;
+        for(unsigned int l_index = 0; l_index < m_answers.size(); ++l_index)
+        {
+            const checker_answer & l_answer = m_answers[l_index];
+            if(!l_index || m_rounds[l_index] != m_rounds[l_index - 1])
+            {
+                l_conditions = p_solver.get_related_checkers(condition_table::index_code(l_answer.m_code_index));
+                if(m_current_code && m_rounds[l_index] == m_nb_rounds)
+                {
+                    l_current = l_conditions;
+                }
+            }
+            p_solver.analyze_result(*l_conditions, l_answer.m_checker_index, l_answer.m_result);
+            if(p_replayed)
+            {
+                p_replayed(l_answer);
+            }
+        }
+        if(m_current_code && !l_current)
+        {
+            l_current = p_solver.get_related_checkers(condition_table::index_code(*m_current_code));
+        }
+        return l_current;
+    }
+}
+#endif //TURING_MACHINE_SOLVER_ANSWER_HISTORY_H
+// EOF
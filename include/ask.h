@@ -18,55 +18,206 @@
 #ifndef TURING_MACHINE_SOLVER_ASK_H
 #define TURING_MACHINE_SOLVER_ASK_H
 
+#include "script_reader.h"
 #include "quicky_exception.h"
 #include <string>
-#include <queue>
+#include <string_view>
 #include <charconv>
+#include <algorithm>
 #include <cassert>
 #include <sstream>
 #include <fstream>
+#include <iostream>
+#include <coroutine>
 
 namespace turing_machine_solver
 {
+    /**
+     * Source of values typed by player. Values given at construction are
+     * scripted: they are displayed when read. Other values come either from
+     * std::cin with blocking next or are pushed by caller when a coroutine
+     * waits on async_next, so that one thread can drive many games.
+     * Values are parsed in place from script and pushed buffers by
+     * script_reader so both use the same separators
+     */
     class ask
     {
     public:
-        inline
-        ask(const std::string & p_string);
+        /**
+         * @param p_string comma separated scripted values, moved in when
+         * possible as it is parsed in place
+         * @param p_output stream where scripted values are displayed
+         * @param p_log_name file where all values are logged, no log if empty
+         * @param p_echo display scripted values when they are read
+         */
+        inline explicit
+        ask(std::string p_string
+           ,std::ostream & p_output = std::cout
+           ,const std::string & p_log_name = "turing.log"
+           ,bool p_echo = true
+           );
+
+        /**
+         * Content of a script file
+         */
+        [[nodiscard]] inline static
+        std::string
+        read_script(const std::string & p_file_name);
 
         inline
         ~ask();
 
+        ask(const ask &) = delete;
+
+        ask &
+        operator=(const ask &) = delete;
+
         template <typename T>
         [[nodiscard]] inline
         T
         next();
 
+        template <typename T>
+        class awaiter
+        {
+        public:
+            inline explicit
+            awaiter(ask & p_ask);
+
+            [[nodiscard]] inline
+            bool
+            await_ready() const;
+
+            inline
+            void
+            await_suspend(std::coroutine_handle<> p_handle);
+
+            [[nodiscard]] inline
+            T
+            await_resume();
+
+        private:
+            ask & m_ask;
+        };
+
+        /**
+         * Awaitable value: ready immediately if a value is available,
+         * otherwise coroutine is suspended until push or close
+         */
+        template <typename T>
+        [[nodiscard]] inline
+        awaiter<T>
+        async_next();
+
+        /**
+         * Add comma or space separated values typed by player and resume
+         * coroutine waiting for a value if any
+         */
+        inline
+        void
+        push(std::string_view p_values);
+
+        /**
+         * Indicate no more value will be pushed, a waiting coroutine is
+         * resumed and gets an exception
+         */
+        inline
+        void
+        close();
+
+        /**
+         * Indicate if a coroutine is suspended waiting for a value
+         */
+        [[nodiscard]] inline
+        bool
+        is_waiting() const;
+
     private:
-        std::queue<std::string> m_fifo;
+
+        template <typename T>
+        [[nodiscard]] inline
+        T
+        pop();
+
+        template <typename T>
+        inline
+        void
+        log(const T & p_value);
+
+        /**
+         * Indicate if a value can be read without waiting
+         */
+        [[nodiscard]] inline
+        bool
+        has_value() const;
+
+        std::string m_script;
+        script_reader m_script_reader;
+
+        /**
+         * Pushed values not yet read, emptied when all are read so that
+         * its capacity is reused
+         */
+        std::string m_pushed;
+        script_reader m_pushed_reader;
+
+        /**
+         * Number of pushed characters before those of m_pushed, to report
+         * offset of errors in input seen as all pushes joined by commas
+         */
+        size_t m_pushed_offset;
+
+        std::ostream & m_output;
         std::ofstream m_log_file;
+        bool m_echo;
         bool m_on_going;
+        bool m_closed;
+        std::coroutine_handle<> m_waiting;
     };
 
     //-------------------------------------------------------------------------
-    ask::ask(const std::string & p_string)
-    : m_log_file("turing.log")
+    ask::ask(std::string p_string
+            ,std::ostream & p_output
+            ,const std::string & p_log_name
+            ,bool p_echo
+            )
+    : m_script{std::move(p_string)}
+    , m_script_reader{m_script}
+    , m_pushed_reader{m_pushed}
+    , m_pushed_offset{0}
+    , m_output{p_output}
+    , m_echo{p_echo}
     , m_on_going{false}
+    , m_closed{false}
     {
-        std::string l_token;
-        std::stringstream l_stream;
-        l_stream << p_string;
-        while(std::getline(l_stream, l_token, ','))
+        if(!p_log_name.empty())
         {
-            m_fifo.push(l_token);
+            m_log_file.open(p_log_name);
         }
     }
 
+    //-------------------------------------------------------------------------
+    std::string
+    ask::read_script(const std::string & p_file_name)
+    {
+        std::ifstream l_file{p_file_name, std::ios::binary};
+        if(!l_file.is_open())
+        {
+            throw quicky_exception::quicky_runtime_exception("Unable to open " + p_file_name, __LINE__, __FILE__);
+        }
+        std::stringstream l_content;
+        l_content << l_file.rdbuf();
+        return l_content.str();
+    }
+
     //-------------------------------------------------------------------------
     ask::~ask()
     {
-        m_log_file << std::endl;
-        m_log_file.close();
+        if(m_log_file.is_open())
+        {
+            m_log_file << std::endl;
+            m_log_file.close();
+        }
     }
 
     //-------------------------------------------------------------------------
@@ -74,38 +225,128 @@ namespace turing_machine_solver
     T
     ask::next()
     {
-        T l_result;
-        if(m_fifo.empty())
+        if(!has_value())
         {
+            T l_result;
             std::cin >> l_result;
+            log(l_result);
+            return l_result;
         }
-        else
+        return pop<T>();
+    }
+
+    //-------------------------------------------------------------------------
+    template <typename T>
+    ask::awaiter<T>
+    ask::async_next()
+    {
+        return awaiter<T>{*this};
+    }
+
+    //-------------------------------------------------------------------------
+    void
+    ask::push(std::string_view p_values)
+    {
+        // Separator ensures last pending value is not merged with new ones
+        if(m_pushed_offset || !m_pushed.empty())
         {
-            std::string l_value = m_fifo.front();
-            m_fifo.pop();
-            auto [ptr, l_status] = std::from_chars(l_value.data(), l_value.data() + l_value.size(), l_result);
-            if (l_status == std::errc())
-            {
-                std::cout << l_result << std::endl;
-            } else if (l_status == std::errc::invalid_argument)
-            {
-                throw quicky_exception::quicky_logic_exception("Invalid ask argument " + l_value
-                                                              , __LINE__
-                                                              , __FILE__
-                                                              );
-            } else if (l_status == std::errc::result_out_of_range) {
-                throw quicky_exception::quicky_logic_exception("Out of range argument " + l_value
-                                                              , __LINE__
-                                                              , __FILE__
-                                                              );
-            }
-            else
+            m_pushed += ',';
+        }
+        m_pushed += p_values;
+        m_pushed_reader.extend(m_pushed);
+        if(m_waiting && has_value())
+        {
+            std::coroutine_handle<> l_handle = m_waiting;
+            m_waiting = nullptr;
+            l_handle.resume();
+        }
+    }
+
+    //-------------------------------------------------------------------------
+    void
+    ask::close()
+    {
+        m_closed = true;
+        if(m_waiting)
+        {
+            std::coroutine_handle<> l_handle = m_waiting;
+            m_waiting = nullptr;
+            l_handle.resume();
+        }
+    }
+
+    //-------------------------------------------------------------------------
+    bool
+    ask::is_waiting() const
+    {
+        return static_cast<bool>(m_waiting);
+    }
+
+    //-------------------------------------------------------------------------
+    template <typename T>
+    T
+    ask::pop()
+    {
+        if(!has_value())
+        {
+            throw quicky_exception::quicky_logic_exception("No more ask argument", __LINE__, __FILE__);
+        }
+        bool l_scripted = !m_script_reader.is_empty();
+        script_reader & l_reader = l_scripted ? m_script_reader : m_pushed_reader;
+        size_t l_position = l_reader.get_position();
+        std::string_view l_value = l_reader.next_token();
+        // Location is only formatted on error so parsing a token does not allocate
+        auto l_where = [&]()
+                       {
+                           return " at offset " + std::to_string(l_scripted ? l_position : m_pushed_offset + l_position) + (l_scripted ? " of script" : " of input");
+                       };
+        T l_result;
+        auto [l_ptr, l_status] = std::from_chars(l_value.data(), l_value.data() + l_value.size(), l_result);
+        if (l_status == std::errc() && l_ptr == l_value.data() + l_value.size())
+        {
+            if(l_scripted && m_echo)
             {
-                throw quicky_exception::quicky_logic_exception("Unknown ask exception"
-                                                              , __LINE__
-                                                              , __FILE__
-                                                              );
+                // Same stream as questions so order is kept without flushing
+                m_output << l_result << '\n';
             }
+        } else if (l_status == std::errc::result_out_of_range) {
+            throw quicky_exception::quicky_logic_exception("Out of range argument " + std::string(l_value) + l_where()
+                                                          , __LINE__
+                                                          , __FILE__
+                                                          );
+        }
+        else
+        {
+            throw quicky_exception::quicky_logic_exception("Invalid ask argument " + std::string(l_value) + l_where()
+                                                          , __LINE__
+                                                          , __FILE__
+                                                          );
+        }
+        log(l_value);
+        if(!l_scripted && m_pushed_reader.is_empty())
+        {
+            m_pushed_offset += m_pushed.size();
+            m_pushed.clear();
+            m_pushed_reader = script_reader{m_pushed};
+        }
+        return l_result;
+    }
+
+    //-------------------------------------------------------------------------
+    bool
+    ask::has_value() const
+    {
+        return !m_script_reader.is_empty() || !m_pushed_reader.is_empty();
+    }
+
+    //-------------------------------------------------------------------------
+    template <typename T>
+    void
+    ask::log(const T & p_value)
+    {
+        if(!m_log_file.is_open())
+        {
+            return;
         }
         if(m_on_going)
         {
@@ -115,9 +356,40 @@ namespace turing_machine_solver
         {
             m_on_going = true;
         }
-        m_log_file << l_result;
-        return l_result;
+        m_log_file << p_value;
+    }
+
+    //-------------------------------------------------------------------------
+    template <typename T>
+    ask::awaiter<T>::awaiter(ask & p_ask)
+    :m_ask{p_ask}
+    {
+    }
+
+    //-------------------------------------------------------------------------
+    template <typename T>
+    bool
+    ask::awaiter<T>::await_ready() const
+    {
+        return m_ask.has_value() || m_ask.m_closed;
+    }
+
+    //-------------------------------------------------------------------------
+    template <typename T>
+    void
+    ask::awaiter<T>::await_suspend(std::coroutine_handle<> p_handle)
+    {
+        assert(!m_ask.m_waiting);
+        m_ask.m_waiting = p_handle;
+    }
+
+    //-------------------------------------------------------------------------
+    template <typename T>
+    T
+    ask::awaiter<T>::await_resume()
+    {
+        return m_ask.pop<T>();
     }
 }
 #endif //TURING_MACHINE_SOLVER_ASK_H
-// EOF
\ No newline at end of file
+// EOF
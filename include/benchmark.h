@@ -0,0 +1,340 @@
+/*    This file is part of turing_machine_solver
+      Copyright (C) 2024  Julien Thevenon ( julien_thevenon at yahoo.fr )
+
+      This program is free software: you can redistribute it and/or modify
+      it under the terms of the GNU General Public License as published by
+      the Free Software Foundation, either version 3 of the License, or
+      (at your option) any later version.
+
+      This program is distributed in the hope that it will be useful,
+      but WITHOUT ANY WARRANTY; without even the implied warranty of
+      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+      GNU General Public License for more details.
+
+      You should have received a copy of the GNU General Public License
+      along with this program.  If not, see <http://www.gnu.org/licenses/>
+*/
+
+#ifndef TURING_MACHINE_SOLVER_BENCHMARK_H
+#define TURING_MACHINE_SOLVER_BENCHMARK_H
+
+#include "quicky_exception.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace turing_machine_solver
+{
+    /**
+     * Statistics of repeated executions of a benchmark case, durations in
+     * nanoseconds
+     */
+    class benchmark_result
+    {
+    public:
+        inline
+        benchmark_result(std::string p_name
+                        ,std::vector<uint64_t> p_durations
+                        );
+
+        [[nodiscard]] inline
+        const std::string &
+        get_name() const;
+
+        [[nodiscard]] inline
+        size_t
+        get_nb_repetitions() const;
+
+        [[nodiscard]] inline
+        uint64_t
+        get_min() const;
+
+        [[nodiscard]] inline
+        uint64_t
+        get_max() const;
+
+        [[nodiscard]] inline
+        uint64_t
+        get_mean() const;
+
+        /**
+         * Nearest rank percentile
+         * @param p_percent percentage in ]0,100]
+         */
+        [[nodiscard]] inline
+        uint64_t
+        get_percentile(double p_percent) const;
+
+    private:
+
+        std::string m_name;
+
+        /**
+         * Sorted durations
+         */
+        std::vector<uint64_t> m_durations;
+    };
+
+    /**
+     * Run benchmark cases with warm up and repetitions then report their
+     * statistics as a table, JSON or CSV
+     */
+    class benchmark
+    {
+    public:
+
+        /**
+         * @param p_nb_warmups executions of a case before measure
+         * @param p_nb_repetitions measured executions of a case
+         * @param p_filter only cases whose name contains it are run
+         */
+        inline
+        benchmark(unsigned int p_nb_warmups
+                 ,unsigned int p_nb_repetitions
+                 ,std::string p_filter = ""
+                 );
+
+        /**
+         * Measure a case
+         * @param p_func function executed at each repetition
+         */
+        inline
+        void
+        run(const std::string & p_name
+           ,const std::function<void()> & p_func
+           );
+
+        /**
+         * Measure a case whose function measures itself, to exclude its
+         * preparation
+         * @param p_func function returning measured duration
+         */
+        inline
+        void
+        run_timed(const std::string & p_name
+                 ,const std::function<std::chrono::nanoseconds()> & p_func
+                 );
+
+        [[nodiscard]] inline
+        const std::vector<benchmark_result> &
+        get_results() const;
+
+        inline
+        void
+        display(std::ostream & p_stream) const;
+
+        inline
+        void
+        save_json(std::ostream & p_stream) const;
+
+        inline
+        void
+        save_csv(std::ostream & p_stream) const;
+
+    private:
+
+        unsigned int m_nb_warmups;
+
+        unsigned int m_nb_repetitions;
+
+        std::string m_filter;
+
+        std::vector<benchmark_result> m_results;
+    };
+
+    //-------------------------------------------------------------------------
+    benchmark_result::benchmark_result(std::string p_name
+                                      ,std::vector<uint64_t> p_durations
+                                      )
+    :m_name{std::move(p_name)}
+    ,m_durations{std::move(p_durations)}
+    {
+        if(m_durations.empty())
+        {
+            throw quicky_exception::quicky_logic_exception("No measure for benchmark " + m_name, __LINE__, __FILE__);
+        }
+        std::sort(m_durations.begin(), m_durations.end());
+    }
+
+    //-------------------------------------------------------------------------
+    const std::string &
+    benchmark_result::get_name() const
+    {
+        return m_name;
+    }
+
+    //-------------------------------------------------------------------------
+    size_t
+    benchmark_result::get_nb_repetitions() const
+    {
+        return m_durations.size();
+    }
+
+    //-------------------------------------------------------------------------
+    uint64_t
+    benchmark_result::get_min() const
+    {
+        return m_durations.front();
+    }
+
+    //-------------------------------------------------------------------------
+    uint64_t
+    benchmark_result::get_max() const
+    {
+        return m_durations.back();
+    }
+
+    //-------------------------------------------------------------------------
+    uint64_t
+    benchmark_result::get_mean() const
+    {
+        uint64_t l_total = 0;
+        for(auto l_duration: m_durations)
+        {
+            l_total += l_duration;
+        }
+        return l_total / m_durations.size();
+    }
+
+    //-------------------------------------------------------------------------
+    uint64_t
+    benchmark_result::get_percentile(double p_percent) const
+    {
+        auto l_rank = static_cast<size_t>(std::ceil(p_percent / 100.0 * static_cast<double>(m_durations.size())));
+        return m_durations[std::clamp<size_t>(l_rank, 1, m_durations.size()) - 1];
+    }
+
+    //-------------------------------------------------------------------------
+    benchmark::benchmark(unsigned int p_nb_warmups
+                        ,unsigned int p_nb_repetitions
+                        ,std::string p_filter
+                        )
+    :m_nb_warmups{p_nb_warmups}
+    ,m_nb_repetitions{std::max(p_nb_repetitions, 1u)}
+    ,m_filter{std::move(p_filter)}
+    {
+    }
+
+    //-------------------------------------------------------------------------
+    void
+    benchmark::run(const std::string & p_name
+                  ,const std::function<void()> & p_func
+                  )
+    {
+        run_timed(p_name
+                 ,[&]()
+                  {
+                      auto l_start = std::chrono::steady_clock::now();
+                      p_func();
+                      return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - l_start);
+                  }
+                 );
+    }
+
+    //-------------------------------------------------------------------------
+    void
+    benchmark::run_timed(const std::string & p_name
+                        ,const std::function<std::chrono::nanoseconds()> & p_func
+                        )
+    {
+        if(std::string::npos == p_name.find(m_filter))
+        {
+            return;
+        }
+        for(unsigned int l_index = 0; l_index < m_nb_warmups; ++l_index)
+        {
+            (void)p_func();
+        }
+        std::vector<uint64_t> l_durations;
+        l_durations.reserve(m_nb_repetitions);
+        for(unsigned int l_index = 0; l_index < m_nb_repetitions; ++l_index)
+        {
+            l_durations.emplace_back(static_cast<uint64_t>(p_func().count()));
+        }
+        m_results.emplace_back(p_name, std::move(l_durations));
+    }
+
+    //-------------------------------------------------------------------------
+    const std::vector<benchmark_result> &
+    benchmark::get_results() const
+    {
+        return m_results;
+    }
+
+    //-------------------------------------------------------------------------
+    void
+    benchmark::display(std::ostream & p_stream) const
+    {
+        size_t l_width = 4;
+        for(const auto & l_result: m_results)
+        {
+            l_width = std::max(l_width, l_result.get_name().size());
+        }
+        p_stream << std::left << std::setw(static_cast<int>(l_width)) << "Case" << std::right;
+        for(const char * l_title: {"reps", "min(us)", "p50(us)", "p90(us)", "p99(us)", "max(us)", "mean(us)"})
+        {
+            p_stream << std::setw(12) << l_title;
+        }
+        p_stream << '\n';
+        p_stream << std::fixed << std::setprecision(1);
+        for(const auto & l_result: m_results)
+        {
+            p_stream << std::left << std::setw(static_cast<int>(l_width)) << l_result.get_name() << std::right;
+            p_stream << std::setw(12) << l_result.get_nb_repetitions();
+            for(uint64_t l_value: {l_result.get_min(), l_result.get_percentile(50), l_result.get_percentile(90), l_result.get_percentile(99), l_result.get_max(), l_result.get_mean()})
+            {
+                p_stream << std::setw(12) << static_cast<double>(l_value) / 1000.0;
+            }
+            p_stream << '\n';
+        }
+        p_stream << std::defaultfloat << std::flush;
+    }
+
+    //-------------------------------------------------------------------------
+    void
+    benchmark::save_json(std::ostream & p_stream) const
+    {
+        // Case names are built by bench program and contain no character to escape
+        p_stream << "{\"unit\":\"ns\",\"warmups\":" << m_nb_warmups << ",\"cases\":[";
+        bool l_first = true;
+        for(const auto & l_result: m_results)
+        {
+            p_stream << (l_first ? "" : ",") << "\n{\"name\":\"" << l_result.get_name() << "\"";
+            p_stream << ",\"repetitions\":" << l_result.get_nb_repetitions();
+            p_stream << ",\"min\":" << l_result.get_min();
+            p_stream << ",\"p50\":" << l_result.get_percentile(50);
+            p_stream << ",\"p90\":" << l_result.get_percentile(90);
+            p_stream << ",\"p99\":" << l_result.get_percentile(99);
+            p_stream << ",\"max\":" << l_result.get_max();
+            p_stream << ",\"mean\":" << l_result.get_mean() << "}";
+            l_first = false;
+        }
+        p_stream << "\n]}" << std::endl;
+    }
+
+    //-------------------------------------------------------------------------
+    void
+    benchmark::save_csv(std::ostream & p_stream) const
+    {
+        p_stream << "name,repetitions,min_ns,p50_ns,p90_ns,p99_ns,max_ns,mean_ns\n";
+        for(const auto & l_result: m_results)
+        {
+            p_stream << l_result.get_name() << ',' << l_result.get_nb_repetitions();
+            p_stream << ',' << l_result.get_min();
+            p_stream << ',' << l_result.get_percentile(50);
+            p_stream << ',' << l_result.get_percentile(90);
+            p_stream << ',' << l_result.get_percentile(99);
+            p_stream << ',' << l_result.get_max();
+            p_stream << ',' << l_result.get_mean() << '\n';
+        }
+        p_stream << std::flush;
+    }
+}
+#endif //TURING_MACHINE_SOLVER_BENCHMARK_H
+// EOF
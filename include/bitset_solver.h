@@ -0,0 +1,309 @@
+/*    This file is part of turing_machine_solver
+      Copyright (C) 2024  Julien Thevenon ( julien_thevenon at yahoo.fr )
+
+      This program is free software: you can redistribute it and/or modify
+      it under the terms of the GNU General Public License as published by
+      the Free Software Foundation, either version 3 of the License, or
+      (at your option) any later version.
+
+      This program is distributed in the hope that it will be useful,
+      but WITHOUT ANY WARRANTY; without even the implied warranty of
+      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+      GNU General Public License for more details.
+
+      You should have received a copy of the GNU General Public License
+      along with this program.  If not, see <http://www.gnu.org/licenses/>
+*/
+
+#ifndef TURING_MACHINE_SOLVER_BITSET_SOLVER_H
+#define TURING_MACHINE_SOLVER_BITSET_SOLVER_H
+
+#include "solver.h"
+#include "condition_table.h"
+#include "puzzle_record.h"
+#include "quicky_exception.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <numeric>
+#include <ostream>
+#include <vector>
+
+namespace turing_machine_solver
+{
+    /**
+     * Conditions satisfied by a code for each checker, one bitfield per
+     * checker. Displayed like potential_checkers
+     */
+    class packed_signature
+    {
+        friend std::ostream & operator<<(std::ostream &, const packed_signature & );
+
+    public:
+        static constexpr unsigned int m_max_checkers = puzzle_record::m_max_checkers;
+
+        inline
+        packed_signature();
+
+        inline
+        void
+        set(unsigned int p_checker_index
+           ,uint16_t p_conditions
+           );
+
+        [[nodiscard]] inline
+        uint16_t
+        get(unsigned int p_checker_index) const;
+
+        [[nodiscard]] inline
+        unsigned int
+        get_nb_checkers() const;
+
+        [[nodiscard]] inline
+        bool
+        is_valid() const;
+
+        [[nodiscard]] inline
+        bool
+        operator<(const packed_signature & p_signature) const;
+
+        [[nodiscard]] inline
+        bool
+        operator==(const packed_signature & p_signature) const;
+
+    private:
+        std::array<uint16_t, m_max_checkers> m_conditions;
+
+        unsigned int m_nb_checkers;
+    };
+
+    /**
+     * Same results as solver with a code set of remaining codes and packed
+     * signatures precomputed for all codes, so neither construction nor
+     * analysis allocates per code
+     */
+    class bitset_solver
+    {
+    public:
+
+        typedef packed_signature signature;
+
+        /**
+         * @param p_checkers_id ids of checkers of game registry
+         */
+        inline explicit
+        bitset_solver(const std::vector<unsigned int> & p_checkers_id);
+
+        [[nodiscard]] inline
+        unsigned int
+        get_remaining_candidates() const;
+
+        [[nodiscard]] inline
+        const code_set &
+        get_remaining_codes() const;
+
+        /**
+         * Signature of a remaining code
+         */
+        [[nodiscard]] inline
+        const packed_signature &
+        get_related_checkers(const candidate & p_candidate) const;
+
+        /**
+         * Remove codes incompatible with result of a checker for a code,
+         * rules are those of potential_checkers::is_compliant_with
+         * @param p_signature signature of checked code
+         */
+        inline
+        void
+        analyze_result(const packed_signature & p_signature
+                      ,unsigned int p_checker_index
+                      ,bool p_result
+                      );
+
+    private:
+        unsigned int m_nb_checkers;
+
+        std::array<packed_signature, condition_table::m_nb_codes> m_signatures;
+
+        code_set m_remaining;
+    };
+
+    //-------------------------------------------------------------------------
+    packed_signature::packed_signature()
+    :m_conditions{}
+    ,m_nb_checkers{0}
+    {
+    }
+
+    //-------------------------------------------------------------------------
+    void
+    packed_signature::set(unsigned int p_checker_index
+                         ,uint16_t p_conditions
+                         )
+    {
+        assert(p_checker_index < m_max_checkers);
+        m_conditions[p_checker_index] = p_conditions;
+        m_nb_checkers = std::max(m_nb_checkers, p_checker_index + 1);
+    }
+
+    //-------------------------------------------------------------------------
+    uint16_t
+    packed_signature::get(unsigned int p_checker_index) const
+    {
+        assert(p_checker_index < m_nb_checkers);
+        return m_conditions[p_checker_index];
+    }
+
+    //-------------------------------------------------------------------------
+    unsigned int
+    packed_signature::get_nb_checkers() const
+    {
+        return m_nb_checkers;
+    }
+
+    //-------------------------------------------------------------------------
+    bool
+    packed_signature::is_valid() const
+    {
+        return std::all_of(m_conditions.begin(), m_conditions.begin() + m_nb_checkers, [](uint16_t p_conditions){return p_conditions;});
+    }
+
+    //-------------------------------------------------------------------------
+    bool
+    packed_signature::operator<(const packed_signature & p_signature) const
+    {
+        return m_conditions < p_signature.m_conditions;
+    }
+
+    //-------------------------------------------------------------------------
+    bool
+    packed_signature::operator==(const packed_signature & p_signature) const
+    {
+        return m_conditions == p_signature.m_conditions;
+    }
+
+    //-------------------------------------------------------------------------
+    std::ostream &
+    operator<<(std::ostream & p_stream
+              ,const packed_signature & p_signature
+              )
+    {
+        for(unsigned int l_index = 0; l_index < p_signature.m_nb_checkers; ++l_index)
+        {
+            if(p_signature.m_conditions[l_index])
+            {
+                puzzle_record::display_conditions(p_stream, p_signature.m_conditions[l_index]);
+            }
+            else
+            {
+                p_stream << "-";
+            }
+        }
+        return p_stream;
+    }
+
+    //-------------------------------------------------------------------------
+    bitset_solver::bitset_solver(const std::vector<unsigned int> & p_checkers_id)
+    :m_nb_checkers{static_cast<unsigned int>(p_checkers_id.size())}
+    {
+        if(m_nb_checkers > packed_signature::m_max_checkers)
+        {
+            throw quicky_exception::quicky_logic_exception("Too many checkers " + std::to_string(m_nb_checkers), __LINE__, __FILE__);
+        }
+        for(unsigned int l_checker_index = 0; l_checker_index < m_nb_checkers; ++l_checker_index)
+        {
+            auto l_checker = solver::get_registry().get_checker(p_checkers_id[l_checker_index]);
+            if(l_checker->get_grade() > 16)
+            {
+                throw quicky_exception::quicky_logic_exception("Checker " + std::to_string(l_checker->get_id()) + " has too many conditions", __LINE__, __FILE__);
+            }
+            std::array<uint16_t, condition_table::m_nb_codes> l_conditions{};
+            for(unsigned int l_condition_index = 0; l_condition_index < l_checker->get_grade(); ++l_condition_index)
+            {
+                code_set l_mask = condition_table::compute_mask(*l_checker, l_condition_index);
+                for(unsigned int l_code_index = 0; l_code_index < condition_table::m_nb_codes; ++l_code_index)
+                {
+                    l_conditions[l_code_index] |= static_cast<uint16_t>(l_mask.test(l_code_index) << l_condition_index);
+                }
+            }
+            for(unsigned int l_code_index = 0; l_code_index < condition_table::m_nb_codes; ++l_code_index)
+            {
+                m_signatures[l_code_index].set(l_checker_index, l_conditions[l_code_index]);
+            }
+        }
+
+        // Keep valid codes whose signature is shared with no other valid code
+        std::array<uint8_t, condition_table::m_nb_codes> l_order;
+        std::iota(l_order.begin(), l_order.end(), 0);
+        std::sort(l_order.begin(), l_order.end(), [&](uint8_t p_first, uint8_t p_second){return m_signatures[p_first] < m_signatures[p_second];});
+        for(unsigned int l_index = 0; l_index < condition_table::m_nb_codes;)
+        {
+            unsigned int l_end = l_index + 1;
+            while(l_end < condition_table::m_nb_codes && m_signatures[l_order[l_end]] == m_signatures[l_order[l_index]])
+            {
+                ++l_end;
+            }
+            if(l_end == l_index + 1 && m_signatures[l_order[l_index]].is_valid())
+            {
+                m_remaining.set(l_order[l_index]);
+            }
+            l_index = l_end;
+        }
+    }
+
+    //-------------------------------------------------------------------------
+    unsigned int
+    bitset_solver::get_remaining_candidates() const
+    {
+        return static_cast<unsigned int>(m_remaining.count());
+    }
+
+    //-------------------------------------------------------------------------
+    const code_set &
+    bitset_solver::get_remaining_codes() const
+    {
+        return m_remaining;
+    }
+
+    //-------------------------------------------------------------------------
+    const packed_signature &
+    bitset_solver::get_related_checkers(const candidate & p_candidate) const
+    {
+        unsigned int l_code_index = condition_table::code_index(p_candidate);
+        if(!m_remaining.test(l_code_index))
+        {
+            throw quicky_exception::quicky_logic_exception("Bad candidate", __LINE__, __FILE__);
+        }
+        return m_signatures[l_code_index];
+    }
+
+    //-------------------------------------------------------------------------
+    void
+    bitset_solver::analyze_result(const packed_signature & p_signature
+                                 ,unsigned int p_checker_index
+                                 ,bool p_result
+                                 )
+    {
+        if(p_checker_index >= m_nb_checkers)
+        {
+            throw quicky_exception::quicky_logic_exception("Bad checker value " + std::to_string(p_checker_index), __LINE__, __FILE__);
+        }
+        uint16_t l_checked = p_signature.get(p_checker_index);
+        // True result removes codes with disjoint conditions, false result
+        // removes codes with the same conditions
+        for(unsigned int l_code_index = 0; l_code_index < condition_table::m_nb_codes; ++l_code_index)
+        {
+            if(m_remaining.test(l_code_index))
+            {
+                uint16_t l_conditions = m_signatures[l_code_index].get(p_checker_index);
+                if(p_result ? !(l_conditions & l_checked) : l_conditions == l_checked)
+                {
+                    m_remaining.reset(l_code_index);
+                }
+            }
+        }
+    }
+}
+#endif //TURING_MACHINE_SOLVER_BITSET_SOLVER_H
+// EOF
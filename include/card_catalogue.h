@@ -0,0 +1,686 @@
+/*    This file is part of turing_machine_solver
+      Copyright (C) 2024  Julien Thevenon ( julien_thevenon at yahoo.fr )
+
+      This program is free software: you can redistribute it and/or modify
+      it under the terms of the GNU General Public License as published by
+      the Free Software Foundation, either version 3 of the License, or
+      (at your option) any later version.
+
+      This program is distributed in the hope that it will be useful,
+      but WITHOUT ANY WARRANTY; without even the implied warranty of
+      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+      GNU General Public License for more details.
+
+      You should have received a copy of the GNU General Public License
+      along with this program.  If not, see <http://www.gnu.org/licenses/>
+*/
+
+#ifndef TURING_MACHINE_SOLVER_CARD_CATALOGUE_H
+#define TURING_MACHINE_SOLVER_CARD_CATALOGUE_H
+
+#include "card_checker.h"
+#include "card_definitions.h"
+#include "condition_table.h"
+#include "potential_checkers.h"
+#include "quicky_exception.h"
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <charconv>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace turing_machine_solver
+{
+    /**
+     * Load card definitions written in text and compile each condition
+     * into the mask of codes satisfying it.
+     * A card starts with a "card <id> <name>" line followed by one
+     * "<expression> : <label>" line per condition. Expressions use digits
+     * b, y and p of blue triangle, yellow square and purple circle,
+     * integers, parentheses and C operators ! * / % + - < <= > >= == !=
+     * && ||, comparisons giving 0 or 1. A condition is true for codes where
+     * its expression is not null, and it must be true for at least one code
+     * and differ from the other conditions of its card. Empty lines and
+     * lines starting with # are ignored
+     */
+    class card_catalogue
+    {
+    public:
+
+        /**
+         * Compile cards of a catalogue
+         * @param p_text catalogue content
+         * @param p_source name of catalogue used in error messages
+         * @return one card_checker per card, in catalogue order
+         */
+        [[nodiscard]] inline static
+        std::vector<std::shared_ptr<checker_if>>
+        load(std::string_view p_text
+            ,const std::string & p_source = "catalogue"
+            );
+
+        [[nodiscard]] inline static
+        std::vector<std::shared_ptr<checker_if>>
+        load_file(const std::string & p_file_name);
+
+        /**
+         * Cards of the game, compiled from catalogue embedded in executable
+         */
+        [[nodiscard]] inline static
+        std::vector<std::shared_ptr<checker_if>>
+        load_embedded();
+
+        /**
+         * Replace cards having the same id as an extra card and append the
+         * other extra cards
+         */
+        inline static
+        void
+        merge(std::vector<std::shared_ptr<checker_if>> & p_cards
+             ,const std::vector<std::shared_ptr<checker_if>> & p_extra_cards
+             );
+
+        /**
+         * Codes for which an expression is not null
+         */
+        [[nodiscard]] inline static
+        code_set
+        compile(std::string_view p_expression);
+
+        /**
+         * Display cards with label and number of codes of each condition
+         */
+        inline static
+        void
+        display(const std::vector<std::shared_ptr<checker_if>> & p_cards
+               ,std::ostream & p_stream
+               );
+
+    private:
+
+        /**
+         * Number of values computed for an expression, code count rounded
+         * up so that loops over values have no remainder and vectorize
+         */
+        static constexpr unsigned int m_nb_lanes = 128;
+
+        /**
+         * Value of an expression for each code, indexed by code index.
+         * Values after last code are not meaningful. Arithmetic is checked
+         * so that no expression can overflow
+         */
+        typedef std::array<int64_t, m_nb_lanes> values;
+
+        /**
+         * Recursive descent parser evaluating each sub expression for all
+         * codes at once, so no expression tree is built
+         */
+        class compiler
+        {
+        public:
+            inline explicit
+            compiler(std::string_view p_expression);
+
+            [[nodiscard]] inline
+            code_set
+            run();
+
+        private:
+
+            [[nodiscard]] inline
+            values
+            parse_or();
+
+            [[nodiscard]] inline
+            values
+            parse_and();
+
+            [[nodiscard]] inline
+            values
+            parse_equality();
+
+            [[nodiscard]] inline
+            values
+            parse_relational();
+
+            [[nodiscard]] inline
+            values
+            parse_additive();
+
+            [[nodiscard]] inline
+            values
+            parse_multiplicative();
+
+            [[nodiscard]] inline
+            values
+            parse_unary();
+
+            [[nodiscard]] inline
+            values
+            parse_primary();
+
+            /**
+             * Consume an operator if it is next token. Callers try longer
+             * operators first so < does not match start of <=
+             */
+            [[nodiscard]] inline
+            bool
+            accept(std::string_view p_operator);
+
+            inline
+            void
+            skip_spaces();
+
+            [[noreturn]] inline
+            void
+            error(const std::string & p_message) const;
+
+            template <typename OPERATION>
+            [[nodiscard]] inline static
+            values
+            combine(const values & p_left
+                   ,const values & p_right
+                   ,OPERATION p_operation
+                   );
+
+            /**
+             * Combine values with an operation reporting overflow like
+             * __builtin_add_overflow
+             */
+            template <typename OPERATION>
+            [[nodiscard]] inline
+            values
+            combine_checked(const values & p_left
+                           ,const values & p_right
+                           ,OPERATION p_operation
+                           ) const;
+
+            std::string_view m_expression;
+
+            size_t m_position;
+        };
+
+        [[nodiscard]] inline static
+        std::string_view
+        trim(std::string_view p_text);
+    };
+
+    //-------------------------------------------------------------------------
+    std::vector<std::shared_ptr<checker_if>>
+    card_catalogue::load(std::string_view p_text
+                        ,const std::string & p_source
+                        )
+    {
+        std::vector<std::shared_ptr<checker_if>> l_result;
+        std::set<unsigned int> l_ids;
+        unsigned int l_id = 0;
+        std::string l_name;
+        std::vector<std::pair<code_set, std::string>> l_conditions;
+        unsigned int l_line_number = 0;
+        auto l_error = [&](const std::string & p_message)
+        {
+            throw quicky_exception::quicky_logic_exception(p_source + ":" + std::to_string(l_line_number) + ": " + p_message, __LINE__, __FILE__);
+        };
+        auto l_close_card = [&]()
+        {
+            if(l_conditions.empty())
+            {
+                l_error("card " + std::to_string(l_id) + " has no condition");
+            }
+            l_result.emplace_back(std::make_shared<card_checker>(l_id, std::move(l_name), std::move(l_conditions)));
+            l_name.clear();
+            l_conditions.clear();
+        };
+
+        size_t l_start = 0;
+        while(l_start < p_text.size())
+        {
+            size_t l_end = std::min(p_text.find('\n', l_start), p_text.size());
+            std::string_view l_line = trim(p_text.substr(l_start, l_end - l_start));
+            l_start = l_end + 1;
+            ++l_line_number;
+            if(l_line.empty() || '#' == l_line.front())
+            {
+                continue;
+            }
+            if(l_line.starts_with("card ") || l_line.starts_with("card\t"))
+            {
+                if(!l_ids.empty())
+                {
+                    l_close_card();
+                }
+                std::string_view l_definition = trim(l_line.substr(5));
+                auto [l_id_end, l_status] = std::from_chars(l_definition.data(), l_definition.data() + l_definition.size(), l_id);
+                if(l_status != std::errc() || !l_id || l_id > std::numeric_limits<uint8_t>::max())
+                {
+                    l_error("bad card id");
+                }
+                if(!l_ids.insert(l_id).second)
+                {
+                    l_error("card " + std::to_string(l_id) + " defined twice");
+                }
+                l_name = trim(l_definition.substr(static_cast<size_t>(l_id_end - l_definition.data())));
+                continue;
+            }
+            if(l_ids.empty())
+            {
+                l_error("condition outside of a card");
+            }
+            if(l_conditions.size() == potential_checkers::m_max_conditions)
+            {
+                l_error("card " + std::to_string(l_id) + " has more than " + std::to_string(potential_checkers::m_max_conditions) + " conditions");
+            }
+            size_t l_separator = l_line.find(':');
+            std::string_view l_expression = trim(l_line.substr(0, l_separator));
+            std::string_view l_label = l_separator == std::string_view::npos ? l_expression : trim(l_line.substr(l_separator + 1));
+            code_set l_mask;
+            try
+            {
+                l_mask = compile(l_expression);
+            }
+            catch(quicky_exception::quicky_logic_exception & e)
+            {
+                l_error(e.what());
+            }
+            // Solver tells conditions apart by their masks
+            if(l_mask.none())
+            {
+                l_error("condition \"" + std::string(l_label) + "\" of card " + std::to_string(l_id) + " is true for no code");
+            }
+            auto l_same = std::find_if(l_conditions.begin(), l_conditions.end(), [&](const std::pair<code_set, std::string> & p_condition){return p_condition.first == l_mask;});
+            if(l_conditions.end() != l_same)
+            {
+                l_error("condition \"" + std::string(l_label) + "\" of card " + std::to_string(l_id) + " is true for the same codes as \"" + l_same->second + "\"");
+            }
+            l_conditions.emplace_back(l_mask, std::string(l_label));
+        }
+        if(!l_ids.empty())
+        {
+            l_close_card();
+        }
+        return l_result;
+    }
+
+    //-------------------------------------------------------------------------
+    std::vector<std::shared_ptr<checker_if>>
+    card_catalogue::load_file(const std::string & p_file_name)
+    {
+        std::ifstream l_file{p_file_name};
+        if(!l_file.is_open())
+        {
+            throw quicky_exception::quicky_runtime_exception("Unable to open " + p_file_name, __LINE__, __FILE__);
+        }
+        std::stringstream l_content;
+        l_content << l_file.rdbuf();
+        return load(l_content.str(), p_file_name);
+    }
+
+    //-------------------------------------------------------------------------
+    std::vector<std::shared_ptr<checker_if>>
+    card_catalogue::load_embedded()
+    {
+        return load(card_definitions::m_text, "embedded cards");
+    }
+
+    //-------------------------------------------------------------------------
+    void
+    card_catalogue::merge(std::vector<std::shared_ptr<checker_if>> & p_cards
+                         ,const std::vector<std::shared_ptr<checker_if>> & p_extra_cards
+                         )
+    {
+        for(const auto & l_extra_card: p_extra_cards)
+        {
+            auto l_iter = std::find_if(p_cards.begin(), p_cards.end(), [&](const std::shared_ptr<checker_if> & p_card){return p_card->get_id() == l_extra_card->get_id();});
+            if(p_cards.end() == l_iter)
+            {
+                p_cards.emplace_back(l_extra_card);
+            }
+            else
+            {
+                *l_iter = l_extra_card;
+            }
+        }
+    }
+
+    //-------------------------------------------------------------------------
+    code_set
+    card_catalogue::compile(std::string_view p_expression)
+    {
+        return compiler{p_expression}.run();
+    }
+
+    //-------------------------------------------------------------------------
+    void
+    card_catalogue::display(const std::vector<std::shared_ptr<checker_if>> & p_cards
+                           ,std::ostream & p_stream
+                           )
+    {
+        for(const auto & l_card: p_cards)
+        {
+            p_stream << l_card->get_id() << " " << l_card->get_name() << std::endl;
+            auto l_card_checker = std::dynamic_pointer_cast<card_checker>(l_card);
+            for(unsigned int l_index = 0; l_index < l_card->get_grade(); ++l_index)
+            {
+                code_set l_mask = l_card_checker ? l_card_checker->get_mask(l_index) : condition_table::compute_mask(*l_card, l_index);
+                p_stream << "    " << l_index << " " << (l_card_checker ? l_card_checker->get_condition_name(l_index) : "") << " (" << l_mask.count() << " codes)" << std::endl;
+            }
+        }
+    }
+
+    //-------------------------------------------------------------------------
+    std::string_view
+    card_catalogue::trim(std::string_view p_text)
+    {
+        constexpr std::string_view l_spaces = " \t\r";
+        size_t l_begin = p_text.find_first_not_of(l_spaces);
+        if(std::string_view::npos == l_begin)
+        {
+            return {};
+        }
+        return p_text.substr(l_begin, p_text.find_last_not_of(l_spaces) + 1 - l_begin);
+    }
+
+    //-------------------------------------------------------------------------
+    card_catalogue::compiler::compiler(std::string_view p_expression)
+    :m_expression{p_expression}
+    ,m_position{0}
+    {
+    }
+
+    //-------------------------------------------------------------------------
+    code_set
+    card_catalogue::compiler::run()
+    {
+        values l_values = parse_or();
+        skip_spaces();
+        if(m_position != m_expression.size())
+        {
+            error("unexpected character");
+        }
+        // Mask is built 64 codes at a time, bits after last code are dropped by shift
+        std::array<uint64_t, m_nb_lanes / 64> l_words{};
+        for(unsigned int l_index = 0; l_index < m_nb_lanes; ++l_index)
+        {
+            l_words[l_index / 64] |= static_cast<uint64_t>(0 != l_values[l_index]) << (l_index % 64);
+        }
+        return (code_set{l_words[1]} << 64) | code_set{l_words[0]};
+    }
+
+    //-------------------------------------------------------------------------
+    card_catalogue::values
+    card_catalogue::compiler::parse_or()
+    {
+        values l_result = parse_and();
+        while(accept("||"))
+        {
+            l_result = combine(l_result, parse_and(), [](int64_t p_left, int64_t p_right){return p_left || p_right;});
+        }
+        return l_result;
+    }
+
+    //-------------------------------------------------------------------------
+    card_catalogue::values
+    card_catalogue::compiler::parse_and()
+    {
+        values l_result = parse_equality();
+        while(accept("&&"))
+        {
+            l_result = combine(l_result, parse_equality(), [](int64_t p_left, int64_t p_right){return p_left && p_right;});
+        }
+        return l_result;
+    }
+
+    //-------------------------------------------------------------------------
+    card_catalogue::values
+    card_catalogue::compiler::parse_equality()
+    {
+        values l_result = parse_relational();
+        while(true)
+        {
+            if(accept("=="))
+            {
+                l_result = combine(l_result, parse_relational(), [](int64_t p_left, int64_t p_right){return p_left == p_right;});
+            }
+            else if(accept("!="))
+            {
+                l_result = combine(l_result, parse_relational(), [](int64_t p_left, int64_t p_right){return p_left != p_right;});
+            }
+            else
+            {
+                return l_result;
+            }
+        }
+    }
+
+    //-------------------------------------------------------------------------
+    card_catalogue::values
+    card_catalogue::compiler::parse_relational()
+    {
+        values l_result = parse_additive();
+        while(true)
+        {
+            if(accept("<="))
+            {
+                l_result = combine(l_result, parse_additive(), [](int64_t p_left, int64_t p_right){return p_left <= p_right;});
+            }
+            else if(accept(">="))
+            {
+                l_result = combine(l_result, parse_additive(), [](int64_t p_left, int64_t p_right){return p_left >= p_right;});
+            }
+            else if(accept("<"))
+            {
+                l_result = combine(l_result, parse_additive(), [](int64_t p_left, int64_t p_right){return p_left < p_right;});
+            }
+            else if(accept(">"))
+            {
+                l_result = combine(l_result, parse_additive(), [](int64_t p_left, int64_t p_right){return p_left > p_right;});
+            }
+            else
+            {
+                return l_result;
+            }
+        }
+    }
+
+    //-------------------------------------------------------------------------
+    card_catalogue::values
+    card_catalogue::compiler::parse_additive()
+    {
+        values l_result = parse_multiplicative();
+        while(true)
+        {
+            if(accept("+"))
+            {
+                l_result = combine_checked(l_result, parse_multiplicative(), [](int64_t p_left, int64_t p_right, int64_t * p_value){return __builtin_add_overflow(p_left, p_right, p_value);});
+            }
+            else if(accept("-"))
+            {
+                l_result = combine_checked(l_result, parse_multiplicative(), [](int64_t p_left, int64_t p_right, int64_t * p_value){return __builtin_sub_overflow(p_left, p_right, p_value);});
+            }
+            else
+            {
+                return l_result;
+            }
+        }
+    }
+
+    //-------------------------------------------------------------------------
+    card_catalogue::values
+    card_catalogue::compiler::parse_multiplicative()
+    {
+        values l_result = parse_unary();
+        while(true)
+        {
+            if(accept("*"))
+            {
+                l_result = combine_checked(l_result, parse_unary(), [](int64_t p_left, int64_t p_right, int64_t * p_value){return __builtin_mul_overflow(p_left, p_right, p_value);});
+                continue;
+            }
+            bool l_division = accept("/");
+            if(!l_division && !accept("%"))
+            {
+                return l_result;
+            }
+            values l_divisor = parse_unary();
+            if(std::find(l_divisor.begin(), l_divisor.begin() + condition_table::m_nb_codes, 0) != l_divisor.begin() + condition_table::m_nb_codes)
+            {
+                error("division by zero");
+            }
+            // Divisor can still be null after last code. Only quotient of
+            // minimum by -1 does not fit, remainder of same operands is UB too
+            auto l_overflow = [](int64_t p_left, int64_t p_right){return std::numeric_limits<int64_t>::min() == p_left && -1 == p_right;};
+            l_result = l_division ? combine_checked(l_result, l_divisor, [=](int64_t p_left, int64_t p_right, int64_t * p_value){*p_value = p_right && !l_overflow(p_left, p_right) ? p_left / p_right : 0; return l_overflow(p_left, p_right);})
+                                  : combine_checked(l_result, l_divisor, [=](int64_t p_left, int64_t p_right, int64_t * p_value){*p_value = p_right && !l_overflow(p_left, p_right) ? p_left % p_right : 0; return l_overflow(p_left, p_right);});
+        }
+    }
+
+    //-------------------------------------------------------------------------
+    card_catalogue::values
+    card_catalogue::compiler::parse_unary()
+    {
+        if(accept("!"))
+        {
+            values l_result = parse_unary();
+            std::transform(l_result.begin(), l_result.end(), l_result.begin(), [](int64_t p_value){return !p_value;});
+            return l_result;
+        }
+        if(accept("-"))
+        {
+            return combine_checked(values{}, parse_unary(), [](int64_t p_left, int64_t p_right, int64_t * p_value){return __builtin_sub_overflow(p_left, p_right, p_value);});
+        }
+        return parse_primary();
+    }
+
+    //-------------------------------------------------------------------------
+    card_catalogue::values
+    card_catalogue::compiler::parse_primary()
+    {
+        skip_spaces();
+        values l_result;
+        if(accept("("))
+        {
+            l_result = parse_or();
+            if(!accept(")"))
+            {
+                error("missing )");
+            }
+            return l_result;
+        }
+        if(m_position == m_expression.size())
+        {
+            error("missing operand");
+        }
+        char l_char = m_expression[m_position];
+        if(l_char >= '0' && l_char <= '9')
+        {
+            int64_t l_value = 0;
+            auto [l_end, l_status] = std::from_chars(m_expression.data() + m_position, m_expression.data() + m_expression.size(), l_value);
+            if(l_status != std::errc())
+            {
+                error("bad number");
+            }
+            m_position = static_cast<size_t>(l_end - m_expression.data());
+            l_result.fill(l_value);
+            return l_result;
+        }
+        // Digits of blue, yellow and purple for each code, computed once
+        static const std::array<values, 3> l_digits = []()
+        {
+            std::array<values, 3> l_digits{};
+            for(unsigned int l_index = 0; l_index < condition_table::m_nb_codes; ++l_index)
+            {
+                candidate l_candidate = condition_table::index_code(l_index);
+                l_digits[0][l_index] = static_cast<int64_t>(l_candidate.get_blue_triangle());
+                l_digits[1][l_index] = static_cast<int64_t>(l_candidate.get_yellow_square());
+                l_digits[2][l_index] = static_cast<int64_t>(l_candidate.get_purple_circle());
+            }
+            return l_digits;
+        }();
+        size_t l_colour = std::string_view{"byp"}.find(l_char);
+        bool l_is_name_end = m_position + 1 == m_expression.size() || !std::isalnum(static_cast<unsigned char>(m_expression[m_position + 1]));
+        if(std::string_view::npos == l_colour || !l_is_name_end)
+        {
+            error("unknown operand");
+        }
+        ++m_position;
+        return l_digits[l_colour];
+    }
+
+    //-------------------------------------------------------------------------
+    bool
+    card_catalogue::compiler::accept(std::string_view p_operator)
+    {
+        skip_spaces();
+        if(!m_expression.substr(m_position).starts_with(p_operator))
+        {
+            return false;
+        }
+        m_position += p_operator.size();
+        return true;
+    }
+
+    //-------------------------------------------------------------------------
+    void
+    card_catalogue::compiler::skip_spaces()
+    {
+        while(m_position < m_expression.size() && (' ' == m_expression[m_position] || '\t' == m_expression[m_position]))
+        {
+            ++m_position;
+        }
+    }
+
+    //-------------------------------------------------------------------------
+    void
+    card_catalogue::compiler::error(const std::string & p_message) const
+    {
+        throw quicky_exception::quicky_logic_exception("Bad expression \"" + std::string(m_expression) + "\": " + p_message + " at offset " + std::to_string(m_position), __LINE__, __FILE__);
+    }
+
+    //-------------------------------------------------------------------------
+    template <typename OPERATION>
+    card_catalogue::values
+    card_catalogue::compiler::combine(const values & p_left
+                                     ,const values & p_right
+                                     ,OPERATION p_operation
+                                     )
+    {
+        values l_result;
+        for(unsigned int l_index = 0; l_index < m_nb_lanes; ++l_index)
+        {
+            l_result[l_index] = static_cast<int64_t>(p_operation(p_left[l_index], p_right[l_index]));
+        }
+        return l_result;
+    }
+
+    //-------------------------------------------------------------------------
+    template <typename OPERATION>
+    card_catalogue::values
+    card_catalogue::compiler::combine_checked(const values & p_left
+                                             ,const values & p_right
+                                             ,OPERATION p_operation
+                                             ) const
+    {
+        values l_result;
+        bool l_overflow = false;
+        for(unsigned int l_index = 0; l_index < m_nb_lanes; ++l_index)
+        {
+            // Values after last code are not meaningful, neither are their overflows
+            l_overflow |= p_operation(p_left[l_index], p_right[l_index], &l_result[l_index]) && l_index < condition_table::m_nb_codes;
+        }
+        if(l_overflow)
+        {
+            error("overflow");
+        }
+        return l_result;
+    }
+}
+#endif //TURING_MACHINE_SOLVER_CARD_CATALOGUE_H
+// EOF
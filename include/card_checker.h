@@ -15,27 +15,36 @@
       along with this program.  If not, see <http://www.gnu.org/licenses/>
 */
 
-#ifndef TURING_MACHINE_SOLVER_CHECKER_BASE_H
-#define TURING_MACHINE_SOLVER_CHECKER_BASE_H
+#ifndef TURING_MACHINE_SOLVER_CARD_CHECKER_H
+#define TURING_MACHINE_SOLVER_CARD_CHECKER_H
 
 #include "checker_if.h"
+#include "condition_table.h"
 #include "candidate.h"
-#include "checker_func.h"
-#include "quicky_exception.h"
 #include <string>
 #include <utility>
+#include <vector>
 #include <cassert>
 
 namespace turing_machine_solver
 {
-    template <unsigned int GRADE>
-    class checker_base: public checker_if
+    /**
+     * Checker whose conditions are given by precomputed masks of codes, so
+     * evaluating a condition is a bit test
+     */
+    class card_checker: public checker_if
     {
     public:
+        /**
+         * @param p_id card id
+         * @param p_name card description
+         * @param p_conditions mask and label of each condition
+         */
         inline
-        checker_base(unsigned int p_id
-                    ,std::string  p_name
-                    ,std::array<checker_func, GRADE> p_funcs);
+        card_checker(unsigned int p_id
+                    ,std::string p_name
+                    ,std::vector<std::pair<code_set, std::string>> p_conditions
+                    );
 
         [[nodiscard]] inline
         bool
@@ -62,46 +71,76 @@ namespace turing_machine_solver
         std::set<unsigned int>
         get_correct_conditions(const candidate & p_candidate) const override;
 
+        /**
+         * Codes for which a condition is true
+         */
+        [[nodiscard]] inline
+        const code_set &
+        get_mask(unsigned int p_grade) const;
+
+        [[nodiscard]] inline
+        const std::string &
+        get_condition_name(unsigned int p_grade) const;
+
     private:
         unsigned int m_id;
 
         std::string m_name;
 
-        std::array<checker_func, GRADE> m_funcs;
+        std::vector<std::pair<code_set, std::string>> m_conditions;
     };
 
     //-------------------------------------------------------------------------
-    template <unsigned int GRADE>
-    checker_base<GRADE>::checker_base(unsigned int p_id
-                                     ,std::string  p_name
-                                     , std::array<checker_func, GRADE> p_funcs
-                                     )
+    card_checker::card_checker(unsigned int p_id
+                              ,std::string p_name
+                              ,std::vector<std::pair<code_set, std::string>> p_conditions
+                              )
     :m_id{p_id}
     ,m_name{std::move(p_name)}
-    ,m_funcs{p_funcs}
+    ,m_conditions{std::move(p_conditions)}
     {
     }
 
     //-------------------------------------------------------------------------
-    template <unsigned int GRADE>
     bool
-    checker_base<GRADE>::run(unsigned int p_grade
-                            ,const candidate & p_candidate
-                            )const
+    card_checker::run(unsigned int p_grade
+                     ,const candidate & p_candidate
+                     ) const
+    {
+        assert(p_grade < m_conditions.size());
+        return m_conditions[p_grade].first.test(condition_table::code_index(p_candidate));
+    }
+
+    //-------------------------------------------------------------------------
+    unsigned int
+    card_checker::get_id() const
+    {
+        return m_id;
+    }
+
+    //-------------------------------------------------------------------------
+    unsigned int
+    card_checker::get_grade() const
     {
-        assert(p_grade < GRADE);
-        return m_funcs[p_grade].run(p_candidate);
+        return static_cast<unsigned int>(m_conditions.size());
+    }
+
+    //-------------------------------------------------------------------------
+    const std::string &
+    card_checker::get_name() const
+    {
+        return m_name;
     }
 
     //-------------------------------------------------------------------------
-    template <unsigned int GRADE>
     std::set<unsigned int>
-    checker_base<GRADE>::get_correct_conditions(const candidate & p_candidate) const
+    card_checker::get_correct_conditions(const candidate & p_candidate) const
     {
+        unsigned int l_code_index = condition_table::code_index(p_candidate);
         std::set<unsigned int> l_result;
-        for(unsigned int l_index = 0; l_index < GRADE; ++l_index)
+        for(unsigned int l_index = 0; l_index < m_conditions.size(); ++l_index)
         {
-            if(run(l_index, p_candidate))
+            if(m_conditions[l_index].first.test(l_code_index))
             {
                 l_result.insert(l_index);
             }
@@ -110,28 +149,20 @@ namespace turing_machine_solver
     }
 
     //-------------------------------------------------------------------------
-    template <unsigned int GRADE>
-    unsigned int
-    checker_base<GRADE>::get_id() const
-    {
-        return m_id;
-    }
-
-    //-------------------------------------------------------------------------
-    template <unsigned int GRADE>
-    unsigned int
-    checker_base<GRADE>::get_grade() const
+    const code_set &
+    card_checker::get_mask(unsigned int p_grade) const
     {
-        return GRADE;
+        assert(p_grade < m_conditions.size());
+        return m_conditions[p_grade].first;
     }
 
     //-------------------------------------------------------------------------
-    template <unsigned int GRADE>
     const std::string &
-    checker_base<GRADE>::get_name() const
+    card_checker::get_condition_name(unsigned int p_grade) const
     {
-        return m_name;
+        assert(p_grade < m_conditions.size());
+        return m_conditions[p_grade].second;
     }
 }
-#endif //TURING_MACHINE_SOLVER_CHECKER_BASE_H
-// EOF
\ No newline at end of file
+#endif //TURING_MACHINE_SOLVER_CARD_CHECKER_H
+// EOF
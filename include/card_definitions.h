@@ -0,0 +1,319 @@
+/*    This file is part of turing_machine_solver
+      Copyright (C) 2024  Julien Thevenon ( julien_thevenon at yahoo.fr )
+
+      This program is free software: you can redistribute it and/or modify
+      it under the terms of the GNU General Public License as published by
+      the Free Software Foundation, either version 3 of the License, or
+      (at your option) any later version.
+
+      This program is distributed in the hope that it will be useful,
+      but WITHOUT ANY WARRANTY; without even the implied warranty of
+      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+      GNU General Public License for more details.
+
+      You should have received a copy of the GNU General Public License
+      along with this program.  If not, see <http://www.gnu.org/licenses/>
+*/
+
+#ifndef TURING_MACHINE_SOLVER_CARD_DEFINITIONS_H
+#define TURING_MACHINE_SOLVER_CARD_DEFINITIONS_H
+
+#include <string_view>
+
+namespace turing_machine_solver
+{
+    /**
+     * The 48 criteria cards of the game in card_catalogue format. Condition
+     * order of a card is the one used in scripts and logs
+     */
+    class card_definitions
+    {
+    public:
+        static constexpr std::string_view m_text = R"cards(
+# card <id> <name>
+#     <expression> : <label>
+# b, y and p are digits of blue triangle, yellow square and purple circle
+
+card 1 Le chiffre du triangle bleu comparé à 1
+    b == 1 : bleu == 1
+    b > 1 : bleu > 1
+
+card 2 Le chiffre du triangle bleu comparé à 3
+    b < 3 : bleu < 3
+    b == 3 : bleu == 3
+    b > 3 : bleu > 3
+
+card 3 Le chiffre du carré jaune comparé à 3
+    y < 3 : jaune < 3
+    y == 3 : jaune == 3
+    y > 3 : jaune > 3
+
+card 4 Le chiffre du carré jaune comparé à 4
+    y < 4 : jaune < 4
+    y == 4 : jaune == 4
+    y > 4 : jaune > 4
+
+card 5 Triangle bleu est pair ou impair
+    b % 2 == 0 : bleu est pair
+    b % 2 == 1 : bleu est impair
+
+card 6 Carré jaune est pair ou impair
+    y % 2 == 0 : jaune est pair
+    y % 2 == 1 : jaune est impair
+
+card 7 Cercle violet est pair ou impair
+    p % 2 == 0 : violet est pair
+    p % 2 == 1 : violet est impair
+
+card 8 Le nombre de chiffre 1 dans le code
+    (b == 1) + (y == 1) + (p == 1) == 0 : pas de 1
+    (b == 1) + (y == 1) + (p == 1) == 1 : un 1
+    (b == 1) + (y == 1) + (p == 1) == 2 : deux 1
+    (b == 1) + (y == 1) + (p == 1) == 3 : trois 1
+
+card 9 Le nombre de chiffre 3 dans le code
+    (b == 3) + (y == 3) + (p == 3) == 0 : pas de 3
+    (b == 3) + (y == 3) + (p == 3) == 1 : un 3
+    (b == 3) + (y == 3) + (p == 3) == 2 : deux 3
+    (b == 3) + (y == 3) + (p == 3) == 3 : trois 3
+
+card 10 Le nombre de chiffre 4 dans le code
+    (b == 4) + (y == 4) + (p == 4) == 0 : pas de 4
+    (b == 4) + (y == 4) + (p == 4) == 1 : un 4
+    (b == 4) + (y == 4) + (p == 4) == 2 : deux 4
+    (b == 4) + (y == 4) + (p == 4) == 3 : trois 4
+
+card 11 Le chiffre du triangle bleu comparé au carré jaune
+    b < y : bleu < jaune
+    b == y : bleu == jaune
+    b > y : bleu > jaune
+
+card 12 Le chiffre du triangle bleu comparé au cercle violet
+    b < p : bleu < violet
+    b == p : bleu == violet
+    b > p : bleu > violet
+
+card 13 Le chiffre du carré jaune comparé au cercle violet
+    y < p : jaune < violet
+    y == p : jaune == violet
+    y > p : jaune > violet
+
+card 14 Quelle couleur a le chiffre plus petit que les autres
+    b < y && b < p : bleu < (jaune && violet)
+    y < b && y < p : jaune < (bleu && violet)
+    p < b && p < y : violet < (bleu && jaune)
+
+card 15 Quelle couleur a le chiffre plus grand que les autres
+    b > y && b > p : bleu > (jaune && violet)
+    y > b && y > p : jaune > (bleu && violet)
+    p > b && p > y : violet > (bleu && jaune)
+
+card 16 Le nombre de chiffres pairs comparé au nombre de chiffres impairs
+    b % 2 + y % 2 + p % 2 < 2 : pairs > impairs
+    b % 2 + y % 2 + p % 2 >= 2 : pairs < impairs
+
+card 17 Le nombre de chiffres pairs dans le code
+    b % 2 + y % 2 + p % 2 == 3 : aucun chiffre pair
+    b % 2 + y % 2 + p % 2 == 2 : un chiffre pair
+    b % 2 + y % 2 + p % 2 == 1 : deux chiffres pairs
+    b % 2 + y % 2 + p % 2 == 0 : trois chiffres pairs
+
+card 18 La somme de tous les chiffres est paire ou impaire
+    (b + y + p) % 2 == 0 : la somme des chiffres est paire
+    (b + y + p) % 2 == 1 : la somme des chiffres est impaire
+
+card 19 La somme du triangle bleu et du carré jaune comparée à 6
+    b + y < 6 : bleu + jaune < 6
+    b + y == 6 : bleu + jaune == 6
+    b + y > 6 : bleu + jaune > 6
+
+card 20 Un chiffre se répète dans le code
+    b == y && y == p : un chiffre triple
+    (b == y) + (b == p) + (y == p) == 1 : un chiffre double
+    b != y && b != p && y != p : pas de répétition
+
+card 21 Un chiffre est présent exactement 2 fois dans le code
+    (b == y) + (b == p) + (y == p) != 1 : pas de paire
+    (b == y) + (b == p) + (y == p) == 1 : une paire
+
+card 22 Les 3 chiffres du code sont en ordre croissant ou décroissant
+    b < y && y < p : ordre croissant
+    b > y && y > p : ordre décroissant
+    !(b < y && y < p) && !(b > y && y > p) : pas d'ordre
+
+card 23 La somme de tous les chiffres comparée à 6
+    b + y + p < 6 : la somme est plus petite que 6
+    b + y + p == 6 : la somme est égale à 6
+    b + y + p > 6 : la somme est plus grande que 6
+
+card 24 Il y a une suite croissante de chiffres consécutifs
+    b + 1 == y && y + 1 == p : 3 chiffres en ordre croissant consécutifs
+    (b + 1 == y) + (y + 1 == p) == 1 : 2 chiffres en ordre croissant consécutifs
+    b + 1 != y && y + 1 != p : pas de chiffres en ordre croissant consécutifs
+
+card 25 Il y a une suite croissante ou décroissante de chiffres consécutifs
+    b != y + 1 && y != p + 1 && b + 1 != y && y + 1 != p : pas de suite croissante ou décroissante de chiffres consécutifs
+    (b + 1 == y && y + 1 != p) || (b + 1 != y && y + 1 == p) || (b == y + 1 && y != p + 1) || (b != y + 1 && y == p + 1) : 2 chiffres en ordre croissant ou décroissant consécutifs
+    (b + 1 == y && y + 1 == p) || (b == y + 1 && y == p + 1) : 3 chiffres en ordre croissant ou décroissant consécutifs
+
+card 26 Une couleur spécifique est plus petite que 3
+    b < 3 : bleu < 3
+    y < 3 : jaune < 3
+    p < 3 : violet < 3
+
+card 27 Une couleur spécifique est plus petite que 4
+    b < 4 : bleu < 4
+    y < 4 : jaune < 4
+    p < 4 : violet < 4
+
+card 28 Une couleur spécifique est égale à 1
+    b == 1 : bleu == 1
+    y == 1 : jaune == 1
+    p == 1 : violet == 1
+
+card 29 Une couleur spécifique est égale à 3
+    b == 3 : bleu == 3
+    y == 3 : jaune == 3
+    p == 3 : violet == 3
+
+card 30 Une couleur spécifique est égale à 4
+    b == 4 : bleu == 4
+    y == 4 : jaune == 4
+    p == 4 : violet == 4
+
+card 31 Une couleur spécifique est plus grande que 1
+    b > 1 : bleu > 1
+    y > 1 : jaune > 1
+    p > 1 : violet > 1
+
+card 32 Une couleur spécifique est plus grande que 3
+    b > 3 : bleu > 3
+    y > 3 : jaune > 3
+    p > 3 : violet > 3
+
+card 33 Une couleur spécifique est paire ou impaire
+    b % 2 == 0 : bleu est pair
+    y % 2 == 0 : jaune est pair
+    p % 2 == 0 : violet est pair
+    b % 2 == 1 : bleu est impair
+    y % 2 == 1 : jaune est impair
+    p % 2 == 1 : violet est impair
+
+card 34 Quelle couleur a le chiffre plus petit (ou à égalité avec le chiffre le plus petit)
+    b <= y && b <= p : bleu <= (jaune && violet)
+    y <= b && y <= p : jaune <= (bleu && violet)
+    p <= b && p <= y : violet <= (bleu && jaune)
+
+card 35 Quelle couleur a le chiffre plus grand (ou à égalité avec le chiffre le plus grand)
+    b >= y && b >= p : bleu >= (jaune && violet)
+    y >= b && y >= p : jaune >= (bleu && violet)
+    p >= b && p >= y : violet >= (bleu && jaune)
+
+card 36 La somme de tous les chiffres est un multiple de 3 ou 4 ou 5
+    (b + y + p) % 3 == 0 : la somme est un multiple de 3
+    (b + y + p) % 4 == 0 : la somme est un multiple de 4
+    (b + y + p) % 5 == 0 : la somme est un multiple de 5
+
+card 37 La somme de 2 couleurs spécifiques est égale à 4
+    b + y == 4 : bleu + jaune == 4
+    b + p == 4 : bleu + violet == 4
+    y + p == 4 : jaune + violet == 4
+
+card 38 La somme de 2 couleurs spécifiques est égale à 6
+    b + y == 6 : bleu + jaune == 6
+    b + p == 6 : bleu + violet == 6
+    y + p == 6 : jaune + violet == 6
+
+card 39 Une couleur spécifique comparée à 1
+    b == 1 : bleu == 1
+    y == 1 : jaune == 1
+    p == 1 : violet == 1
+    b > 1 : bleu > 1
+    y > 1 : jaune > 1
+    p > 1 : violet > 1
+
+card 40 Une couleur spécifique comparée à 3
+    b < 3 : bleu < 3
+    y < 3 : jaune < 3
+    p < 3 : violet < 3
+    b == 3 : bleu == 3
+    y == 3 : jaune == 3
+    p == 3 : violet == 3
+    b > 3 : bleu > 3
+    y > 3 : jaune > 3
+    p > 3 : violet > 3
+
+card 41 Une couleur spécifique comparée à 4
+    b < 4 : bleu < 4
+    y < 4 : jaune < 4
+    p < 4 : violet < 4
+    b == 4 : bleu == 4
+    y == 4 : jaune == 4
+    p == 4 : violet == 4
+    b > 4 : bleu > 4
+    y > 4 : jaune > 4
+    p > 4 : violet > 4
+
+card 42 Quelle couleur est la plus petite ou la plus grande
+    b < y && b < p : bleu < (jaune && violet)
+    y < b && y < p : jaune < (bleu && violet)
+    p < b && p < y : violet < (bleu && jaune)
+    b > y && b > p : bleu > (jaune && violet)
+    y > b && y > p : jaune > (bleu && violet)
+    p > b && p > y : violet > (bleu && jaune)
+
+card 43 Le chiffre du triangle bleu comparé à celui d'une autre couleur spécifique
+    b < y : bleu < jaune
+    b < p : bleu < violet
+    b == y : bleu == jaune
+    b == p : bleu == violet
+    b > y : bleu > jaune
+    b > p : bleu > violet
+
+card 44 Le chiffre du carré jaune comparé à celui d'une autre couleur spécifique
+    y < b : jaune < bleu
+    y < p : jaune < violet
+    y == b : jaune == bleu
+    y == p : jaune == violet
+    y > b : jaune > bleu
+    y > p : jaune > violet
+
+card 45 Combien il y a de 1 ou combien il y a de 3 dans le code
+    (b == 1) + (y == 1) + (p == 1) == 0 : pas de 1
+    (b == 1) + (y == 1) + (p == 1) == 1 : un 1
+    (b == 1) + (y == 1) + (p == 1) == 2 : deux 1
+    (b == 3) + (y == 3) + (p == 3) == 0 : pas de 3
+    (b == 3) + (y == 3) + (p == 3) == 1 : un 3
+    (b == 3) + (y == 3) + (p == 3) == 2 : deux 3
+
+card 46 Combien il y a de 3 ou combien il y a de 4 dans le code
+    (b == 3) + (y == 3) + (p == 3) == 0 : pas de 3
+    (b == 3) + (y == 3) + (p == 3) == 1 : un 3
+    (b == 3) + (y == 3) + (p == 3) == 2 : deux 3
+    (b == 4) + (y == 4) + (p == 4) == 0 : pas de 4
+    (b == 4) + (y == 4) + (p == 4) == 1 : un 4
+    (b == 4) + (y == 4) + (p == 4) == 2 : deux 4
+
+card 47 Combien il y a de 1 ou combien il y a de 4 dans le code
+    (b == 1) + (y == 1) + (p == 1) == 0 : pas de 1
+    (b == 1) + (y == 1) + (p == 1) == 1 : un 1
+    (b == 1) + (y == 1) + (p == 1) == 2 : deux 1
+    (b == 4) + (y == 4) + (p == 4) == 0 : pas de 4
+    (b == 4) + (y == 4) + (p == 4) == 1 : un 4
+    (b == 4) + (y == 4) + (p == 4) == 2 : deux 4
+
+card 48 Une couleur spécifique comparée à une autre couleur spécifique
+    b < y : bleu < jaune
+    b < p : bleu < violet
+    y < p : jaune < violet
+    b == y : bleu == jaune
+    b == p : bleu == violet
+    y == p : jaune == violet
+    b > y : bleu > jaune
+    b > p : bleu > violet
+    y > p : jaune > violet
+)cards";
+    };
+}
+#endif //TURING_MACHINE_SOLVER_CARD_DEFINITIONS_H
+// EOF
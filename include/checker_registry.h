@@ -0,0 +1,117 @@
+/*    This file is part of turing_machine_solver
+      Copyright (C) 2024  Julien Thevenon ( julien_thevenon at yahoo.fr )
+
+      This program is free software: you can redistribute it and/or modify
+      it under the terms of the GNU General Public License as published by
+      the Free Software Foundation, either version 3 of the License, or
+      (at your option) any later version.
+
+      This program is distributed in the hope that it will be useful,
+      but WITHOUT ANY WARRANTY; without even the implied warranty of
+      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+      GNU General Public License for more details.
+
+      You should have received a copy of the GNU General Public License
+      along with this program.  If not, see <http://www.gnu.org/licenses/>
+*/
+
+#ifndef TURING_MACHINE_SOLVER_CHECKER_REGISTRY_H
+#define TURING_MACHINE_SOLVER_CHECKER_REGISTRY_H
+
+#include "checker_if.h"
+#include "quicky_exception.h"
+#include <map>
+#include <memory>
+#include <vector>
+#include <ostream>
+
+namespace turing_machine_solver
+{
+    /**
+     * Set of checkers indexed by id. Content is fixed at construction so a
+     * registry can be read by any number of threads without locking
+     */
+    class checker_registry
+    {
+    public:
+        inline explicit
+        checker_registry(const std::vector<std::shared_ptr<checker_if>> & p_checkers);
+
+        [[nodiscard]] inline
+        std::shared_ptr<checker_if>
+        get_checker(unsigned int p_id) const;
+
+        [[nodiscard]] inline
+        bool
+        contains(unsigned int p_id) const;
+
+        /**
+         * Ids of checkers in increasing order
+         */
+        [[nodiscard]] inline
+        std::vector<unsigned int>
+        get_checker_ids() const;
+
+        inline
+        void
+        display(std::ostream & p_stream) const;
+
+    private:
+        std::map<unsigned int, std::shared_ptr<checker_if>> m_checkers;
+    };
+
+    //-------------------------------------------------------------------------
+    checker_registry::checker_registry(const std::vector<std::shared_ptr<checker_if>> & p_checkers)
+    {
+        for(const auto & l_checker: p_checkers)
+        {
+            if(!m_checkers.insert({l_checker->get_id(), l_checker}).second)
+            {
+                throw quicky_exception::quicky_logic_exception("Checker " + std::to_string(l_checker->get_id()) + " defined twice", __LINE__, __FILE__);
+            }
+        }
+    }
+
+    //-------------------------------------------------------------------------
+    std::shared_ptr<checker_if>
+    checker_registry::get_checker(unsigned int p_id) const
+    {
+        auto l_iter = m_checkers.find(p_id);
+        if(m_checkers.end() == l_iter)
+        {
+            throw quicky_exception::quicky_logic_exception("No checker with ID " + std::to_string(p_id), __LINE__, __FILE__);
+        }
+        return l_iter->second;
+    }
+
+    //-------------------------------------------------------------------------
+    bool
+    checker_registry::contains(unsigned int p_id) const
+    {
+        return m_checkers.contains(p_id);
+    }
+
+    //-------------------------------------------------------------------------
+    std::vector<unsigned int>
+    checker_registry::get_checker_ids() const
+    {
+        std::vector<unsigned int> l_result;
+        for(const auto & l_iter: m_checkers)
+        {
+            l_result.emplace_back(l_iter.first);
+        }
+        return l_result;
+    }
+
+    //-------------------------------------------------------------------------
+    void
+    checker_registry::display(std::ostream & p_stream) const
+    {
+        for(const auto & l_iter: m_checkers)
+        {
+            p_stream << l_iter.first << " " << l_iter.second->get_name() << std::endl;
+        }
+    }
+}
+#endif //TURING_MACHINE_SOLVER_CHECKER_REGISTRY_H
+// EOF
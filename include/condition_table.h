@@ -0,0 +1,209 @@
+/*    This file is part of turing_machine_solver
+      Copyright (C) 2024  Julien Thevenon ( julien_thevenon at yahoo.fr )
+
+      This program is free software: you can redistribute it and/or modify
+      it under the terms of the GNU General Public License as published by
+      the Free Software Foundation, either version 3 of the License, or
+      (at your option) any later version.
+
+      This program is distributed in the hope that it will be useful,
+      but WITHOUT ANY WARRANTY; without even the implied warranty of
+      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+      GNU General Public License for more details.
+
+      You should have received a copy of the GNU General Public License
+      along with this program.  If not, see <http://www.gnu.org/licenses/>
+*/
+
+#ifndef TURING_MACHINE_SOLVER_CONDITION_TABLE_H
+#define TURING_MACHINE_SOLVER_CONDITION_TABLE_H
+
+#include "checker_if.h"
+#include "candidate.h"
+#include "quicky_exception.h"
+#include <bitset>
+#include <vector>
+#include <memory>
+#include <cassert>
+
+namespace turing_machine_solver
+{
+    /**
+     * Set of codes, bit index is given by condition_table::code_index
+     */
+    typedef std::bitset<125> code_set;
+
+    /**
+     * Precomputed masks of codes satisfying each condition of a list of
+     * checkers. Mask of condition K of checker J contains all codes for
+     * which checker J condition K is true
+     */
+    class condition_table
+    {
+    public:
+        inline explicit
+        condition_table(const std::vector<std::shared_ptr<checker_if>> & p_checkers);
+
+        /**
+         * Table of some checkers of another table, masks are copied
+         * @param p_table table of all checkers
+         * @param p_checkers_index index of kept checkers in p_table
+         */
+        inline
+        condition_table(const condition_table & p_table
+                       ,const std::vector<unsigned int> & p_checkers_index
+                       );
+
+        [[nodiscard]] inline
+        unsigned int
+        get_nb_checkers() const;
+
+        [[nodiscard]] inline
+        unsigned int
+        get_grade(unsigned int p_checker_index) const;
+
+        [[nodiscard]] inline
+        const code_set &
+        get_mask(unsigned int p_checker_index
+                ,unsigned int p_condition_index
+                ) const;
+
+        /**
+         * Compute mask of codes satisfying a checker condition
+         * @param p_checker checker to evaluate
+         * @param p_condition_index index of condition
+         * @return codes for which condition is true
+         */
+        [[nodiscard]] inline static
+        code_set
+        compute_mask(const checker_if & p_checker
+                    ,unsigned int p_condition_index
+                    );
+
+        /**
+         * Index of candidate in code sets. Index order is the same as
+         * candidate order
+         */
+        [[nodiscard]] inline static
+        unsigned int
+        code_index(const candidate & p_candidate);
+
+        [[nodiscard]] inline static
+        candidate
+        index_code(unsigned int p_index);
+
+        /**
+         * Index of first code present in code set
+         * @return code index or m_nb_codes if code set is empty
+         */
+        [[nodiscard]] inline static
+        unsigned int
+        first_code(const code_set & p_codes);
+
+        static constexpr unsigned int m_nb_codes = 125;
+
+    private:
+        std::vector<std::vector<code_set>> m_masks;
+    };
+
+    //-------------------------------------------------------------------------
+    condition_table::condition_table(const std::vector<std::shared_ptr<checker_if>> & p_checkers)
+    {
+        for(const auto & l_iter: p_checkers)
+        {
+            std::vector<code_set> l_masks;
+            for(unsigned int l_condition_index = 0; l_condition_index < l_iter->get_grade(); ++l_condition_index)
+            {
+                l_masks.emplace_back(compute_mask(*l_iter, l_condition_index));
+            }
+            m_masks.emplace_back(std::move(l_masks));
+        }
+    }
+
+    //-------------------------------------------------------------------------
+    condition_table::condition_table(const condition_table & p_table
+                                    ,const std::vector<unsigned int> & p_checkers_index
+                                    )
+    {
+        for(auto l_checker_index: p_checkers_index)
+        {
+            assert(l_checker_index < p_table.m_masks.size());
+            m_masks.emplace_back(p_table.m_masks[l_checker_index]);
+        }
+    }
+
+    //-------------------------------------------------------------------------
+    unsigned int
+    condition_table::get_nb_checkers() const
+    {
+        return static_cast<unsigned int>(m_masks.size());
+    }
+
+    //-------------------------------------------------------------------------
+    unsigned int
+    condition_table::get_grade(unsigned int p_checker_index) const
+    {
+        assert(p_checker_index < m_masks.size());
+        return static_cast<unsigned int>(m_masks[p_checker_index].size());
+    }
+
+    //-------------------------------------------------------------------------
+    const code_set &
+    condition_table::get_mask(unsigned int p_checker_index
+                             ,unsigned int p_condition_index
+                             ) const
+    {
+        assert(p_checker_index < m_masks.size());
+        assert(p_condition_index < m_masks[p_checker_index].size());
+        return m_masks[p_checker_index][p_condition_index];
+    }
+
+    //-------------------------------------------------------------------------
+    code_set
+    condition_table::compute_mask(const checker_if & p_checker
+                                 ,unsigned int p_condition_index
+                                 )
+    {
+        code_set l_result;
+        for(unsigned int l_index = 0; l_index < m_nb_codes; ++l_index)
+        {
+            l_result[l_index] = p_checker.run(p_condition_index, index_code(l_index));
+        }
+        return l_result;
+    }
+
+    //-------------------------------------------------------------------------
+    unsigned int
+    condition_table::code_index(const candidate & p_candidate)
+    {
+        return 25 * (p_candidate.get_blue_triangle() - 1) + 5 * (p_candidate.get_yellow_square() - 1) + p_candidate.get_purple_circle() - 1;
+    }
+
+    //-------------------------------------------------------------------------
+    candidate
+    condition_table::index_code(unsigned int p_index)
+    {
+        if(p_index >= m_nb_codes)
+        {
+            throw quicky_exception::quicky_logic_exception("Bad code index " + std::to_string(p_index)
+                                                          ,__LINE__
+                                                          ,__FILE__
+                                                          );
+        }
+        return {1 + p_index / 25, 1 + (p_index / 5) % 5, 1 + p_index % 5};
+    }
+
+    //-------------------------------------------------------------------------
+    unsigned int
+    condition_table::first_code(const code_set & p_codes)
+    {
+        unsigned int l_index = 0;
+        while(l_index < m_nb_codes && !p_codes.test(l_index))
+        {
+            ++l_index;
+        }
+        return l_index;
+    }
+}
+#endif //TURING_MACHINE_SOLVER_CONDITION_TABLE_H
+// EOF
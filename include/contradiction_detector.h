@@ -0,0 +1,294 @@
+/*    This file is part of turing_machine_solver
+      Copyright (C) 2024  Julien Thevenon ( julien_thevenon at yahoo.fr )
+
+      This program is free software: you can redistribute it and/or modify
+      it under the terms of the GNU General Public License as published by
+      the Free Software Foundation, either version 3 of the License, or
+      (at your option) any later version.
+
+      This program is distributed in the hope that it will be useful,
+      but WITHOUT ANY WARRANTY; without even the implied warranty of
+      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+      GNU General Public License for more details.
+
+      You should have received a copy of the GNU General Public License
+      along with this program.  If not, see <http://www.gnu.org/licenses/>
+*/
+
+#ifndef TURING_MACHINE_SOLVER_CONTRADICTION_DETECTOR_H
+#define TURING_MACHINE_SOLVER_CONTRADICTION_DETECTOR_H
+
+#include "condition_table.h"
+#include "criteria_space.h"
+#include "quicky_exception.h"
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+namespace turing_machine_solver
+{
+    /**
+     * Answer of a checker for a proposed code
+     */
+    class checker_answer
+    {
+    public:
+        unsigned int m_code_index;
+
+        unsigned int m_checker_index;
+
+        bool m_result;
+    };
+
+    /**
+     * Record answers of a game to detect as soon as no hypothesis satisfies
+     * them all, hypotheses being criteria if a criteria space is given and
+     * initial candidates otherwise. Answers rejecting each hypothesis are
+     * kept as a bitfield, so smallest sets of answers whose removal restores
+     * consistency are the smallest bitfields
+     */
+    class contradiction_detector
+    {
+    public:
+
+        static constexpr unsigned int m_max_answers = 64;
+
+        /**
+         * Checker index token asking to roll back a set of conflicting
+         * answers, followed by the set number
+         */
+        static constexpr int m_rollback_index = -2;
+
+        /**
+         * @param p_table condition masks of game checkers
+         * @param p_initial_codes candidates before any answer
+         * @param p_space criteria of game checkers, ignored if null or
+         * without criteria
+         */
+        inline
+        contradiction_detector(condition_table p_table
+                              ,const code_set & p_initial_codes
+                              ,const criteria_space * p_space = nullptr
+                              );
+
+        inline
+        void
+        add(const checker_answer & p_answer);
+
+        [[nodiscard]] inline
+        const std::vector<checker_answer> &
+        get_answers() const;
+
+        [[nodiscard]] inline
+        bool
+        is_contradictory() const;
+
+        /**
+         * Smallest sets of answers whose removal restores consistency, as
+         * mistyped answers cannot be told apart when several sets exist
+         * @return bitfields of answer indexes, sets with most recent answers
+         * first, empty if answers are consistent
+         */
+        [[nodiscard]] inline
+        std::vector<uint64_t>
+        get_minimal_conflicts() const;
+
+        /**
+         * Remove answers, remaining ones keep their order
+         * @param p_answers bitfield of answer indexes
+         */
+        inline
+        void
+        remove(uint64_t p_answers);
+
+    private:
+
+        /**
+         * Codes kept by an answer, rules are those of solver::analyze_result
+         */
+        [[nodiscard]] inline
+        code_set
+        compute_kept_codes(const checker_answer & p_answer) const;
+
+        condition_table m_table;
+
+        const code_set m_initial_codes;
+
+        const criteria_space * m_space;
+
+        std::vector<checker_answer> m_answers;
+
+        /**
+         * Candidates satisfying all answers
+         */
+        code_set m_remaining;
+
+        /**
+         * Answers rejecting each code
+         */
+        std::array<uint64_t, condition_table::m_nb_codes> m_code_rejections;
+
+        /**
+         * Answers rejecting each criteria
+         */
+        std::vector<uint64_t> m_criteria_rejections;
+
+        unsigned int m_nb_consistent_criteria;
+    };
+
+    //-------------------------------------------------------------------------
+    contradiction_detector::contradiction_detector(condition_table p_table
+                                                  ,const code_set & p_initial_codes
+                                                  ,const criteria_space * p_space
+                                                  )
+    :m_table{std::move(p_table)}
+    ,m_initial_codes{p_initial_codes}
+    ,m_space{p_space && p_space->get_nb_criteria() ? p_space : nullptr}
+    ,m_remaining{p_initial_codes}
+    ,m_code_rejections{}
+    ,m_criteria_rejections(m_space ? m_space->get_nb_criteria() : 0, 0)
+    ,m_nb_consistent_criteria{m_space ? m_space->get_nb_criteria() : 0}
+    {
+    }
+
+    //-------------------------------------------------------------------------
+    code_set
+    contradiction_detector::compute_kept_codes(const checker_answer & p_answer) const
+    {
+        // True result keeps codes sharing a condition with proposed code,
+        // false result keeps codes whose conditions differ
+        code_set l_shared;
+        code_set l_same;
+        l_same.set();
+        for(unsigned int l_condition_index = 0; l_condition_index < m_table.get_grade(p_answer.m_checker_index); ++l_condition_index)
+        {
+            const code_set & l_mask = m_table.get_mask(p_answer.m_checker_index, l_condition_index);
+            if(l_mask.test(p_answer.m_code_index))
+            {
+                l_shared |= l_mask;
+                l_same &= l_mask;
+            }
+            else
+            {
+                l_same &= ~l_mask;
+            }
+        }
+        return p_answer.m_result ? l_shared : ~l_same;
+    }
+
+    //-------------------------------------------------------------------------
+    void
+    contradiction_detector::add(const checker_answer & p_answer)
+    {
+        if(m_answers.size() >= m_max_answers)
+        {
+            throw quicky_exception::quicky_logic_exception("Too many answers", __LINE__, __FILE__);
+        }
+        if(p_answer.m_checker_index >= m_table.get_nb_checkers() || p_answer.m_code_index >= condition_table::m_nb_codes)
+        {
+            throw quicky_exception::quicky_logic_exception("Bad answer", __LINE__, __FILE__);
+        }
+        uint64_t l_bit = uint64_t(1) << m_answers.size();
+        m_answers.emplace_back(p_answer);
+
+        code_set l_rejected = m_initial_codes & ~compute_kept_codes(p_answer);
+        m_remaining &= ~l_rejected;
+        for(unsigned int l_code_index = 0; l_code_index < condition_table::m_nb_codes; ++l_code_index)
+        {
+            m_code_rejections[l_code_index] |= l_rejected.test(l_code_index) ? l_bit : 0;
+        }
+        for(unsigned int l_criteria_index = 0; l_criteria_index < m_criteria_rejections.size(); ++l_criteria_index)
+        {
+            if(m_space->is_accepted(l_criteria_index, p_answer.m_checker_index, p_answer.m_code_index) != p_answer.m_result)
+            {
+                m_nb_consistent_criteria -= !m_criteria_rejections[l_criteria_index];
+                m_criteria_rejections[l_criteria_index] |= l_bit;
+            }
+        }
+    }
+
+    //-------------------------------------------------------------------------
+    const std::vector<checker_answer> &
+    contradiction_detector::get_answers() const
+    {
+        return m_answers;
+    }
+
+    //-------------------------------------------------------------------------
+    bool
+    contradiction_detector::is_contradictory() const
+    {
+        return m_remaining.none() || (m_space && !m_nb_consistent_criteria);
+    }
+
+    //-------------------------------------------------------------------------
+    std::vector<uint64_t>
+    contradiction_detector::get_minimal_conflicts() const
+    {
+        std::vector<uint64_t> l_conflicts;
+        if(!is_contradictory())
+        {
+            return l_conflicts;
+        }
+        // A criteria consistent with answers keeps its solution code so
+        // criteria give the smallest conflicts when they are known
+        int l_best_count = m_max_answers + 1;
+        auto l_consider = [&](uint64_t p_rejections)
+                          {
+                              int l_count = std::popcount(p_rejections);
+                              if(l_count < l_best_count)
+                              {
+                                  l_best_count = l_count;
+                                  l_conflicts.clear();
+                              }
+                              if(l_count == l_best_count)
+                              {
+                                  l_conflicts.emplace_back(p_rejections);
+                              }
+                          };
+        if(m_space)
+        {
+            for(auto l_rejections: m_criteria_rejections)
+            {
+                l_consider(l_rejections);
+            }
+        }
+        else
+        {
+            for(unsigned int l_code_index = 0; l_code_index < condition_table::m_nb_codes; ++l_code_index)
+            {
+                if(m_initial_codes.test(l_code_index))
+                {
+                    l_consider(m_code_rejections[l_code_index]);
+                }
+            }
+        }
+        std::sort(l_conflicts.begin(), l_conflicts.end(), std::greater<uint64_t>());
+        l_conflicts.erase(std::unique(l_conflicts.begin(), l_conflicts.end()), l_conflicts.end());
+        return l_conflicts;
+    }
+
+    //-------------------------------------------------------------------------
+    void
+    contradiction_detector::remove(uint64_t p_answers)
+    {
+        std::vector<checker_answer> l_answers;
+        std::swap(l_answers, m_answers);
+        m_remaining = m_initial_codes;
+        m_code_rejections.fill(0);
+        std::fill(m_criteria_rejections.begin(), m_criteria_rejections.end(), 0);
+        m_nb_consistent_criteria = static_cast<unsigned int>(m_criteria_rejections.size());
+        for(unsigned int l_index = 0; l_index < l_answers.size(); ++l_index)
+        {
+            if(!(p_answers >> l_index & 1))
+            {
+                add(l_answers[l_index]);
+            }
+        }
+    }
+}
+#endif //TURING_MACHINE_SOLVER_CONTRADICTION_DETECTOR_H
+// EOF
@@ -0,0 +1,229 @@
+/*    This file is part of turing_machine_solver
+      Copyright (C) 2024  Julien Thevenon ( julien_thevenon at yahoo.fr )
+
+      This program is free software: you can redistribute it and/or modify
+      it under the terms of the GNU General Public License as published by
+      the Free Software Foundation, either version 3 of the License, or
+      (at your option) any later version.
+
+      This program is distributed in the hope that it will be useful,
+      but WITHOUT ANY WARRANTY; without even the implied warranty of
+      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+      GNU General Public License for more details.
+
+      You should have received a copy of the GNU General Public License
+      along with this program.  If not, see <http://www.gnu.org/licenses/>
+*/
+
+#ifndef TURING_MACHINE_SOLVER_CRITERIA_SPACE_H
+#define TURING_MACHINE_SOLVER_CRITERIA_SPACE_H
+
+#include "condition_table.h"
+#include <vector>
+#include <memory>
+#include <cassert>
+
+namespace turing_machine_solver
+{
+    /**
+     * All criteria of a checker list selecting a single code. A criteria
+     * gives the condition index of each checker
+     */
+    class criteria_space
+    {
+    public:
+        inline explicit
+        criteria_space(const std::vector<std::shared_ptr<checker_if>> & p_checkers);
+
+        /**
+         * Criteria of checkers of a table, which avoids computing masks
+         * again when they are known
+         */
+        inline explicit
+        criteria_space(condition_table p_table);
+
+        [[nodiscard]] inline
+        const condition_table &
+        get_table() const;
+
+        [[nodiscard]] inline
+        unsigned int
+        get_nb_checkers() const;
+
+        [[nodiscard]] inline
+        unsigned int
+        get_nb_criteria() const;
+
+        [[nodiscard]] inline
+        const std::vector<unsigned int> &
+        get_criteria(unsigned int p_criteria_index) const;
+
+        /**
+         * Index of the code selected by criteria
+         */
+        [[nodiscard]] inline
+        unsigned int
+        get_solution(unsigned int p_criteria_index) const;
+
+        /**
+         * Indicate if checker would accept code with this criteria
+         * @param p_criteria_index index of criteria
+         * @param p_checker_index index of checker
+         * @param p_code_index index of proposed code
+         * @return checker answer
+         */
+        [[nodiscard]] inline
+        bool
+        is_accepted(unsigned int p_criteria_index
+                   ,unsigned int p_checker_index
+                   ,unsigned int p_code_index
+                   ) const;
+
+        /**
+         * Codes selected by a subset of criteria
+         * @param p_criteria_indexes indexes of criteria
+         * @return solution codes
+         */
+        [[nodiscard]] inline
+        code_set
+        get_solutions(const std::vector<unsigned int> & p_criteria_indexes) const;
+
+        /**
+         * Index of all criteria
+         */
+        [[nodiscard]] inline
+        std::vector<unsigned int>
+        get_all_indexes() const;
+
+    private:
+
+        inline
+        void
+        compute_criteria(std::vector<unsigned int> & p_criteria
+                        ,const code_set & p_codes
+                        );
+
+        condition_table m_table;
+
+        std::vector<std::vector<unsigned int>> m_criteria;
+
+        std::vector<unsigned int> m_solutions;
+    };
+
+    //-------------------------------------------------------------------------
+    criteria_space::criteria_space(const std::vector<std::shared_ptr<checker_if>> & p_checkers)
+    :criteria_space{condition_table{p_checkers}}
+    {
+    }
+
+    //-------------------------------------------------------------------------
+    criteria_space::criteria_space(condition_table p_table)
+    :m_table{std::move(p_table)}
+    {
+        std::vector<unsigned int> l_criteria;
+        compute_criteria(l_criteria, code_set().set());
+    }
+
+    //-------------------------------------------------------------------------
+    void
+    criteria_space::compute_criteria(std::vector<unsigned int> & p_criteria
+                                    ,const code_set & p_codes
+                                    )
+    {
+        if(p_criteria.size() == m_table.get_nb_checkers())
+        {
+            if(p_codes.count() == 1)
+            {
+                m_criteria.emplace_back(p_criteria);
+                m_solutions.emplace_back(condition_table::first_code(p_codes));
+            }
+            return;
+        }
+        auto l_checker_index = static_cast<unsigned int>(p_criteria.size());
+        for(unsigned int l_condition_index = 0; l_condition_index < m_table.get_grade(l_checker_index); ++l_condition_index)
+        {
+            code_set l_codes = p_codes & m_table.get_mask(l_checker_index, l_condition_index);
+            // Prune as soon as no code remains
+            if(l_codes.any())
+            {
+                p_criteria.emplace_back(l_condition_index);
+                compute_criteria(p_criteria, l_codes);
+                p_criteria.pop_back();
+            }
+        }
+    }
+
+    //-------------------------------------------------------------------------
+    const condition_table &
+    criteria_space::get_table() const
+    {
+        return m_table;
+    }
+
+    //-------------------------------------------------------------------------
+    unsigned int
+    criteria_space::get_nb_checkers() const
+    {
+        return m_table.get_nb_checkers();
+    }
+
+    //-------------------------------------------------------------------------
+    unsigned int
+    criteria_space::get_nb_criteria() const
+    {
+        return static_cast<unsigned int>(m_criteria.size());
+    }
+
+    //-------------------------------------------------------------------------
+    const std::vector<unsigned int> &
+    criteria_space::get_criteria(unsigned int p_criteria_index) const
+    {
+        assert(p_criteria_index < m_criteria.size());
+        return m_criteria[p_criteria_index];
+    }
+
+    //-------------------------------------------------------------------------
+    unsigned int
+    criteria_space::get_solution(unsigned int p_criteria_index) const
+    {
+        assert(p_criteria_index < m_solutions.size());
+        return m_solutions[p_criteria_index];
+    }
+
+    //-------------------------------------------------------------------------
+    bool
+    criteria_space::is_accepted(unsigned int p_criteria_index
+                               ,unsigned int p_checker_index
+                               ,unsigned int p_code_index
+                               ) const
+    {
+        assert(p_criteria_index < m_criteria.size());
+        return m_table.get_mask(p_checker_index, m_criteria[p_criteria_index][p_checker_index]).test(p_code_index);
+    }
+
+    //-------------------------------------------------------------------------
+    code_set
+    criteria_space::get_solutions(const std::vector<unsigned int> & p_criteria_indexes) const
+    {
+        code_set l_result;
+        for(auto l_index: p_criteria_indexes)
+        {
+            l_result.set(get_solution(l_index));
+        }
+        return l_result;
+    }
+
+    //-------------------------------------------------------------------------
+    std::vector<unsigned int>
+    criteria_space::get_all_indexes() const
+    {
+        std::vector<unsigned int> l_result(m_criteria.size());
+        for(unsigned int l_index = 0; l_index < l_result.size(); ++l_index)
+        {
+            l_result[l_index] = l_index;
+        }
+        return l_result;
+    }
+}
+#endif //TURING_MACHINE_SOLVER_CRITERIA_SPACE_H
+// EOF
@@ -0,0 +1,447 @@
+/*    This file is part of turing_machine_solver
+      Copyright (C) 2024  Julien Thevenon ( julien_thevenon at yahoo.fr )
+
+      This program is free software: you can redistribute it and/or modify
+      it under the terms of the GNU General Public License as published by
+      the Free Software Foundation, either version 3 of the License, or
+      (at your option) any later version.
+
+      This program is distributed in the hope that it will be useful,
+      but WITHOUT ANY WARRANTY; without even the implied warranty of
+      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+      GNU General Public License for more details.
+
+      You should have received a copy of the GNU General Public License
+      along with this program.  If not, see <http://www.gnu.org/licenses/>
+*/
+
+#ifndef TURING_MACHINE_SOLVER_DIFFERENTIAL_FUZZER_H
+#define TURING_MACHINE_SOLVER_DIFFERENTIAL_FUZZER_H
+
+#include "solver.h"
+#include "condition_table.h"
+#include "work_stealing_pool.h"
+#include "quicky_exception.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace turing_machine_solver
+{
+    /**
+     * Checker result for a code, as given in a game
+     */
+    class fuzz_check
+    {
+    public:
+        unsigned int m_code;
+
+        unsigned int m_checker_index;
+
+        bool m_result;
+    };
+
+    /**
+     * Game played by fuzzer: checker ids and checks
+     */
+    class fuzz_case
+    {
+        friend std::ostream & operator<<(std::ostream &, const fuzz_case & );
+
+    public:
+        std::vector<unsigned int> m_checkers_id;
+
+        std::vector<fuzz_check> m_checks;
+    };
+
+    /**
+     * Play random games on solver and on another engine in lockstep,
+     * comparing remaining codes and their signatures after each step, and
+     * shrink failing games. Engine is either an alternative implementation
+     * like bitset_solver or the map_solver reference implementation.
+     * ENGINE is built from checker ids and provides get_remaining_codes,
+     * get_related_checkers returning a signature displayed like
+     * potential_checkers, and analyze_result taking that signature
+     */
+    template <typename ENGINE>
+    class differential_fuzzer
+    {
+    public:
+
+        /**
+         * @param p_seed seed of random generators, thread index is added
+         * @param p_min_checkers minimal number of checkers of a game
+         * @param p_max_checkers maximal number of checkers of a game
+         */
+        inline explicit
+        differential_fuzzer(uint64_t p_seed
+                           ,unsigned int p_min_checkers = 4
+                           ,unsigned int p_max_checkers = 6
+                           );
+
+        /**
+         * Generate and compare games until budget expires or a divergence
+         * is found
+         * @param p_budget time budget
+         * @param p_nb_threads number of threads, 0 means hardware concurrency
+         * @return minimal failing game if any
+         */
+        [[nodiscard]] inline
+        std::optional<fuzz_case>
+        run(std::chrono::milliseconds p_budget
+           ,unsigned int p_nb_threads = 0
+           );
+
+        /**
+         * Play a game on both implementations
+         * @return description of first divergence, empty if none
+         */
+        [[nodiscard]] inline static
+        std::string
+        compare(const fuzz_case & p_case);
+
+        /**
+         * Remove checks of a failing game while it keeps failing
+         */
+        [[nodiscard]] inline static
+        fuzz_case
+        shrink(fuzz_case p_case);
+
+        [[nodiscard]] inline
+        uint64_t
+        get_nb_cases() const;
+
+        [[nodiscard]] inline
+        uint64_t
+        get_nb_checks() const;
+
+    private:
+
+        [[nodiscard]] inline
+        fuzz_case
+        generate(std::mt19937_64 & p_generator) const;
+
+        template <typename SIGNATURE>
+        [[nodiscard]] inline static
+        std::string
+        to_string(const SIGNATURE & p_signature);
+
+        uint64_t m_seed;
+
+        unsigned int m_min_checkers;
+
+        unsigned int m_max_checkers;
+
+        std::vector<unsigned int> m_checkers_id;
+
+        std::atomic<uint64_t> m_nb_cases;
+
+        std::atomic<uint64_t> m_nb_checks;
+    };
+
+    //-------------------------------------------------------------------------
+    std::ostream & operator<<(std::ostream & p_stream, const fuzz_case & p_case)
+    {
+        p_stream << "checkers";
+        for(auto l_id: p_case.m_checkers_id)
+        {
+            p_stream << " " << l_id;
+        }
+        p_stream << " checks";
+        for(const auto & l_check: p_case.m_checks)
+        {
+            p_stream << " " << l_check.m_code << ":" << l_check.m_checker_index << ":" << l_check.m_result;
+        }
+        return p_stream;
+    }
+
+    //-------------------------------------------------------------------------
+    template <typename ENGINE>
+    differential_fuzzer<ENGINE>::differential_fuzzer(uint64_t p_seed
+                                                    ,unsigned int p_min_checkers
+                                                    ,unsigned int p_max_checkers
+                                                    )
+    :m_seed{p_seed}
+    ,m_min_checkers{p_min_checkers}
+    ,m_max_checkers{p_max_checkers}
+    ,m_checkers_id{solver::get_checker_ids()}
+    ,m_nb_cases{0}
+    ,m_nb_checks{0}
+    {
+        if(!m_min_checkers || m_min_checkers > m_max_checkers || m_max_checkers > m_checkers_id.size())
+        {
+            throw quicky_exception::quicky_logic_exception("Bad number of checkers [" + std::to_string(m_min_checkers) + "," + std::to_string(m_max_checkers) + "]", __LINE__, __FILE__);
+        }
+    }
+
+    //-------------------------------------------------------------------------
+    template <typename ENGINE>
+    template <typename SIGNATURE>
+    std::string
+    differential_fuzzer<ENGINE>::to_string(const SIGNATURE & p_signature)
+    {
+        std::stringstream l_stream;
+        l_stream << p_signature;
+        return l_stream.str();
+    }
+
+    //-------------------------------------------------------------------------
+    template <typename ENGINE>
+    fuzz_case
+    differential_fuzzer<ENGINE>::generate(std::mt19937_64 & p_generator) const
+    {
+        fuzz_case l_case;
+        std::vector<unsigned int> l_ids{m_checkers_id};
+        std::shuffle(l_ids.begin(), l_ids.end(), p_generator);
+        auto l_nb_checkers = std::uniform_int_distribution<unsigned int>{m_min_checkers, m_max_checkers}(p_generator);
+        l_case.m_checkers_id.assign(l_ids.begin(), l_ids.begin() + l_nb_checkers);
+
+        // Codes are mostly taken among remaining ones, like a player would
+        solver l_solver{l_case.m_checkers_id, false};
+        std::uniform_int_distribution<unsigned int> l_code_distribution{0, condition_table::m_nb_codes - 1};
+        std::uniform_int_distribution<unsigned int> l_checker_distribution{0, l_nb_checkers - 1};
+        std::uniform_int_distribution<unsigned int> l_percent{0, 99};
+        unsigned int l_nb_codes = std::uniform_int_distribution<unsigned int>{1, 8}(p_generator);
+        for(unsigned int l_code_rank = 0; l_code_rank < l_nb_codes && l_solver.get_remaining_candidates(); ++l_code_rank)
+        {
+            code_set l_remaining = l_solver.get_remaining_codes();
+            unsigned int l_code_index = l_code_distribution(p_generator);
+            if(l_percent(p_generator) >= 5)
+            {
+                // Pick n-th remaining code
+                unsigned int l_rank = l_code_index % static_cast<unsigned int>(l_remaining.count());
+                l_code_index = 0;
+                while(!l_remaining.test(l_code_index) || l_rank--)
+                {
+                    ++l_code_index;
+                }
+            }
+            candidate l_candidate = condition_table::index_code(l_code_index);
+            unsigned int l_code = 100 * l_candidate.get_blue_triangle() + 10 * l_candidate.get_yellow_square() + l_candidate.get_purple_circle();
+            std::optional<potential_checkers> l_checkers;
+            if(l_remaining.test(l_code_index))
+            {
+                l_checkers = l_solver.get_related_checkers(l_candidate);
+            }
+            unsigned int l_nb_checks = std::uniform_int_distribution<unsigned int>{1, 3}(p_generator);
+            for(unsigned int l_check_index = 0; l_check_index < l_nb_checks; ++l_check_index)
+            {
+                fuzz_check l_check{l_code, l_checker_distribution(p_generator), static_cast<bool>(l_percent(p_generator) % 2)};
+                l_case.m_checks.emplace_back(l_check);
+                if(l_checkers)
+                {
+                    l_solver.analyze_result(*l_checkers, l_check.m_checker_index, l_check.m_result);
+                }
+            }
+        }
+        return l_case;
+    }
+
+    //-------------------------------------------------------------------------
+    template <typename ENGINE>
+    std::string
+    differential_fuzzer<ENGINE>::compare(const fuzz_case & p_case)
+    {
+        std::optional<solver> l_reference;
+        std::optional<ENGINE> l_engine;
+        std::string l_reference_error;
+        std::string l_engine_error;
+        try
+        {
+            l_reference.emplace(p_case.m_checkers_id, false);
+        }
+        catch(quicky_exception::quicky_logic_exception & e)
+        {
+            l_reference_error = e.what();
+        }
+        try
+        {
+            l_engine.emplace(p_case.m_checkers_id);
+        }
+        catch(quicky_exception::quicky_logic_exception & e)
+        {
+            l_engine_error = e.what();
+        }
+        if(!l_reference || !l_engine)
+        {
+            return l_reference.has_value() == l_engine.has_value() ? "" : "construction: reference \"" + l_reference_error + "\" engine \"" + l_engine_error + "\"";
+        }
+
+        std::optional<unsigned int> l_current_code;
+        std::optional<potential_checkers> l_reference_signature;
+        std::optional<std::remove_cvref_t<decltype(l_engine->get_related_checkers(candidate{111}))>> l_engine_signature;
+        auto l_check_state = [&](const std::string & p_step) -> std::string
+        {
+            code_set l_codes = l_reference->get_remaining_codes();
+            if(l_codes != l_engine->get_remaining_codes())
+            {
+                return p_step + ": remaining codes differ";
+            }
+            for(unsigned int l_code_index = 0; l_code_index < condition_table::m_nb_codes; ++l_code_index)
+            {
+                if(l_codes.test(l_code_index))
+                {
+                    candidate l_candidate = condition_table::index_code(l_code_index);
+                    std::string l_reference_string = to_string(l_reference->get_related_checkers(l_candidate));
+                    std::string l_engine_string = to_string(l_engine->get_related_checkers(l_candidate));
+                    if(l_reference_string != l_engine_string)
+                    {
+                        std::stringstream l_stream;
+                        l_stream << p_step << ": signature of " << l_candidate << " is " << l_reference_string << " instead of " << l_engine_string;
+                        return l_stream.str();
+                    }
+                }
+            }
+            return "";
+        };
+
+        std::string l_result = l_check_state("construction");
+        for(size_t l_index = 0; l_result.empty() && l_index < p_case.m_checks.size(); ++l_index)
+        {
+            const fuzz_check & l_check = p_case.m_checks[l_index];
+            if(!l_current_code || *l_current_code != l_check.m_code)
+            {
+                // Both implementations must agree on codes that can be checked
+                l_current_code = l_check.m_code;
+                l_reference_signature.reset();
+                l_engine_signature.reset();
+                try
+                {
+                    l_reference_signature = l_reference->get_related_checkers(candidate{l_check.m_code});
+                }
+                catch(quicky_exception::quicky_logic_exception &)
+                {
+                }
+                try
+                {
+                    l_engine_signature.emplace(l_engine->get_related_checkers(candidate{l_check.m_code}));
+                }
+                catch(quicky_exception::quicky_logic_exception &)
+                {
+                }
+                if(l_reference_signature.has_value() != l_engine_signature.has_value())
+                {
+                    return "check " + std::to_string(l_index) + ": code " + std::to_string(l_check.m_code) + " accepted by only one implementation";
+                }
+            }
+            if(!l_reference_signature)
+            {
+                continue;
+            }
+            bool l_reference_ok = true;
+            bool l_engine_ok = true;
+            try
+            {
+                l_reference->analyze_result(*l_reference_signature, l_check.m_checker_index, l_check.m_result);
+            }
+            catch(quicky_exception::quicky_logic_exception &)
+            {
+                l_reference_ok = false;
+            }
+            try
+            {
+                l_engine->analyze_result(*l_engine_signature, l_check.m_checker_index, l_check.m_result);
+            }
+            catch(quicky_exception::quicky_logic_exception &)
+            {
+                l_engine_ok = false;
+            }
+            if(l_reference_ok != l_engine_ok)
+            {
+                return "check " + std::to_string(l_index) + ": rejected by only one implementation";
+            }
+            l_result = l_check_state("check " + std::to_string(l_index));
+        }
+        return l_result;
+    }
+
+    //-------------------------------------------------------------------------
+    template <typename ENGINE>
+    fuzz_case
+    differential_fuzzer<ENGINE>::shrink(fuzz_case p_case)
+    {
+        bool l_reduced = true;
+        while(l_reduced)
+        {
+            l_reduced = false;
+            // Try to remove each check, last ones first as they are more often irrelevant
+            for(size_t l_index = p_case.m_checks.size(); l_index-- > 0;)
+            {
+                fuzz_case l_candidate_case{p_case};
+                l_candidate_case.m_checks.erase(l_candidate_case.m_checks.begin() + static_cast<std::ptrdiff_t>(l_index));
+                if(!compare(l_candidate_case).empty())
+                {
+                    p_case = std::move(l_candidate_case);
+                    l_reduced = true;
+                }
+            }
+        }
+        return p_case;
+    }
+
+    //-------------------------------------------------------------------------
+    template <typename ENGINE>
+    std::optional<fuzz_case>
+    differential_fuzzer<ENGINE>::run(std::chrono::milliseconds p_budget
+                                    ,unsigned int p_nb_threads
+                                    )
+    {
+        auto l_deadline = std::chrono::steady_clock::now() + p_budget;
+        std::atomic<bool> l_failed{false};
+        std::mutex l_mutex;
+        std::optional<fuzz_case> l_failure;
+        work_stealing_pool l_pool{p_nb_threads};
+        l_pool.run(l_pool.get_nb_threads()
+                  ,[&](size_t p_task, unsigned int)
+                   {
+                       std::mt19937_64 l_generator{m_seed + p_task};
+                       while(!l_failed.load(std::memory_order_relaxed) && std::chrono::steady_clock::now() < l_deadline)
+                       {
+                           fuzz_case l_case = generate(l_generator);
+                           m_nb_cases.fetch_add(1, std::memory_order_relaxed);
+                           m_nb_checks.fetch_add(l_case.m_checks.size(), std::memory_order_relaxed);
+                           if(!compare(l_case).empty())
+                           {
+                               std::lock_guard<std::mutex> l_lock{l_mutex};
+                               if(!l_failure)
+                               {
+                                   l_failure = l_case;
+                                   l_failed.store(true, std::memory_order_relaxed);
+                               }
+                           }
+                       }
+                   }
+                  );
+        if(l_failure)
+        {
+            l_failure = shrink(*l_failure);
+        }
+        return l_failure;
+    }
+
+    //-------------------------------------------------------------------------
+    template <typename ENGINE>
+    uint64_t
+    differential_fuzzer<ENGINE>::get_nb_cases() const
+    {
+        return m_nb_cases.load(std::memory_order_relaxed);
+    }
+
+    //-------------------------------------------------------------------------
+    template <typename ENGINE>
+    uint64_t
+    differential_fuzzer<ENGINE>::get_nb_checks() const
+    {
+        return m_nb_checks.load(std::memory_order_relaxed);
+    }
+}
+#endif //TURING_MACHINE_SOLVER_DIFFERENTIAL_FUZZER_H
+// EOF
@@ -0,0 +1,567 @@
+/*    This file is part of turing_machine_solver
+      Copyright (C) 2024  Julien Thevenon ( julien_thevenon at yahoo.fr )
+
+      This program is free software: you can redistribute it and/or modify
+      it under the terms of the GNU General Public License as published by
+      the Free Software Foundation, either version 3 of the License, or
+      (at your option) any later version.
+
+      This program is distributed in the hope that it will be useful,
+      but WITHOUT ANY WARRANTY; without even the implied warranty of
+      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+      GNU General Public License for more details.
+
+      You should have received a copy of the GNU General Public License
+      along with this program.  If not, see <http://www.gnu.org/licenses/>
+*/
+
+#ifndef TURING_MACHINE_SOLVER_DIFFICULTY_RATER_H
+#define TURING_MACHINE_SOLVER_DIFFICULTY_RATER_H
+
+#include "solver.h"
+#include "criteria_space.h"
+#include "work_stealing_pool.h"
+#include "quicky_exception.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <vector>
+#include <set>
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+#include <mutex>
+#include <iostream>
+#include <iomanip>
+
+namespace turing_machine_solver
+{
+    /**
+     * Compute difficulty metrics of a checker list:
+     * - expected number of checks when always choosing the query that
+     *   minimise expected number of remaining criteria
+     * - minimal number of rounds needed in worst case, a round being
+     *   a proposed code tested by up to 3 checkers
+     */
+    class difficulty_rater
+    {
+    public:
+        /**
+         * @param p_space criteria of checker list
+         * @param p_node_budget maximum number of nodes explored when searching
+         * optimal number of rounds
+         */
+        inline explicit
+        difficulty_rater(const criteria_space & p_space
+                        ,unsigned long long p_node_budget = 1000000
+                        );
+
+        [[nodiscard]] inline
+        double
+        get_greedy_expected_checks() const;
+
+        /**
+         * Search minimal number of rounds needed in worst case
+         * @return number of rounds and a flag indicating if value is exact.
+         * If node budget is exhausted value is a lower bound
+         */
+        [[nodiscard]] inline
+        std::pair<unsigned int, bool>
+        get_optimal_worst_rounds();
+
+        /**
+         * Rate all checker lists of input file and write results in output
+         * file. Input file contains one list of checker ids per line.
+         * Each output line gives input line number, checker ids, remaining
+         * candidates of solver before any check, optimal worst rounds and
+         * greedy expected checks.
+         * Output file is used as checkpoint: lines already rated are skipped
+         * @param p_input_name name of input file
+         * @param p_output_name name of output file, "-" for standard output
+         * which is not used as checkpoint
+         * @param p_nb_threads number of threads, 0 means hardware concurrency
+         */
+        inline static
+        void
+        rate_file(const std::string & p_input_name
+                 ,const std::string & p_output_name
+                 ,unsigned int p_nb_threads = 0
+                 );
+
+        static constexpr unsigned int m_checks_per_round = 3;
+
+    private:
+
+        [[nodiscard]] inline
+        bool
+        is_solved(const std::vector<unsigned int> & p_criteria) const;
+
+        inline
+        void
+        split(const std::vector<unsigned int> & p_criteria
+             ,unsigned int p_code_index
+             ,unsigned int p_checker_index
+             ,std::vector<unsigned int> & p_accepted
+             ,std::vector<unsigned int> & p_rejected
+             ) const;
+
+        /**
+         * Query minimising sum of squares of split sizes
+         * @return code index and checker index
+         */
+        [[nodiscard]] inline
+        std::pair<unsigned int, unsigned int>
+        get_greedy_query(const std::vector<unsigned int> & p_criteria) const;
+
+        /**
+         * Sum over criteria of the number of checks needed by greedy strategy
+         */
+        [[nodiscard]] inline
+        unsigned long long
+        get_greedy_checks(const std::vector<unsigned int> & p_criteria
+                         ,unsigned int p_depth
+                         ) const;
+
+        /**
+         * Codes whose answers differ for all checkers on criteria. Codes
+         * giving exactly the same answers are equivalent so only one is kept
+         */
+        [[nodiscard]] inline
+        std::vector<unsigned int>
+        get_useful_codes(const std::vector<unsigned int> & p_criteria) const;
+
+        [[nodiscard]] inline
+        bool
+        is_solvable(const std::vector<unsigned int> & p_criteria
+                   ,unsigned int p_nb_rounds
+                   );
+
+        [[nodiscard]] inline
+        bool
+        is_round_solvable(const std::vector<unsigned int> & p_criteria
+                         ,unsigned int p_code_index
+                         ,unsigned int p_remaining_checks
+                         ,unsigned int p_nb_rounds
+                         );
+
+        inline static
+        std::vector<unsigned int>
+        parse_ids(const std::string & p_line);
+
+        const criteria_space & m_space;
+
+        /**
+         * Distinct queries of each checker: bitfield of conditions accepting
+         * a code and first code with this bitfield. Other codes with same
+         * bitfield split criteria the same way
+         */
+        std::vector<std::vector<std::pair<uint16_t, unsigned int>>> m_queries;
+
+        unsigned long long m_node_budget;
+
+        unsigned long long m_nb_nodes;
+    };
+
+    //-------------------------------------------------------------------------
+    difficulty_rater::difficulty_rater(const criteria_space & p_space
+                                      ,unsigned long long p_node_budget
+                                      )
+    :m_space{p_space}
+    ,m_queries(p_space.get_nb_checkers())
+    ,m_node_budget{p_node_budget}
+    ,m_nb_nodes{0}
+    {
+        if(m_space.get_nb_checkers() > potential_checkers::m_max_checkers)
+        {
+            throw quicky_exception::quicky_logic_exception("Too many checkers " + std::to_string(m_space.get_nb_checkers()), __LINE__, __FILE__);
+        }
+        const condition_table & l_table = m_space.get_table();
+        for(unsigned int l_checker_index = 0; l_checker_index < m_space.get_nb_checkers(); ++l_checker_index)
+        {
+            for(unsigned int l_code_index = 0; l_code_index < condition_table::m_nb_codes; ++l_code_index)
+            {
+                uint16_t l_conditions = 0;
+                for(unsigned int l_condition_index = 0; l_condition_index < l_table.get_grade(l_checker_index); ++l_condition_index)
+                {
+                    if(l_table.get_mask(l_checker_index, l_condition_index).test(l_code_index))
+                    {
+                        l_conditions |= static_cast<uint16_t>(1u << l_condition_index);
+                    }
+                }
+                auto & l_queries = m_queries[l_checker_index];
+                if(l_queries.end() == std::find_if(l_queries.begin(), l_queries.end(), [=](const std::pair<uint16_t, unsigned int> & p_query){return p_query.first == l_conditions;}))
+                {
+                    l_queries.emplace_back(l_conditions, l_code_index);
+                }
+            }
+        }
+    }
+
+    //-------------------------------------------------------------------------
+    bool
+    difficulty_rater::is_solved(const std::vector<unsigned int> & p_criteria) const
+    {
+        for(auto l_index: p_criteria)
+        {
+            if(m_space.get_solution(l_index) != m_space.get_solution(p_criteria.front()))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    //-------------------------------------------------------------------------
+    void
+    difficulty_rater::split(const std::vector<unsigned int> & p_criteria
+                           ,unsigned int p_code_index
+                           ,unsigned int p_checker_index
+                           ,std::vector<unsigned int> & p_accepted
+                           ,std::vector<unsigned int> & p_rejected
+                           ) const
+    {
+        p_accepted.clear();
+        p_rejected.clear();
+        for(auto l_index: p_criteria)
+        {
+            if(m_space.is_accepted(l_index, p_checker_index, p_code_index))
+            {
+                p_accepted.emplace_back(l_index);
+            }
+            else
+            {
+                p_rejected.emplace_back(l_index);
+            }
+        }
+    }
+
+    //-------------------------------------------------------------------------
+    std::pair<unsigned int, unsigned int>
+    difficulty_rater::get_greedy_query(const std::vector<unsigned int> & p_criteria) const
+    {
+        // Answer to a query only depends on condition of queried checker so
+        // criteria are counted per condition of each checker, then number
+        // of accepting criteria of a query is summed over conditions
+        // accepting its code. Only distinct queries are scored, ties are
+        // broken as if all codes were scored in order
+        std::array<unsigned int, potential_checkers::m_max_checkers * potential_checkers::m_max_conditions> l_counts{};
+        for(auto l_index: p_criteria)
+        {
+            const std::vector<unsigned int> & l_criteria = m_space.get_criteria(l_index);
+            for(unsigned int l_checker_index = 0; l_checker_index < m_space.get_nb_checkers(); ++l_checker_index)
+            {
+                ++l_counts[l_checker_index * potential_checkers::m_max_conditions + l_criteria[l_checker_index]];
+            }
+        }
+        std::pair<unsigned int, unsigned int> l_result{0, 0};
+        unsigned long long l_best_score = ~0ull;
+        for(unsigned int l_checker_index = 0; l_checker_index < m_space.get_nb_checkers(); ++l_checker_index)
+        {
+            for(auto [l_conditions, l_code_index]: m_queries[l_checker_index])
+            {
+                unsigned long long l_nb_accepted = 0;
+                for(unsigned int l_remaining = l_conditions; l_remaining; l_remaining &= l_remaining - 1)
+                {
+                    l_nb_accepted += l_counts[l_checker_index * potential_checkers::m_max_conditions + static_cast<unsigned int>(std::countr_zero(l_remaining))];
+                }
+                unsigned long long l_nb_rejected = p_criteria.size() - l_nb_accepted;
+                if(!l_nb_accepted || !l_nb_rejected)
+                {
+                    continue;
+                }
+                unsigned long long l_score = l_nb_accepted * l_nb_accepted + l_nb_rejected * l_nb_rejected;
+                std::pair<unsigned int, unsigned int> l_query{l_code_index, l_checker_index};
+                if(l_score < l_best_score || (l_score == l_best_score && l_query < l_result))
+                {
+                    l_best_score = l_score;
+                    l_result = l_query;
+                }
+            }
+        }
+        // Criteria with different solutions can always be distinguished by
+        // proposing one of the solutions
+        assert(l_best_score != ~0ull);
+        return l_result;
+    }
+
+    //-------------------------------------------------------------------------
+    unsigned long long
+    difficulty_rater::get_greedy_checks(const std::vector<unsigned int> & p_criteria
+                                       ,unsigned int p_depth
+                                       ) const
+    {
+        if(is_solved(p_criteria))
+        {
+            return p_depth * p_criteria.size();
+        }
+        auto [l_code_index, l_checker_index] = get_greedy_query(p_criteria);
+        std::vector<unsigned int> l_accepted;
+        std::vector<unsigned int> l_rejected;
+        split(p_criteria, l_code_index, l_checker_index, l_accepted, l_rejected);
+        return get_greedy_checks(l_accepted, p_depth + 1) + get_greedy_checks(l_rejected, p_depth + 1);
+    }
+
+    //-------------------------------------------------------------------------
+    double
+    difficulty_rater::get_greedy_expected_checks() const
+    {
+        if(!m_space.get_nb_criteria())
+        {
+            return 0;
+        }
+        return static_cast<double>(get_greedy_checks(m_space.get_all_indexes(), 0)) / m_space.get_nb_criteria();
+    }
+
+    //-------------------------------------------------------------------------
+    std::vector<unsigned int>
+    difficulty_rater::get_useful_codes(const std::vector<unsigned int> & p_criteria) const
+    {
+        std::vector<unsigned int> l_result;
+        std::set<std::vector<bool>> l_answers;
+        for(unsigned int l_code_index = 0; l_code_index < condition_table::m_nb_codes; ++l_code_index)
+        {
+            std::vector<bool> l_code_answers;
+            for(unsigned int l_checker_index = 0; l_checker_index < m_space.get_nb_checkers(); ++l_checker_index)
+            {
+                for(auto l_index: p_criteria)
+                {
+                    l_code_answers.emplace_back(m_space.is_accepted(l_index, l_checker_index, l_code_index));
+                }
+            }
+            if(l_answers.insert(std::move(l_code_answers)).second)
+            {
+                l_result.emplace_back(l_code_index);
+            }
+        }
+        return l_result;
+    }
+
+    //-------------------------------------------------------------------------
+    bool
+    difficulty_rater::is_solvable(const std::vector<unsigned int> & p_criteria
+                                 ,unsigned int p_nb_rounds
+                                 )
+    {
+        if(++m_nb_nodes > m_node_budget)
+        {
+            return false;
+        }
+        if(is_solved(p_criteria))
+        {
+            return true;
+        }
+        // Each round splits criteria in at most 2^3 groups
+        size_t l_max_solutions = 1;
+        for(unsigned int l_round = 0; l_round < p_nb_rounds && l_max_solutions < p_criteria.size(); ++l_round)
+        {
+            l_max_solutions <<= m_checks_per_round;
+        }
+        if(m_space.get_solutions(p_criteria).count() > l_max_solutions)
+        {
+            return false;
+        }
+        for(auto l_code_index: get_useful_codes(p_criteria))
+        {
+            if(is_round_solvable(p_criteria, l_code_index, m_checks_per_round, p_nb_rounds))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    //-------------------------------------------------------------------------
+    bool
+    difficulty_rater::is_round_solvable(const std::vector<unsigned int> & p_criteria
+                                       ,unsigned int p_code_index
+                                       ,unsigned int p_remaining_checks
+                                       ,unsigned int p_nb_rounds
+                                       )
+    {
+        if(++m_nb_nodes > m_node_budget)
+        {
+            return false;
+        }
+        if(is_solved(p_criteria))
+        {
+            return true;
+        }
+        if(!p_remaining_checks)
+        {
+            return is_solvable(p_criteria, p_nb_rounds - 1);
+        }
+        // An informative check never makes things worse than starting
+        // next round so stopping the round is only considered when no
+        // check is informative
+        bool l_informative = false;
+        std::vector<unsigned int> l_accepted;
+        std::vector<unsigned int> l_rejected;
+        for(unsigned int l_checker_index = 0; l_checker_index < m_space.get_nb_checkers(); ++l_checker_index)
+        {
+            split(p_criteria, p_code_index, l_checker_index, l_accepted, l_rejected);
+            if(l_accepted.empty() || l_rejected.empty())
+            {
+                continue;
+            }
+            l_informative = true;
+            if(is_round_solvable(l_accepted, p_code_index, p_remaining_checks - 1, p_nb_rounds)
+            && is_round_solvable(l_rejected, p_code_index, p_remaining_checks - 1, p_nb_rounds)
+              )
+            {
+                return true;
+            }
+        }
+        return !l_informative && is_solvable(p_criteria, p_nb_rounds - 1);
+    }
+
+    //-------------------------------------------------------------------------
+    std::pair<unsigned int, bool>
+    difficulty_rater::get_optimal_worst_rounds()
+    {
+        m_nb_nodes = 0;
+        if(!m_space.get_nb_criteria())
+        {
+            return {0, true};
+        }
+        std::vector<unsigned int> l_criteria = m_space.get_all_indexes();
+        unsigned int l_nb_rounds = 0;
+        while(!is_solvable(l_criteria, l_nb_rounds))
+        {
+            if(m_nb_nodes > m_node_budget)
+            {
+                return {l_nb_rounds, false};
+            }
+            ++l_nb_rounds;
+        }
+        return {l_nb_rounds, true};
+    }
+
+    //-------------------------------------------------------------------------
+    std::vector<unsigned int>
+    difficulty_rater::parse_ids(const std::string & p_line)
+    {
+        std::string l_line{p_line};
+        for(auto & l_char: l_line)
+        {
+            if(',' == l_char || ';' == l_char || '\t' == l_char)
+            {
+                l_char = ' ';
+            }
+        }
+        std::stringstream l_stream{l_line};
+        std::vector<unsigned int> l_result;
+        unsigned int l_id;
+        while(l_stream >> l_id)
+        {
+            l_result.emplace_back(l_id);
+        }
+        if(!l_stream.eof())
+        {
+            throw quicky_exception::quicky_logic_exception("Invalid checker list \"" + p_line + "\"", __LINE__, __FILE__);
+        }
+        return l_result;
+    }
+
+    //-------------------------------------------------------------------------
+    void
+    difficulty_rater::rate_file(const std::string & p_input_name
+                               ,const std::string & p_output_name
+                               ,unsigned int p_nb_threads
+                               )
+    {
+        std::ifstream l_input_file{p_input_name};
+        if(!l_input_file.is_open())
+        {
+            throw quicky_exception::quicky_runtime_exception("Unable to open " + p_input_name, __LINE__, __FILE__);
+        }
+        std::vector<std::string> l_lines;
+        std::string l_line;
+        while(std::getline(l_input_file, l_line))
+        {
+            l_lines.emplace_back(l_line);
+        }
+
+        // Read checkpoint: every complete line of output file starts with
+        // the index of rated input line. Incomplete last line is dropped
+        std::set<size_t> l_done;
+        bool l_to_stdout = "-" == p_output_name;
+        if(!l_to_stdout && std::filesystem::exists(p_output_name))
+        {
+            std::ifstream l_output_file{p_output_name};
+            std::uintmax_t l_complete_size = 0;
+            std::uintmax_t l_size = 0;
+            while(std::getline(l_output_file, l_line))
+            {
+                l_size += l_line.size() + 1;
+                if(l_output_file.eof())
+                {
+                    break;
+                }
+                l_complete_size = l_size;
+                size_t l_index;
+                if(std::stringstream{l_line} >> l_index)
+                {
+                    l_done.insert(l_index);
+                }
+            }
+            l_output_file.close();
+            std::filesystem::resize_file(p_output_name, l_complete_size);
+        }
+
+        std::vector<size_t> l_tasks;
+        for(size_t l_index = 0; l_index < l_lines.size(); ++l_index)
+        {
+            if(!l_done.contains(l_index) && l_lines[l_index].find_first_not_of(" \t\r") != std::string::npos && '#' != l_lines[l_index][l_lines[l_index].find_first_not_of(" \t\r")])
+            {
+                l_tasks.emplace_back(l_index);
+            }
+        }
+        std::cout << l_done.size() << " checker lists already rated, " << l_tasks.size() << " to rate" << std::endl;
+
+        std::ofstream l_output_file;
+        if(!l_to_stdout)
+        {
+            l_output_file.open(p_output_name, std::ios::app);
+            if(!l_output_file.is_open())
+            {
+                throw quicky_exception::quicky_runtime_exception("Unable to open " + p_output_name, __LINE__, __FILE__);
+            }
+        }
+        std::ostream & l_output = l_to_stdout ? std::cout : l_output_file;
+        std::mutex l_output_mutex;
+        work_stealing_pool l_pool{p_nb_threads};
+        l_pool.run(l_tasks, [&](size_t p_index, unsigned int)
+        {
+            std::stringstream l_result;
+            l_result << p_index << " ";
+            try
+            {
+                std::vector<unsigned int> l_ids = parse_ids(l_lines[p_index]);
+                std::vector<std::shared_ptr<checker_if>> l_checkers;
+                for(unsigned int l_id_index = 0; l_id_index < l_ids.size(); ++l_id_index)
+                {
+                    l_checkers.emplace_back(solver::get_checker(l_ids[l_id_index]));
+                    l_result << (l_id_index ? "," : "") << l_ids[l_id_index];
+                }
+                criteria_space l_space{l_checkers};
+                difficulty_rater l_rater{l_space};
+                auto [l_nb_rounds, l_exact] = l_rater.get_optimal_worst_rounds();
+                // Same count as the one displayed when a game starts
+                l_result << " " << solver{l_ids, false}.get_remaining_candidates();
+                l_result << " " << (l_exact ? "" : ">=") << l_nb_rounds;
+                l_result << " " << std::fixed << std::setprecision(3) << l_rater.get_greedy_expected_checks();
+            }
+            catch(quicky_exception::quicky_logic_exception & e)
+            {
+                l_result << " ERROR " << e.what();
+            }
+            std::lock_guard<std::mutex> l_lock(l_output_mutex);
+            l_output << l_result.str() << std::endl;
+        });
+        std::cout << l_tasks.size() << " checker lists rated" << std::endl;
+    }
+}
+#endif //TURING_MACHINE_SOLVER_DIFFICULTY_RATER_H
+// EOF
@@ -0,0 +1,512 @@
+/*    This file is part of turing_machine_solver
+      Copyright (C) 2024  Julien Thevenon ( julien_thevenon at yahoo.fr )
+
+      This program is free software: you can redistribute it and/or modify
+      it under the terms of the GNU General Public License as published by
+      the Free Software Foundation, either version 3 of the License, or
+      (at your option) any later version.
+
+      This program is distributed in the hope that it will be useful,
+      but WITHOUT ANY WARRANTY; without even the implied warranty of
+      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+      GNU General Public License for more details.
+
+      You should have received a copy of the GNU General Public License
+      along with this program.  If not, see <http://www.gnu.org/licenses/>
+*/
+
+#ifndef TURING_MACHINE_SOLVER_GAME_RUNNER_H
+#define TURING_MACHINE_SOLVER_GAME_RUNNER_H
+
+#include "solver.h"
+#include "script_reader.h"
+#include "solver_cache.h"
+#include "contradiction_detector.h"
+#include "answer_history.h"
+#include "work_stealing_pool.h"
+#include "quicky_exception.h"
+#include <string>
+#include <tuple>
+#include <vector>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <ostream>
+#include <optional>
+
+namespace turing_machine_solver
+{
+    /**
+     * Outcome of a scripted game
+     */
+    class game_result
+    {
+        friend std::ostream & operator<<(std::ostream &, const game_result & );
+
+    public:
+
+        enum class status {SOLVED, INCOMPLETE, ERROR};
+
+        inline
+        game_result(status p_status
+                   ,std::string p_details
+                   ,unsigned int p_nb_remaining
+                   ,unsigned int p_nb_steps
+                   ,std::chrono::microseconds p_duration
+                   ,unsigned int p_solution = 0
+                   );
+
+        [[nodiscard]] inline
+        status
+        get_status() const;
+
+        /**
+         * Solution in 3 digits format, 0 if game is not solved
+         */
+        [[nodiscard]] inline
+        unsigned int
+        get_solution() const;
+
+        /**
+         * Solution and its checker conditions when solved, error message
+         * in case of error
+         */
+        [[nodiscard]] inline
+        const std::string &
+        get_details() const;
+
+        [[nodiscard]] inline
+        unsigned int
+        get_nb_remaining() const;
+
+        /**
+         * Number of checker results analyzed
+         */
+        [[nodiscard]] inline
+        unsigned int
+        get_nb_steps() const;
+
+        [[nodiscard]] inline
+        std::chrono::microseconds
+        get_duration() const;
+
+    private:
+        status m_status;
+
+        std::string m_details;
+
+        unsigned int m_nb_remaining;
+
+        unsigned int m_nb_steps;
+
+        std::chrono::microseconds m_duration;
+
+        unsigned int m_solution;
+    };
+
+    /**
+     * Play games described by scripts using the comma token format of ask,
+     * following the same sequence of questions as interactive mode but
+     * without any display
+     */
+    class game_runner
+    {
+    public:
+
+        /**
+         * Play a scripted game, a script ending before solution at any
+         * point gives an incomplete game. Rollback tokens are played like
+         * in interactive mode
+         * @param p_script comma separated tokens
+         * @param p_cache cache of initial solvers, if null solver is built
+         * @return game outcome
+         */
+        [[nodiscard]] inline static
+        game_result
+        run(std::string_view p_script
+           ,solver_cache * p_cache = nullptr
+           );
+
+        /**
+         * Play all games of a file, one script per line, on a thread pool
+         * and write one result line per game in input order
+         * @param p_input_name name of input file
+         * @param p_output output stream
+         * @param p_nb_threads number of threads, 0 means hardware concurrency
+         * @param p_cache_name warm file of solver cache, loaded before games
+         * and saved after them if not empty
+         */
+        inline static
+        void
+        run_file(const std::string & p_input_name
+                ,std::ostream & p_output
+                ,unsigned int p_nb_threads = 0
+                ,const std::string & p_cache_name = ""
+                );
+
+        /**
+         * Checker ids and (code, checker index, result) checks of a script,
+         * following question sequence of run, without rolled back checks
+         */
+        [[nodiscard]] inline static
+        std::pair<std::vector<unsigned int>, std::vector<std::tuple<unsigned int, unsigned int, bool>>>
+        parse_checks(std::string_view p_script);
+
+        static constexpr size_t m_cache_memory_cap = 256 * 1024 * 1024;
+
+    private:
+
+        /**
+         * Handle a rollback token like interactive mode does: if answers
+         * conflict, set number is read from script and its answers removed.
+         * Nothing is read once rollback is disabled
+         * @param p_reader script positioned after rollback token
+         * @param p_history answers of game
+         * @return true if answers have been removed, nullopt if script ends
+         * before set number
+         */
+        [[nodiscard]] inline static
+        std::optional<bool>
+        read_rollback(script_reader & p_reader
+                     ,answer_history & p_history
+                     );
+    };
+
+    //-------------------------------------------------------------------------
+    game_result::game_result(status p_status
+                            ,std::string p_details
+                            ,unsigned int p_nb_remaining
+                            ,unsigned int p_nb_steps
+                            ,std::chrono::microseconds p_duration
+                            ,unsigned int p_solution
+                            )
+    :m_status{p_status}
+    ,m_details{std::move(p_details)}
+    ,m_nb_remaining{p_nb_remaining}
+    ,m_nb_steps{p_nb_steps}
+    ,m_duration{p_duration}
+    ,m_solution{p_solution}
+    {
+    }
+
+    //-------------------------------------------------------------------------
+    game_result::status
+    game_result::get_status() const
+    {
+        return m_status;
+    }
+
+    //-------------------------------------------------------------------------
+    unsigned int
+    game_result::get_solution() const
+    {
+        return m_solution;
+    }
+
+    //-------------------------------------------------------------------------
+    const std::string &
+    game_result::get_details() const
+    {
+        return m_details;
+    }
+
+    //-------------------------------------------------------------------------
+    unsigned int
+    game_result::get_nb_remaining() const
+    {
+        return m_nb_remaining;
+    }
+
+    //-------------------------------------------------------------------------
+    unsigned int
+    game_result::get_nb_steps() const
+    {
+        return m_nb_steps;
+    }
+
+    //-------------------------------------------------------------------------
+    std::chrono::microseconds
+    game_result::get_duration() const
+    {
+        return m_duration;
+    }
+
+    //-------------------------------------------------------------------------
+    std::ostream & operator<<(std::ostream & p_stream, const game_result & p_result)
+    {
+        switch(p_result.get_status())
+        {
+            case game_result::status::SOLVED:
+                p_stream << "SOLVED " << p_result.get_details();
+                break;
+            case game_result::status::INCOMPLETE:
+                p_stream << "INCOMPLETE " << p_result.get_nb_remaining() << " candidates";
+                break;
+            case game_result::status::ERROR:
+                p_stream << "ERROR " << p_result.get_details();
+                break;
+        }
+        p_stream << " steps=" << p_result.get_nb_steps() << " time=" << p_result.get_duration().count() << "us";
+        return p_stream;
+    }
+
+    //-------------------------------------------------------------------------
+    std::pair<std::vector<unsigned int>, std::vector<std::tuple<unsigned int, unsigned int, bool>>>
+    game_runner::parse_checks(std::string_view p_script)
+    {
+        script_reader l_reader{p_script};
+        std::vector<unsigned int> l_ids(l_reader.next<unsigned int>());
+        for(auto & l_id: l_ids)
+        {
+            l_id = l_reader.next<unsigned int>();
+        }
+        // Rolled back answers are not part of checks
+        answer_history l_history{solver{l_ids, false}, l_ids};
+        while(!l_reader.is_empty())
+        {
+            int l_code = l_reader.next<int>();
+            if(contradiction_detector::m_rollback_index == l_code)
+            {
+                if(!read_rollback(l_reader, l_history))
+                {
+                    break;
+                }
+                continue;
+            }
+            l_history.start_round(condition_table::code_index(candidate{static_cast<unsigned int>(l_code)}));
+            for(unsigned int l_nb_checks = 0; l_nb_checks < 3 && !l_reader.is_empty(); )
+            {
+                int l_checker_index = l_reader.next<int>();
+                if(-1 == l_checker_index)
+                {
+                    break;
+                }
+                if(contradiction_detector::m_rollback_index == l_checker_index)
+                {
+                    if(!read_rollback(l_reader, l_history))
+                    {
+                        break;
+                    }
+                    continue;
+                }
+                l_history.add(static_cast<unsigned int>(l_checker_index), static_cast<bool>(l_reader.next<unsigned int>()));
+                ++l_nb_checks;
+            }
+            l_history.end_round();
+        }
+        std::vector<std::tuple<unsigned int, unsigned int, bool>> l_checks;
+        for(const auto & l_answer: l_history.get_answers())
+        {
+            candidate l_candidate = condition_table::index_code(l_answer.m_code_index);
+            l_checks.emplace_back(100 * l_candidate.get_blue_triangle() + 10 * l_candidate.get_yellow_square() + l_candidate.get_purple_circle(), l_answer.m_checker_index, l_answer.m_result);
+        }
+        return {l_ids, l_checks};
+    }
+
+    //-------------------------------------------------------------------------
+    game_result
+    game_runner::run(std::string_view p_script
+                    ,solver_cache * p_cache
+                    )
+    {
+        auto l_start = std::chrono::steady_clock::now();
+        auto l_duration = [&]()
+        {
+            return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - l_start);
+        };
+        script_reader l_reader{p_script};
+        unsigned int l_nb_steps = 0;
+        unsigned int l_nb_remaining = 0;
+        // Script ending at any point is an incomplete game
+        auto l_incomplete = [&]() -> game_result
+        {
+            return {game_result::status::INCOMPLETE, "", l_nb_remaining, l_nb_steps, l_duration()};
+        };
+        try
+        {
+            if(l_reader.is_empty())
+            {
+                return l_incomplete();
+            }
+            auto l_nb_checkers = l_reader.next<unsigned int>();
+            std::vector<unsigned int> l_checkers_id;
+            while(l_checkers_id.size() < l_nb_checkers)
+            {
+                if(l_reader.is_empty())
+                {
+                    return l_incomplete();
+                }
+                l_checkers_id.emplace_back(l_reader.next<unsigned int>());
+            }
+            auto l_initial_solver = [&]()
+            {
+                return p_cache ? p_cache->get(l_checkers_id) : solver{l_checkers_id, false};
+            };
+            solver l_solver{l_initial_solver()};
+            l_nb_remaining = l_solver.get_remaining_candidates();
+            // Answers are recorded to replay rollback tokens like interactive mode
+            answer_history l_history{l_solver, l_checkers_id};
+            do
+            {
+                if(l_reader.is_empty())
+                {
+                    return l_incomplete();
+                }
+                int l_candidate_num = l_reader.next<int>();
+                // Rollback token is accepted in place of a candidate too
+                if(contradiction_detector::m_rollback_index == l_candidate_num)
+                {
+                    std::optional<bool> l_removed = read_rollback(l_reader, l_history);
+                    if(!l_removed)
+                    {
+                        return l_incomplete();
+                    }
+                    if(*l_removed)
+                    {
+                        (void)l_history.replay(l_solver);
+                        l_nb_remaining = l_solver.get_remaining_candidates();
+                    }
+                    continue;
+                }
+                candidate l_candidate{static_cast<unsigned int>(l_candidate_num)};
+                potential_checkers l_checkers = l_solver.get_related_checkers(l_candidate);
+                l_history.start_round(condition_table::code_index(l_candidate));
+                int l_checker_index;
+                unsigned int l_remaining_check = 3;
+                do
+                {
+                    if(l_reader.is_empty())
+                    {
+                        return l_incomplete();
+                    }
+                    l_checker_index = l_reader.next<int>();
+                    if(contradiction_detector::m_rollback_index == l_checker_index)
+                    {
+                        std::optional<bool> l_removed = read_rollback(l_reader, l_history);
+                        if(!l_removed)
+                        {
+                            return l_incomplete();
+                        }
+                        if(*l_removed)
+                        {
+                            l_checkers = *l_history.replay(l_solver);
+                            l_nb_remaining = l_solver.get_remaining_candidates();
+                        }
+                    }
+                    else if(l_checker_index != -1)
+                    {
+                        if(l_reader.is_empty())
+                        {
+                            return l_incomplete();
+                        }
+                        bool l_result{static_cast<bool>(l_reader.next<unsigned int>())};
+                        --l_remaining_check;
+                        l_solver.analyze_result(l_checkers, static_cast<unsigned int>(l_checker_index), l_result);
+                        ++l_nb_steps;
+                        l_nb_remaining = l_solver.get_remaining_candidates();
+                        l_history.add(static_cast<unsigned int>(l_checker_index), l_result);
+                    }
+                } while(l_remaining_check && l_checker_index != -1 && 1 != l_nb_remaining);
+                l_history.end_round();
+            } while(1 != l_nb_remaining);
+
+            candidate l_solution = condition_table::index_code(condition_table::first_code(l_solver.get_remaining_codes()));
+            std::stringstream l_details;
+            l_details << l_solution << " -> " << l_solver.get_related_checkers(l_solution);
+            unsigned int l_solution_code = 100 * l_solution.get_blue_triangle() + 10 * l_solution.get_yellow_square() + l_solution.get_purple_circle();
+            return {game_result::status::SOLVED, l_details.str(), l_nb_remaining, l_nb_steps, l_duration(), l_solution_code};
+        }
+        catch(quicky_exception::quicky_logic_exception & e)
+        {
+            return {game_result::status::ERROR, e.what(), l_nb_remaining, l_nb_steps, l_duration()};
+        }
+    }
+
+    //-------------------------------------------------------------------------
+    std::optional<bool>
+    game_runner::read_rollback(script_reader & p_reader
+                              ,answer_history & p_history
+                              )
+    {
+        if(!p_history.is_rollback_enabled())
+        {
+            return false;
+        }
+        std::vector<uint64_t> l_conflicts = p_history.get_minimal_conflicts();
+        if(l_conflicts.empty())
+        {
+            return false;
+        }
+        if(p_reader.is_empty())
+        {
+            return std::nullopt;
+        }
+        auto l_choice = p_reader.next<unsigned int>();
+        if(!l_choice || l_choice > l_conflicts.size())
+        {
+            return false;
+        }
+        p_history.remove(l_conflicts[l_choice - 1]);
+        return true;
+    }
+
+    //-------------------------------------------------------------------------
+    void
+    game_runner::run_file(const std::string & p_input_name
+                         ,std::ostream & p_output
+                         ,unsigned int p_nb_threads
+                         ,const std::string & p_cache_name
+                         )
+    {
+        std::ifstream l_input_file{p_input_name};
+        if(!l_input_file.is_open())
+        {
+            throw quicky_exception::quicky_runtime_exception("Unable to open " + p_input_name, __LINE__, __FILE__);
+        }
+        std::vector<std::string> l_scripts;
+        std::string l_line;
+        while(std::getline(l_input_file, l_line))
+        {
+            l_scripts.emplace_back(l_line);
+        }
+        std::vector<std::string> l_results(l_scripts.size());
+        solver_cache l_cache{m_cache_memory_cap};
+        if(!p_cache_name.empty())
+        {
+            l_cache.load(p_cache_name, p_nb_threads);
+        }
+        work_stealing_pool l_pool{p_nb_threads};
+        auto l_start = std::chrono::steady_clock::now();
+        l_pool.run(l_scripts.size()
+                  ,[&](size_t p_index, unsigned int)
+                   {
+                       if(l_scripts[p_index].empty())
+                       {
+                           return;
+                       }
+                       std::stringstream l_stream;
+                       l_stream << p_index << " " << run(l_scripts[p_index], &l_cache);
+                       l_results[p_index] = l_stream.str();
+                   }
+                  );
+        auto l_duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - l_start);
+        std::string l_output;
+        for(const auto & l_result: l_results)
+        {
+            if(!l_result.empty())
+            {
+                l_output += l_result;
+                l_output += '\n';
+            }
+        }
+        p_output << l_output;
+        p_output << l_scripts.size() << " games played in " << l_duration.count() << "ms with " << l_pool.get_nb_threads() << " threads" << std::endl;
+        p_output << "Solver cache: " << l_cache.get_nb_hits() << " hits, " << l_cache.get_nb_misses() << " misses, " << l_cache.get_nb_entries() << " entries" << std::endl;
+        if(!p_cache_name.empty())
+        {
+            l_cache.save(p_cache_name);
+        }
+    }
+}
+#endif //TURING_MACHINE_SOLVER_GAME_RUNNER_H
+// EOF
@@ -0,0 +1,729 @@
+/*    This file is part of turing_machine_solver
+      Copyright (C) 2024  Julien Thevenon ( julien_thevenon at yahoo.fr )
+
+      This program is free software: you can redistribute it and/or modify
+      it under the terms of the GNU General Public License as published by
+      the Free Software Foundation, either version 3 of the License, or
+      (at your option) any later version.
+
+      This program is distributed in the hope that it will be useful,
+      but WITHOUT ANY WARRANTY; without even the implied warranty of
+      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+      GNU General Public License for more details.
+
+      You should have received a copy of the GNU General Public License
+      along with this program.  If not, see <http://www.gnu.org/licenses/>
+*/
+
+#ifndef TURING_MACHINE_SOLVER_GAME_SERVER_H
+#define TURING_MACHINE_SOLVER_GAME_SERVER_H
+
+#include "solver.h"
+#include "solver_cache.h"
+#include "criteria_space.h"
+#include "planner.h"
+#include "suggestion_cache.h"
+#include "script_reader.h"
+#include "request_pool.h"
+#include "quicky_exception.h"
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <string_view>
+#include <sstream>
+#include <chrono>
+#include <iostream>
+#include <cstring>
+#include <cerrno>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <poll.h>
+#include <unistd.h>
+
+namespace turing_machine_solver
+{
+    /**
+     * State of a game hosted by server. Methods can be called concurrently,
+     * operations on the same session are serialised
+     */
+    class game_session
+    {
+    public:
+        inline
+        game_session(std::vector<unsigned int> p_checkers_id
+                    ,solver p_solver
+                    ,std::shared_ptr<const criteria_space> p_space
+                    );
+
+        game_session(const game_session &) = delete;
+
+        game_session &
+        operator=(const game_session &) = delete;
+
+        /**
+         * Analyze checker answer for a code
+         * @param p_code code in 3 digits format
+         * @param p_checker_index index of checker
+         * @param p_result checker answer
+         * @return number of remaining candidates
+         */
+        inline
+        unsigned int
+        apply(unsigned int p_code
+             ,unsigned int p_checker_index
+             ,bool p_result
+             );
+
+        /**
+         * Suggestion of shared cache, computed within budget if missing or
+         * if cached one is not exact and had a much smaller budget
+         */
+        [[nodiscard]] inline
+        cached_suggestion
+        suggest(std::chrono::microseconds p_budget);
+
+        /**
+         * Write number of remaining candidates and solution if it is found
+         */
+        inline
+        void
+        print_state(std::ostream & p_stream) const;
+
+        /**
+         * Last access through server, which must be locked
+         */
+        [[nodiscard]] inline
+        std::chrono::steady_clock::time_point
+        get_last_activity() const;
+
+        inline
+        void
+        touch();
+
+    private:
+        mutable std::mutex m_mutex;
+
+        std::vector<unsigned int> m_checkers_id;
+
+        solver m_solver;
+
+        std::shared_ptr<const criteria_space> m_space;
+
+        std::vector<unsigned int> m_criteria;
+
+        planner m_planner;
+
+        std::chrono::steady_clock::time_point m_last_activity;
+    };
+
+    /**
+     * Host game sessions, answering one line requests by one line responses.
+     * Sessions are identified by random tokens so that a client cannot use
+     * games of others. Request is a command followed by comma separated
+     * arguments:
+     * - create <checker ids>           -> OK <session> <remaining candidates>
+     * - apply <session>,<code>,<checker index>,<result> -> OK <remaining candidates>
+     * - suggest <session>              -> OK <code> <checker index> <expected criteria>
+     * - state <session>                -> OK <remaining candidates> [<solution> -> <conditions>]
+     * - close <session>                -> OK
+     * - cache                          -> OK <entries> <hits> <misses> <evictions> <upgrades> <hit rate>
+     * Errors are reported as ERROR <message>. Sessions share the checker
+     * registry, a cache of initial solvers and criteria spaces of identical
+     * checker lists and the process cache of suggestions of identical
+     * states. Sessions inactive for longer than timeout are closed.
+     * Requests can be handled concurrently, solvers, criteria spaces and
+     * suggestions being computed without server lock
+     */
+    class game_server
+    {
+    public:
+
+        /**
+         * @param p_timeout inactivity duration after which a session is closed
+         * @param p_suggest_budget time budget of a suggestion
+         * @param p_max_sessions maximal number of simultaneous sessions
+         */
+        inline explicit
+        game_server(std::chrono::seconds p_timeout = std::chrono::seconds(600)
+                   ,std::chrono::microseconds p_suggest_budget = std::chrono::microseconds(1000)
+                   ,size_t p_max_sessions = 10000
+                   );
+
+        /**
+         * Process a request
+         * @param p_request request line without end of line
+         * @return response line without end of line
+         */
+        [[nodiscard]] inline
+        std::string
+        handle(std::string_view p_request);
+
+        /**
+         * Close inactive sessions
+         */
+        inline
+        void
+        expire();
+
+        [[nodiscard]] inline
+        size_t
+        get_nb_sessions() const;
+
+        /**
+         * Serve requests read line by line from a stream until its end
+         */
+        inline
+        void
+        serve(std::istream & p_input
+             ,std::ostream & p_output
+             );
+
+        /**
+         * Serve clients connected to a Unix domain socket. Never returns.
+         * Poll loop only does non blocking I/O, requests are handled by a
+         * request_pool. Requests of a client are handled one at a time so
+         * its responses keep request order
+         * @param p_socket_name path of socket, replaced if it exists
+         * @param p_nb_threads number of threads handling requests, 0 means
+         * hardware concurrency
+         */
+        inline
+        void
+        serve(const std::string & p_socket_name
+             ,unsigned int p_nb_threads = 0
+             );
+
+        static constexpr size_t m_max_request_size = 4096;
+
+        /**
+         * Size of pending responses above which requests of a client are no
+         * longer read, so a client not reading its responses is throttled
+         */
+        static constexpr size_t m_max_output_size = 64 * 1024;
+
+        static constexpr unsigned int m_max_checkers = 6;
+
+    private:
+
+        [[nodiscard]] inline
+        std::string
+        process(std::string_view p_command
+               ,script_reader & p_reader
+               );
+
+        /**
+         * Session of a token, its activity is updated
+         */
+        [[nodiscard]] inline
+        std::shared_ptr<game_session>
+        get_session(uint64_t p_id);
+
+        /**
+         * Connection of serve, bytes are queued in both directions
+         */
+        class connection
+        {
+        public:
+            int m_fd;
+
+            std::string m_input;
+
+            std::string m_output;
+
+            /**
+             * A request is being handled by request_pool
+             */
+            bool m_busy;
+
+            /**
+             * Client has shut down writing, connection is closed once
+             * remaining requests are answered
+             */
+            bool m_end_of_input;
+        };
+
+        /**
+         * Read available bytes
+         * @return false if connection must be closed
+         */
+        [[nodiscard]] inline static
+        bool
+        receive(connection & p_connection);
+
+        /**
+         * Write queued bytes until socket buffer is full
+         * @return false if connection must be closed
+         */
+        [[nodiscard]] inline static
+        bool
+        flush(connection & p_connection);
+
+        std::chrono::seconds m_timeout;
+
+        std::chrono::microseconds m_suggest_budget;
+
+        size_t m_max_sessions;
+
+        /**
+         * Protect sessions, criteria spaces and token generator
+         */
+        mutable std::mutex m_mutex;
+
+        std::random_device m_random_device;
+
+        std::map<uint64_t, std::shared_ptr<game_session>> m_sessions;
+
+        solver_cache m_solver_cache;
+
+        std::map<std::vector<unsigned int>, std::weak_ptr<const criteria_space>> m_spaces;
+    };
+
+    //-------------------------------------------------------------------------
+    game_session::game_session(std::vector<unsigned int> p_checkers_id
+                              ,solver p_solver
+                              ,std::shared_ptr<const criteria_space> p_space
+                              )
+    :m_checkers_id{std::move(p_checkers_id)}
+    ,m_solver{std::move(p_solver)}
+    ,m_space{std::move(p_space)}
+    ,m_criteria{m_space->get_all_indexes()}
+    ,m_planner{*m_space}
+    ,m_last_activity{std::chrono::steady_clock::now()}
+    {
+    }
+
+    //-------------------------------------------------------------------------
+    unsigned int
+    game_session::apply(unsigned int p_code
+                       ,unsigned int p_checker_index
+                       ,bool p_result
+                       )
+    {
+        std::lock_guard<std::mutex> l_lock{m_mutex};
+        if(p_checker_index >= m_space->get_nb_checkers())
+        {
+            throw quicky_exception::quicky_logic_exception("Bad checker index " + std::to_string(p_checker_index), __LINE__, __FILE__);
+        }
+        candidate l_candidate{p_code};
+        m_solver.analyze_result(l_candidate, p_checker_index, p_result);
+        m_planner.filter(m_criteria, condition_table::code_index(l_candidate), p_checker_index, p_result);
+        return m_solver.get_remaining_candidates();
+    }
+
+    //-------------------------------------------------------------------------
+    cached_suggestion
+    game_session::suggest(std::chrono::microseconds p_budget)
+    {
+        std::lock_guard<std::mutex> l_lock{m_mutex};
+        if(m_criteria.empty())
+        {
+            throw quicky_exception::quicky_logic_exception("No criteria compatible with answers", __LINE__, __FILE__);
+        }
+        return suggestion_cache::get_shared().suggest(m_planner, m_checkers_id, m_criteria, p_budget, m_solver.get_remaining_codes());
+    }
+
+    //-------------------------------------------------------------------------
+    void
+    game_session::print_state(std::ostream & p_stream) const
+    {
+        std::lock_guard<std::mutex> l_lock{m_mutex};
+        p_stream << m_solver.get_remaining_candidates();
+        if(1 == m_solver.get_remaining_candidates())
+        {
+            candidate l_solution = condition_table::index_code(condition_table::first_code(m_solver.get_remaining_codes()));
+            p_stream << " " << l_solution << " -> " << m_solver.get_related_checkers(l_solution);
+        }
+    }
+
+    //-------------------------------------------------------------------------
+    std::chrono::steady_clock::time_point
+    game_session::get_last_activity() const
+    {
+        return m_last_activity;
+    }
+
+    //-------------------------------------------------------------------------
+    void
+    game_session::touch()
+    {
+        m_last_activity = std::chrono::steady_clock::now();
+    }
+
+    //-------------------------------------------------------------------------
+    game_server::game_server(std::chrono::seconds p_timeout
+                            ,std::chrono::microseconds p_suggest_budget
+                            ,size_t p_max_sessions
+                            )
+    :m_timeout{p_timeout}
+    ,m_suggest_budget{p_suggest_budget}
+    ,m_max_sessions{p_max_sessions}
+    ,m_solver_cache{64 * 1024 * 1024}
+    {
+    }
+
+    //-------------------------------------------------------------------------
+    std::shared_ptr<game_session>
+    game_server::get_session(uint64_t p_id)
+    {
+        std::lock_guard<std::mutex> l_lock{m_mutex};
+        auto l_iter = m_sessions.find(p_id);
+        if(m_sessions.end() == l_iter)
+        {
+            throw quicky_exception::quicky_logic_exception("Unknown session " + std::to_string(p_id), __LINE__, __FILE__);
+        }
+        l_iter->second->touch();
+        return l_iter->second;
+    }
+
+    //-------------------------------------------------------------------------
+    std::string
+    game_server::handle(std::string_view p_request)
+    {
+        while(!p_request.empty() && ('\r' == p_request.back() || ' ' == p_request.back()))
+        {
+            p_request.remove_suffix(1);
+        }
+        size_t l_separator = p_request.find(' ');
+        std::string_view l_command = p_request.substr(0, l_separator);
+        script_reader l_reader{std::string_view::npos == l_separator ? std::string_view{} : p_request.substr(l_separator + 1)};
+        try
+        {
+            return process(l_command, l_reader);
+        }
+        catch(quicky_exception::quicky_logic_exception & e)
+        {
+            return std::string("ERROR ") + e.what();
+        }
+        catch(std::exception & e)
+        {
+            return std::string("ERROR ") + e.what();
+        }
+    }
+
+    //-------------------------------------------------------------------------
+    std::string
+    game_server::process(std::string_view p_command
+                        ,script_reader & p_reader
+                        )
+    {
+        std::stringstream l_response;
+        l_response << "OK";
+        if("create" == p_command)
+        {
+            if(get_nb_sessions() >= m_max_sessions)
+            {
+                expire();
+            }
+            std::vector<unsigned int> l_checkers_id;
+            while(!p_reader.is_empty())
+            {
+                l_checkers_id.emplace_back(p_reader.next<unsigned int>());
+            }
+            if(l_checkers_id.empty() || l_checkers_id.size() > m_max_checkers)
+            {
+                throw quicky_exception::quicky_logic_exception("Bad number of checkers " + std::to_string(l_checkers_id.size()), __LINE__, __FILE__);
+            }
+            std::shared_ptr<const criteria_space> l_space;
+            {
+                std::lock_guard<std::mutex> l_lock{m_mutex};
+                if(auto l_iter = m_spaces.find(l_checkers_id); m_spaces.end() != l_iter)
+                {
+                    l_space = l_iter->second.lock();
+                }
+            }
+            // Solver and criteria space are built without lock, a criteria
+            // space built meanwhile by another request is preferred to share
+            // memory
+            solver l_solver{m_solver_cache.get(l_checkers_id)};
+            if(!l_space)
+            {
+                std::vector<std::shared_ptr<checker_if>> l_checkers;
+                for(auto l_id: l_checkers_id)
+                {
+                    l_checkers.emplace_back(solver::get_checker(l_id));
+                }
+                l_space = std::make_shared<const criteria_space>(l_checkers);
+            }
+            unsigned int l_nb_remaining = l_solver.get_remaining_candidates();
+            std::lock_guard<std::mutex> l_lock{m_mutex};
+            if(m_sessions.size() >= m_max_sessions)
+            {
+                throw quicky_exception::quicky_logic_exception("Too many sessions", __LINE__, __FILE__);
+            }
+            std::weak_ptr<const criteria_space> & l_shared_space = m_spaces[l_checkers_id];
+            if(auto l_other_space = l_shared_space.lock())
+            {
+                l_space = std::move(l_other_space);
+            }
+            else
+            {
+                l_shared_space = l_space;
+            }
+            uint64_t l_id;
+            do
+            {
+                l_id = (static_cast<uint64_t>(m_random_device()) << 32) | m_random_device();
+            }
+            while(!l_id || m_sessions.contains(l_id));
+            m_sessions.emplace(l_id, std::make_shared<game_session>(l_checkers_id, std::move(l_solver), std::move(l_space)));
+            l_response << " " << l_id << " " << l_nb_remaining;
+        }
+        else if("apply" == p_command)
+        {
+            std::shared_ptr<game_session> l_session = get_session(p_reader.next<uint64_t>());
+            auto l_code = p_reader.next<unsigned int>();
+            auto l_checker_index = p_reader.next<unsigned int>();
+            bool l_result{static_cast<bool>(p_reader.next<unsigned int>())};
+            l_response << " " << l_session->apply(l_code, l_checker_index, l_result);
+        }
+        else if("suggest" == p_command)
+        {
+            std::shared_ptr<game_session> l_session = get_session(p_reader.next<uint64_t>());
+            query_suggestion l_suggestion = l_session->suggest(m_suggest_budget).m_suggestion;
+            candidate l_candidate = l_suggestion.get_candidate();
+            l_response << " " << l_candidate.get_blue_triangle() << l_candidate.get_yellow_square() << l_candidate.get_purple_circle();
+            l_response << " " << l_suggestion.get_checker_index() << " " << l_suggestion.get_score();
+        }
+        else if("state" == p_command)
+        {
+            l_response << " ";
+            get_session(p_reader.next<uint64_t>())->print_state(l_response);
+        }
+        else if("close" == p_command)
+        {
+            auto l_id = p_reader.next<uint64_t>();
+            std::lock_guard<std::mutex> l_lock{m_mutex};
+            if(!m_sessions.erase(l_id))
+            {
+                throw quicky_exception::quicky_logic_exception("Unknown session " + std::to_string(l_id), __LINE__, __FILE__);
+            }
+        }
+        else if("cache" == p_command)
+        {
+            const suggestion_cache & l_cache = suggestion_cache::get_shared();
+            l_response << " " << l_cache.get_nb_entries() << " " << l_cache.get_nb_hits() << " " << l_cache.get_nb_misses();
+            l_response << " " << l_cache.get_nb_evictions() << " " << l_cache.get_nb_upgrades() << " " << l_cache.get_hit_rate();
+        }
+        else
+        {
+            throw quicky_exception::quicky_logic_exception("Unknown command \"" + std::string(p_command) + "\"", __LINE__, __FILE__);
+        }
+        if(!p_reader.is_empty())
+        {
+            throw quicky_exception::quicky_logic_exception("Too many arguments", __LINE__, __FILE__);
+        }
+        return l_response.str();
+    }
+
+    //-------------------------------------------------------------------------
+    void
+    game_server::expire()
+    {
+        std::lock_guard<std::mutex> l_lock{m_mutex};
+        auto l_limit = std::chrono::steady_clock::now() - m_timeout;
+        std::erase_if(m_sessions, [=](const auto & p_item){return p_item.second->get_last_activity() < l_limit;});
+        std::erase_if(m_spaces, [](const auto & p_item){return p_item.second.expired();});
+    }
+
+    //-------------------------------------------------------------------------
+    size_t
+    game_server::get_nb_sessions() const
+    {
+        std::lock_guard<std::mutex> l_lock{m_mutex};
+        return m_sessions.size();
+    }
+
+    //-------------------------------------------------------------------------
+    void
+    game_server::serve(std::istream & p_input
+                      ,std::ostream & p_output
+                      )
+    {
+        std::string l_line;
+        while(std::getline(p_input, l_line))
+        {
+            expire();
+            p_output << handle(l_line) << std::endl;
+        }
+    }
+
+    //-------------------------------------------------------------------------
+    bool
+    game_server::receive(connection & p_connection)
+    {
+        char l_buffer[4096];
+        while(p_connection.m_input.size() <= m_max_request_size)
+        {
+            ssize_t l_nb_read = ::read(p_connection.m_fd, l_buffer, sizeof(l_buffer));
+            if(l_nb_read > 0)
+            {
+                p_connection.m_input.append(l_buffer, static_cast<size_t>(l_nb_read));
+            }
+            else if(!l_nb_read)
+            {
+                p_connection.m_end_of_input = true;
+                return true;
+            }
+            else
+            {
+                return EAGAIN == errno || EWOULDBLOCK == errno || EINTR == errno;
+            }
+        }
+        return true;
+    }
+
+    //-------------------------------------------------------------------------
+    bool
+    game_server::flush(connection & p_connection)
+    {
+        size_t l_written = 0;
+        while(l_written < p_connection.m_output.size())
+        {
+            ssize_t l_nb_written = ::send(p_connection.m_fd, p_connection.m_output.data() + l_written, p_connection.m_output.size() - l_written, MSG_NOSIGNAL);
+            if(l_nb_written < 0)
+            {
+                if(EAGAIN != errno && EWOULDBLOCK != errno && EINTR != errno)
+                {
+                    return false;
+                }
+                break;
+            }
+            l_written += static_cast<size_t>(l_nb_written);
+        }
+        p_connection.m_output.erase(0, l_written);
+        return true;
+    }
+
+    //-------------------------------------------------------------------------
+    void
+    game_server::serve(const std::string & p_socket_name
+                      ,unsigned int p_nb_threads
+                      )
+    {
+        int l_server = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        sockaddr_un l_address{};
+        l_address.sun_family = AF_UNIX;
+        if(l_server < 0 || p_socket_name.size() >= sizeof(l_address.sun_path))
+        {
+            throw quicky_exception::quicky_runtime_exception("Unable to create socket " + p_socket_name, __LINE__, __FILE__);
+        }
+        std::strncpy(l_address.sun_path, p_socket_name.c_str(), sizeof(l_address.sun_path) - 1);
+        ::unlink(p_socket_name.c_str());
+        if(bind(l_server, reinterpret_cast<sockaddr *>(&l_address), sizeof(l_address)) || listen(l_server, SOMAXCONN))
+        {
+            ::close(l_server);
+            throw quicky_exception::quicky_runtime_exception("Unable to listen on " + p_socket_name + ": " + std::strerror(errno), __LINE__, __FILE__);
+        }
+
+        request_pool l_pool{[this](std::string_view p_request){return handle(p_request);}, p_nb_threads};
+
+        // Connections are identified by a counter rather than by their file
+        // descriptor which can be reused while a request is being handled
+        std::map<uint64_t, connection> l_connections;
+        uint64_t l_next_connection = 0;
+        std::vector<pollfd> l_poll_fds;
+        std::vector<uint64_t> l_polled;
+        while(true)
+        {
+            l_poll_fds.clear();
+            l_polled.clear();
+            l_poll_fds.push_back({l_server, POLLIN, 0});
+            l_poll_fds.push_back({l_pool.get_notification_fd(), POLLIN, 0});
+            for(const auto & [l_id, l_connection]: l_connections)
+            {
+                short l_events = 0;
+                if(l_connection.m_input.size() <= m_max_request_size && !l_connection.m_end_of_input)
+                {
+                    l_events |= POLLIN;
+                }
+                if(!l_connection.m_output.empty())
+                {
+                    l_events |= POLLOUT;
+                }
+                // Hang up is reported even without events so a connection
+                // waiting for its response is not polled
+                if(l_events)
+                {
+                    l_poll_fds.push_back({l_connection.m_fd, l_events, 0});
+                    l_polled.push_back(l_id);
+                }
+            }
+            // Wake up regularly to expire sessions
+            if(poll(l_poll_fds.data(), l_poll_fds.size(), 1000) < 0 && EINTR != errno)
+            {
+                throw quicky_exception::quicky_runtime_exception(std::string("poll failed: ") + std::strerror(errno), __LINE__, __FILE__);
+            }
+            expire();
+            if(l_poll_fds[0].revents)
+            {
+                int l_client;
+                while((l_client = accept4(l_server, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0)
+                {
+                    l_connections.emplace(l_next_connection++, connection{l_client, {}, {}, false, false});
+                }
+            }
+            if(l_poll_fds[1].revents)
+            {
+                for(auto & [l_id, l_response]: l_pool.take_responses())
+                {
+                    // Response of a closed connection is dropped
+                    if(auto l_iter = l_connections.find(l_id); l_connections.end() != l_iter)
+                    {
+                        l_iter->second.m_output += l_response;
+                        l_iter->second.m_output += '\n';
+                        l_iter->second.m_busy = false;
+                    }
+                }
+            }
+            for(size_t l_index = 0; l_index < l_polled.size(); ++l_index)
+            {
+                short l_revents = l_poll_fds[l_index + 2].revents;
+                connection & l_connection = l_connections.at(l_polled[l_index]);
+                bool l_open = !(l_revents & (POLLERR | POLLNVAL));
+                if(l_open && (l_revents & (POLLIN | POLLHUP)))
+                {
+                    l_open = receive(l_connection);
+                }
+                if(!l_open)
+                {
+                    ::close(l_connection.m_fd);
+                    l_connections.erase(l_polled[l_index]);
+                }
+            }
+
+            // Dispatch next request of idle connections and write responses
+            // without waiting for next poll
+            for(auto l_iter = l_connections.begin(); l_connections.end() != l_iter;)
+            {
+                connection & l_connection = l_iter->second;
+                size_t l_end = l_connection.m_input.find('\n');
+                if(!l_connection.m_busy && l_connection.m_output.size() < m_max_output_size && std::string::npos != l_end)
+                {
+                    l_pool.submit(l_iter->first, l_connection.m_input.substr(0, l_end));
+                    l_connection.m_input.erase(0, l_end + 1);
+                    l_connection.m_busy = true;
+                }
+                // A client sending a too long request is disconnected so
+                // memory per connection stays bounded
+                bool l_open = (std::string::npos != l_end || l_connection.m_input.size() <= m_max_request_size) && flush(l_connection);
+                if(l_open && l_connection.m_end_of_input && !l_connection.m_busy && l_connection.m_output.empty())
+                {
+                    l_open = std::string::npos != l_connection.m_input.find('\n');
+                }
+                if(l_open)
+                {
+                    ++l_iter;
+                }
+                else
+                {
+                    ::close(l_connection.m_fd);
+                    l_iter = l_connections.erase(l_iter);
+                }
+            }
+        }
+    }
+}
+#endif //TURING_MACHINE_SOLVER_GAME_SERVER_H
+// EOF
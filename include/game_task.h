@@ -0,0 +1,180 @@
+/*    This file is part of turing_machine_solver
+      Copyright (C) 2024  Julien Thevenon ( julien_thevenon at yahoo.fr )
+
+      This program is free software: you can redistribute it and/or modify
+      it under the terms of the GNU General Public License as published by
+      the Free Software Foundation, either version 3 of the License, or
+      (at your option) any later version.
+
+      This program is distributed in the hope that it will be useful,
+      but WITHOUT ANY WARRANTY; without even the implied warranty of
+      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+      GNU General Public License for more details.
+
+      You should have received a copy of the GNU General Public License
+      along with this program.  If not, see <http://www.gnu.org/licenses/>
+*/
+
+#ifndef TURING_MACHINE_SOLVER_GAME_TASK_H
+#define TURING_MACHINE_SOLVER_GAME_TASK_H
+
+#include <coroutine>
+#include <exception>
+#include <utility>
+
+namespace turing_machine_solver
+{
+    /**
+     * Coroutine playing a game. It starts immediately and runs until it
+     * waits for a value from ask, then it is resumed by ask when a value is
+     * pushed. Exception thrown by game is kept and rethrown by caller
+     */
+    class game_task
+    {
+    public:
+
+        class promise_type
+        {
+        public:
+            [[nodiscard]] inline
+            game_task
+            get_return_object();
+
+            [[nodiscard]] inline
+            std::suspend_never
+            initial_suspend() noexcept;
+
+            [[nodiscard]] inline
+            std::suspend_always
+            final_suspend() noexcept;
+
+            inline
+            void
+            return_void();
+
+            inline
+            void
+            unhandled_exception();
+
+            [[nodiscard]] inline
+            const std::exception_ptr &
+            get_exception() const;
+
+        private:
+            std::exception_ptr m_exception;
+        };
+
+        inline
+        game_task(game_task && p_task) noexcept;
+
+        game_task(const game_task &) = delete;
+
+        game_task &
+        operator=(const game_task &) = delete;
+
+        inline
+        ~game_task();
+
+        /**
+         * Indicate if game is over, normally or because of an exception
+         */
+        [[nodiscard]] inline
+        bool
+        is_done() const;
+
+        /**
+         * Rethrow exception that ended game if any
+         */
+        inline
+        void
+        rethrow_if_failed() const;
+
+    private:
+
+        inline explicit
+        game_task(std::coroutine_handle<promise_type> p_handle);
+
+        std::coroutine_handle<promise_type> m_handle;
+    };
+
+    //-------------------------------------------------------------------------
+    game_task
+    game_task::promise_type::get_return_object()
+    {
+        return game_task{std::coroutine_handle<promise_type>::from_promise(*this)};
+    }
+
+    //-------------------------------------------------------------------------
+    std::suspend_never
+    game_task::promise_type::initial_suspend() noexcept
+    {
+        return {};
+    }
+
+    //-------------------------------------------------------------------------
+    std::suspend_always
+    game_task::promise_type::final_suspend() noexcept
+    {
+        return {};
+    }
+
+    //-------------------------------------------------------------------------
+    void
+    game_task::promise_type::return_void()
+    {
+    }
+
+    //-------------------------------------------------------------------------
+    void
+    game_task::promise_type::unhandled_exception()
+    {
+        m_exception = std::current_exception();
+    }
+
+    //-------------------------------------------------------------------------
+    const std::exception_ptr &
+    game_task::promise_type::get_exception() const
+    {
+        return m_exception;
+    }
+
+    //-------------------------------------------------------------------------
+    game_task::game_task(std::coroutine_handle<promise_type> p_handle)
+    :m_handle{p_handle}
+    {
+    }
+
+    //-------------------------------------------------------------------------
+    game_task::game_task(game_task && p_task) noexcept
+    :m_handle{std::exchange(p_task.m_handle, nullptr)}
+    {
+    }
+
+    //-------------------------------------------------------------------------
+    game_task::~game_task()
+    {
+        if(m_handle)
+        {
+            m_handle.destroy();
+        }
+    }
+
+    //-------------------------------------------------------------------------
+    bool
+    game_task::is_done() const
+    {
+        return !m_handle || m_handle.done();
+    }
+
+    //-------------------------------------------------------------------------
+    void
+    game_task::rethrow_if_failed() const
+    {
+        if(m_handle && m_handle.done() && m_handle.promise().get_exception())
+        {
+            std::rethrow_exception(m_handle.promise().get_exception());
+        }
+    }
+}
+#endif //TURING_MACHINE_SOLVER_GAME_TASK_H
+// EOF
@@ -0,0 +1,272 @@
+/*    This file is part of turing_machine_solver
+      Copyright (C) 2024  Julien Thevenon ( julien_thevenon at yahoo.fr )
+
+      This program is free software: you can redistribute it and/or modify
+      it under the terms of the GNU General Public License as published by
+      the Free Software Foundation, either version 3 of the License, or
+      (at your option) any later version.
+
+      This program is distributed in the hope that it will be useful,
+      but WITHOUT ANY WARRANTY; without even the implied warranty of
+      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+      GNU General Public License for more details.
+
+      You should have received a copy of the GNU General Public License
+      along with this program.  If not, see <http://www.gnu.org/licenses/>
+*/
+
+#ifndef TURING_MACHINE_SOLVER_INSTRUMENTATION_H
+#define TURING_MACHINE_SOLVER_INSTRUMENTATION_H
+
+#include "allocation_counter.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <ostream>
+#include <string>
+
+namespace turing_machine_solver
+{
+    /**
+     * Process wide timers and counters of solver phases, shared by all
+     * threads. Only compiled in when ENABLE_INSTRUMENTATION is defined,
+     * otherwise all operations are empty and values stay null. Heap
+     * allocations done during phases are also counted when
+     * ENABLE_ALLOCATION_CHECK is defined
+     */
+    class instrumentation
+    {
+    public:
+
+        enum class phase {ENUMERATION, POTENTIAL_CHECKERS, SIGNATURES, UNIQUENESS, ELIMINATION, DISPLAY};
+
+        enum class counter {CANDIDATES, SIGNATURES, PREDICATE_CALLS, DUPLICATE_SIGNATURES, ANALYZE_CALLS, CODES_ELIMINATED, ALLOCATIONS};
+
+#ifdef ENABLE_INSTRUMENTATION
+        static constexpr bool m_enabled = true;
+#else // ENABLE_INSTRUMENTATION
+        static constexpr bool m_enabled = false;
+#endif // ENABLE_INSTRUMENTATION
+
+        static constexpr bool m_allocations_enabled = m_enabled && allocation_counter::m_enabled;
+
+        /**
+         * Add time elapsed and allocations done by current thread during
+         * its life to a phase
+         */
+        class timer
+        {
+        public:
+            inline explicit
+            timer(phase p_phase);
+
+            inline
+            ~timer();
+
+            timer(const timer &) = delete;
+
+            timer &
+            operator=(const timer &) = delete;
+
+        private:
+            phase m_phase;
+
+            std::chrono::steady_clock::time_point m_start;
+
+            uint64_t m_nb_allocations;
+        };
+
+        inline static
+        void
+        add(counter p_counter
+           ,uint64_t p_value = 1
+           );
+
+        [[nodiscard]] inline static
+        uint64_t
+        get_count(counter p_counter);
+
+        [[nodiscard]] inline static
+        std::chrono::nanoseconds
+        get_time(phase p_phase);
+
+        /**
+         * Number of timers that measured a phase
+         */
+        [[nodiscard]] inline static
+        uint64_t
+        get_nb_calls(phase p_phase);
+
+        /**
+         * Number of heap allocations done during a phase
+         */
+        [[nodiscard]] inline static
+        uint64_t
+        get_nb_allocations(phase p_phase);
+
+        inline static
+        void
+        reset();
+
+        inline static
+        void
+        save_json(std::ostream & p_stream);
+
+        /**
+         * Write JSON dump in a file when process exits
+         */
+        inline static
+        void
+        dump_at_exit(const std::string & p_file_name);
+
+    private:
+
+        static constexpr size_t m_nb_phases = 6;
+
+        static constexpr size_t m_nb_counters = 7;
+
+        static constexpr std::array<const char *, m_nb_phases> m_phase_names{"enumeration", "potential_checkers", "signatures", "uniqueness", "elimination", "display"};
+
+        static constexpr std::array<const char *, m_nb_counters> m_counter_names{"candidates", "signatures", "predicate_calls", "duplicate_signatures", "analyze_calls", "codes_eliminated", "allocations"};
+
+        inline static std::array<std::atomic<uint64_t>, m_nb_phases> m_times{};
+
+        inline static std::array<std::atomic<uint64_t>, m_nb_phases> m_nb_calls{};
+
+        inline static std::array<std::atomic<uint64_t>, m_nb_phases> m_allocations{};
+
+        inline static std::array<std::atomic<uint64_t>, m_nb_counters> m_counters{};
+    };
+
+    //-------------------------------------------------------------------------
+    instrumentation::timer::timer(phase p_phase)
+    :m_phase{p_phase}
+    ,m_nb_allocations{0}
+    {
+        if constexpr(m_enabled)
+        {
+            m_start = std::chrono::steady_clock::now();
+        }
+        if constexpr(m_allocations_enabled)
+        {
+            m_nb_allocations = allocation_counter::get_nb_allocations();
+        }
+    }
+
+    //-------------------------------------------------------------------------
+    instrumentation::timer::~timer()
+    {
+        if constexpr(m_enabled)
+        {
+            auto l_duration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_start);
+            m_times[static_cast<size_t>(m_phase)].fetch_add(static_cast<uint64_t>(l_duration.count()), std::memory_order_relaxed);
+            m_nb_calls[static_cast<size_t>(m_phase)].fetch_add(1, std::memory_order_relaxed);
+        }
+        if constexpr(m_allocations_enabled)
+        {
+            // Phases are not nested so total is the sum of phases
+            uint64_t l_nb_allocations = allocation_counter::get_nb_allocations() - m_nb_allocations;
+            m_allocations[static_cast<size_t>(m_phase)].fetch_add(l_nb_allocations, std::memory_order_relaxed);
+            add(counter::ALLOCATIONS, l_nb_allocations);
+        }
+    }
+
+    //-------------------------------------------------------------------------
+    void
+    instrumentation::add(counter p_counter
+                        ,uint64_t p_value
+                        )
+    {
+        if constexpr(m_enabled)
+        {
+            m_counters[static_cast<size_t>(p_counter)].fetch_add(p_value, std::memory_order_relaxed);
+        }
+    }
+
+    //-------------------------------------------------------------------------
+    uint64_t
+    instrumentation::get_count(counter p_counter)
+    {
+        return m_counters[static_cast<size_t>(p_counter)].load(std::memory_order_relaxed);
+    }
+
+    //-------------------------------------------------------------------------
+    std::chrono::nanoseconds
+    instrumentation::get_time(phase p_phase)
+    {
+        return std::chrono::nanoseconds(m_times[static_cast<size_t>(p_phase)].load(std::memory_order_relaxed));
+    }
+
+    //-------------------------------------------------------------------------
+    uint64_t
+    instrumentation::get_nb_calls(phase p_phase)
+    {
+        return m_nb_calls[static_cast<size_t>(p_phase)].load(std::memory_order_relaxed);
+    }
+
+    //-------------------------------------------------------------------------
+    uint64_t
+    instrumentation::get_nb_allocations(phase p_phase)
+    {
+        return m_allocations[static_cast<size_t>(p_phase)].load(std::memory_order_relaxed);
+    }
+
+    //-------------------------------------------------------------------------
+    void
+    instrumentation::reset()
+    {
+        for(size_t l_index = 0; l_index < m_nb_phases; ++l_index)
+        {
+            m_times[l_index].store(0, std::memory_order_relaxed);
+            m_nb_calls[l_index].store(0, std::memory_order_relaxed);
+            m_allocations[l_index].store(0, std::memory_order_relaxed);
+        }
+        for(auto & l_counter: m_counters)
+        {
+            l_counter.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    //-------------------------------------------------------------------------
+    void
+    instrumentation::save_json(std::ostream & p_stream)
+    {
+        p_stream << "{\"enabled\":" << (m_enabled ? "true" : "false") << ",\"phases\":{";
+        for(size_t l_index = 0; l_index < m_nb_phases; ++l_index)
+        {
+            p_stream << (l_index ? "," : "") << "\n\"" << m_phase_names[l_index] << "\":{\"time_ns\":" << m_times[l_index].load(std::memory_order_relaxed);
+            p_stream << ",\"calls\":" << m_nb_calls[l_index].load(std::memory_order_relaxed);
+            p_stream << ",\"allocations\":" << m_allocations[l_index].load(std::memory_order_relaxed) << "}";
+        }
+        p_stream << "},\"counters\":{";
+        for(size_t l_index = 0; l_index < m_nb_counters; ++l_index)
+        {
+            p_stream << (l_index ? "," : "") << "\n\"" << m_counter_names[l_index] << "\":" << m_counters[l_index].load(std::memory_order_relaxed);
+        }
+        p_stream << "}}" << std::endl;
+    }
+
+    //-------------------------------------------------------------------------
+    void
+    instrumentation::dump_at_exit(const std::string & p_file_name)
+    {
+        // Constructed before handler registration so destroyed after its call
+        static std::string l_file_name;
+        bool l_registered = !l_file_name.empty();
+        l_file_name = p_file_name;
+        if(!l_registered)
+        {
+            std::atexit([]()
+                        {
+                            std::ofstream l_file{l_file_name};
+                            save_json(l_file);
+                        }
+                       );
+        }
+    }
+}
+#endif //TURING_MACHINE_SOLVER_INSTRUMENTATION_H
+// EOF
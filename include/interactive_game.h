@@ -0,0 +1,360 @@
+/*    This file is part of turing_machine_solver
+      Copyright (C) 2024  Julien Thevenon ( julien_thevenon at yahoo.fr )
+
+      This program is free software: you can redistribute it and/or modify
+      it under the terms of the GNU General Public License as published by
+      the Free Software Foundation, either version 3 of the License, or
+      (at your option) any later version.
+
+      This program is distributed in the hope that it will be useful,
+      but WITHOUT ANY WARRANTY; without even the implied warranty of
+      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+      GNU General Public License for more details.
+
+      You should have received a copy of the GNU General Public License
+      along with this program.  If not, see <http://www.gnu.org/licenses/>
+*/
+
+#ifndef TURING_MACHINE_SOLVER_INTERACTIVE_GAME_H
+#define TURING_MACHINE_SOLVER_INTERACTIVE_GAME_H
+
+#include "solver.h"
+#include "nightmare_solver.h"
+#include "criteria_space.h"
+#include "planner.h"
+#include "contradiction_detector.h"
+#include "answer_history.h"
+#include "puzzle_database.h"
+#include "game_task.h"
+#include "ask.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <optional>
+#include <cstdint>
+
+namespace turing_machine_solver
+{
+    /**
+     * Questions and answers of a game with a player. Game is a coroutine
+     * suspended each time it waits for a value from ask, so one thread can
+     * host many games by pushing values to their ask objects
+     */
+    class interactive_game
+    {
+    public:
+
+        /**
+         * @param p_output stream where questions are displayed
+         */
+        inline explicit
+        interactive_game(std::ostream & p_output = std::cout);
+
+        inline
+        void
+        set_nightmare(bool p_nightmare);
+
+        /**
+         * @param p_budget time budget in milliseconds of query suggestion,
+         * no suggestion if 0
+         */
+        inline
+        void
+        set_planner_budget(unsigned int p_budget);
+
+        /**
+         * @param p_database_name database of puzzles with a single solution
+         * consulted before solving, none if empty
+         */
+        inline
+        void
+        set_database(const std::string & p_database_name);
+
+        /**
+         * Enable display of solvers. Solvers display on std::cout so it
+         * should be disabled when several games are hosted
+         */
+        inline
+        void
+        set_solver_display(bool p_display);
+
+        /**
+         * Start game. Game object and ask must outlive returned task, and
+         * task must be destroyed before ask
+         * @param p_ask source of player values
+         * @return task running until game ends
+         */
+        [[nodiscard]] inline
+        game_task
+        play(ask & p_ask) const;
+
+    private:
+
+        std::ostream & m_output;
+
+        bool m_nightmare;
+
+        unsigned int m_planner_budget;
+
+        std::string m_database_name;
+
+        bool m_solver_display;
+    };
+
+    //-------------------------------------------------------------------------
+    interactive_game::interactive_game(std::ostream & p_output)
+    :m_output{p_output}
+    ,m_nightmare{false}
+    ,m_planner_budget{0}
+    ,m_solver_display{true}
+    {
+    }
+
+    //-------------------------------------------------------------------------
+    void
+    interactive_game::set_nightmare(bool p_nightmare)
+    {
+        m_nightmare = p_nightmare;
+    }
+
+    //-------------------------------------------------------------------------
+    void
+    interactive_game::set_planner_budget(unsigned int p_budget)
+    {
+        m_planner_budget = p_budget;
+    }
+
+    //-------------------------------------------------------------------------
+    void
+    interactive_game::set_database(const std::string & p_database_name)
+    {
+        m_database_name = p_database_name;
+    }
+
+    //-------------------------------------------------------------------------
+    void
+    interactive_game::set_solver_display(bool p_display)
+    {
+        m_solver_display = p_display;
+    }
+
+    //-------------------------------------------------------------------------
+    game_task
+    interactive_game::play(ask & p_ask) const
+    {
+        m_output << "How many checkers ?" << std::endl;
+        unsigned int nb_checkers{co_await p_ask.async_next<unsigned int>()};
+        m_output << "You define " << nb_checkers << " checkers" << std::endl;
+
+        std::vector<unsigned int> l_checkers_id;
+        do
+        {
+            solver::display_all_checkers(m_output);
+            unsigned int l_id{co_await p_ask.async_next<unsigned int>()};
+            l_checkers_id.emplace_back(l_id);
+        } while (l_checkers_id.size() < nb_checkers);
+
+        // Solver displays solution itself unless its messages are disabled
+        bool l_solver_display = m_solver_display && output_sink::get_console().is_enabled(verbosity::SUMMARY);
+
+        if(m_nightmare)
+        {
+            nightmare_solver l_solver(l_checkers_id, l_solver_display ? &output_sink::get_console() : nullptr);
+            do
+            {
+                auto [l_suggested_candidate, l_suggested_verifier] = l_solver.get_best_query();
+                m_output << "Suggested query " << l_suggested_candidate << " on verifier " << l_suggested_verifier << std::endl;
+                m_output << "Propose a candidate ?" << std::endl;
+                unsigned int l_candidate_num{co_await p_ask.async_next<unsigned int>()};
+                candidate l_candidate{l_candidate_num};
+                int l_verifier_index;
+                unsigned int l_remaining_check = 3;
+                do
+                {
+                    m_output << "Current candidate " << l_candidate << std::endl;
+                    m_output << "Verifier index ? ( -1 to propose a new candidate)" << std::endl;
+                    l_verifier_index = co_await p_ask.async_next<int>();
+                    if(l_verifier_index != -1)
+                    {
+                        m_output << "Verifier result ?" << std::endl;
+                        bool l_result{static_cast<bool>(co_await p_ask.async_next<unsigned int>())};
+                        m_output << "You entered result " << l_result << std::endl;
+                        --l_remaining_check;
+                        l_solver.analyze_result(l_candidate, static_cast<unsigned int>(l_verifier_index), l_result);
+                    }
+                } while(l_remaining_check && l_verifier_index != -1 && l_solver.get_remaining_candidates() > 1);
+
+            } while(l_solver.get_remaining_candidates() > 1);
+            if(!l_solver_display && l_solver.get_remaining_candidates())
+            {
+                m_output << "SOLUTION FOUND :" << condition_table::index_code(condition_table::first_code(l_solver.get_remaining_codes())) << std::endl;
+            }
+            co_return;
+        }
+
+        if(!m_database_name.empty())
+        {
+            puzzle_database l_database{m_database_name};
+            if(auto l_record = l_database.find(l_checkers_id))
+            {
+                // Record conditions follow increasing ids, display them in checkers order
+                std::vector<unsigned int> l_record_ids = l_record->get_checkers_id();
+                m_output << "Puzzle found in database" << std::endl;
+                m_output << "SOLUTION FOUND :" << condition_table::index_code(l_record->get_code_index()) << " -> ";
+                for(auto l_id: l_checkers_id)
+                {
+                    auto l_index = static_cast<unsigned int>(std::find(l_record_ids.begin(), l_record_ids.end(), l_id) - l_record_ids.begin());
+                    puzzle_record::display_conditions(m_output, l_record->get_conditions(l_index));
+                }
+                m_output << std::endl;
+                co_return;
+            }
+        }
+
+        solver l_solver(l_checkers_id, l_solver_display);
+
+        std::vector<std::shared_ptr<checker_if>> l_checkers_list;
+        for(auto l_id: l_checkers_id)
+        {
+            l_checkers_list.emplace_back(solver::get_checker(l_id));
+        }
+        // Criteria are always built as contradictions are detected on them
+        criteria_space l_space{l_checkers_list};
+        std::vector<unsigned int> l_criteria = l_space.get_all_indexes();
+        planner l_planner{l_space};
+
+        // Answers are recorded to roll back mistyped ones from initial state
+        answer_history l_history{l_solver, l_checkers_id, &l_space};
+        auto l_display_conflicts = [&](const std::vector<uint64_t> & p_conflicts)
+        {
+            for(unsigned int l_conflict_index = 0; l_conflict_index < p_conflicts.size(); ++l_conflict_index)
+            {
+                m_output << l_conflict_index + 1 << ":";
+                for(unsigned int l_index = 0; l_index < l_history.get_answers().size(); ++l_index)
+                {
+                    if(p_conflicts[l_conflict_index] >> l_index & 1)
+                    {
+                        const checker_answer & l_answer = l_history.get_answers()[l_index];
+                        m_output << " candidate " << condition_table::index_code(l_answer.m_code_index) << " checker " << l_answer.m_checker_index << " result " << l_answer.m_result << ";";
+                    }
+                }
+                m_output << std::endl;
+            }
+        };
+        // Rollback token is accepted in place of a candidate or a checker
+        // index, so a contradiction on last check of a round can be fixed
+        std::vector<uint64_t> l_conflicts;
+        auto l_prepare_rollback = [&]() -> bool
+        {
+            l_conflicts = l_history.is_rollback_enabled() ? l_history.get_minimal_conflicts() : std::vector<uint64_t>{};
+            if(l_conflicts.empty())
+            {
+                m_output << (l_history.is_rollback_enabled() ? "Answers are consistent, nothing to roll back" : "Rollback is disabled") << std::endl;
+                return false;
+            }
+            l_display_conflicts(l_conflicts);
+            m_output << "Set of answers to roll back ? (0 to keep all answers)" << std::endl;
+            return true;
+        };
+        auto l_roll_back = [&](unsigned int p_choice) -> std::optional<potential_checkers>
+        {
+            if(!p_choice || p_choice > l_conflicts.size())
+            {
+                return std::nullopt;
+            }
+            l_history.remove(l_conflicts[p_choice - 1]);
+            l_criteria = l_space.get_all_indexes();
+            auto l_conditions = l_history.replay(l_solver
+                                                ,[&](const checker_answer & p_answer)
+                                                 {
+                                                     if(m_planner_budget)
+                                                     {
+                                                         l_planner.filter(l_criteria, p_answer.m_code_index, p_answer.m_checker_index, p_answer.m_result);
+                                                     }
+                                                 }
+                                                );
+            l_solver.set_verbose(l_solver_display);
+            m_output << "Answers rolled back, " << l_solver.get_remaining_candidates() << " candidates remaining" << std::endl;
+            return l_conditions;
+        };
+
+        // Game goes on without remaining candidate so that answers can be rolled back
+        do
+        {
+            if(m_planner_budget && !l_criteria.empty())
+            {
+                auto l_suggestion = l_planner.suggest(l_criteria
+                                                     ,std::chrono::steady_clock::now() + std::chrono::milliseconds(m_planner_budget)
+                                                     ,l_solver.get_remaining_codes()
+                                                     );
+                m_output << "Suggested query " << l_suggestion << std::endl;
+            }
+            m_output << "Propose a candidate ?" << std::endl;
+            int l_candidate_num{co_await p_ask.async_next<int>()};
+            if(contradiction_detector::m_rollback_index == l_candidate_num)
+            {
+                if(l_prepare_rollback())
+                {
+                    (void)l_roll_back(co_await p_ask.async_next<unsigned int>());
+                }
+                continue;
+            }
+            candidate l_candidate{static_cast<unsigned int>(l_candidate_num)};
+            potential_checkers l_checkers = l_solver.get_related_checkers(l_candidate);
+            l_history.start_round(condition_table::code_index(l_candidate));
+            int l_checker_index;
+            unsigned int l_remaining_check = 3;
+            do
+            {
+                m_output << "Current candidate " << l_candidate << " -> " << l_checkers << std::endl;
+                m_output << "Checker index ? ( -1 to propose a new candidate)" << std::endl;
+                l_checker_index = co_await p_ask.async_next<int>();
+                if(contradiction_detector::m_rollback_index == l_checker_index)
+                {
+                    if(l_prepare_rollback())
+                    {
+                        if(auto l_conditions = l_roll_back(co_await p_ask.async_next<unsigned int>()))
+                        {
+                            l_checkers = *l_conditions;
+                        }
+                    }
+                }
+                else if(l_checker_index != -1)
+                {
+                    m_output << "Checker result ?" << std::endl;
+                    bool l_result{static_cast<bool>(co_await p_ask.async_next<unsigned int>())};
+                    m_output << "You entered result " << l_result << std::endl;
+                    --l_remaining_check;
+                    l_solver.analyze_result(l_checkers, static_cast<unsigned int>(l_checker_index), l_result);
+                    if(m_planner_budget)
+                    {
+                        l_planner.filter(l_criteria, condition_table::code_index(l_candidate), static_cast<unsigned int>(l_checker_index), l_result);
+                    }
+                    bool l_rollback_enabled = l_history.is_rollback_enabled();
+                    l_history.add(static_cast<unsigned int>(l_checker_index), l_result);
+                    if(l_rollback_enabled && !l_history.is_rollback_enabled())
+                    {
+                        m_output << "Limit of " << contradiction_detector::m_max_answers << " recorded answers reached, rollback is disabled" << std::endl;
+                    }
+                    if(l_history.is_rollback_enabled() && l_history.is_contradictory())
+                    {
+                        m_output << "No solution satisfies all answers, smallest sets of conflicting answers :" << std::endl;
+                        l_display_conflicts(l_history.get_minimal_conflicts());
+                        m_output << "Enter " << contradiction_detector::m_rollback_index << " as checker index or candidate to roll back one of them" << std::endl;
+                    }
+                }
+            } while(l_remaining_check && l_checker_index != -1 && 1 != l_solver.get_remaining_candidates());
+            l_history.end_round();
+
+        } while(1 != l_solver.get_remaining_candidates());
+
+        if(!l_solver_display && l_solver.get_remaining_candidates())
+        {
+            candidate l_solution = condition_table::index_code(condition_table::first_code(l_solver.get_remaining_codes()));
+            m_output << "SOLUTION FOUND :" << l_solution << " -> " << l_solver.get_related_checkers(l_solution) << std::endl;
+        }
+    }
+}
+#endif //TURING_MACHINE_SOLVER_INTERACTIVE_GAME_H
+// EOF
@@ -0,0 +1,212 @@
+/*    This file is part of turing_machine_solver
+      Copyright (C) 2024  Julien Thevenon ( julien_thevenon at yahoo.fr )
+
+      This program is free software: you can redistribute it and/or modify
+      it under the terms of the GNU General Public License as published by
+      the Free Software Foundation, either version 3 of the License, or
+      (at your option) any later version.
+
+      This program is distributed in the hope that it will be useful,
+      but WITHOUT ANY WARRANTY; without even the implied warranty of
+      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+      GNU General Public License for more details.
+
+      You should have received a copy of the GNU General Public License
+      along with this program.  If not, see <http://www.gnu.org/licenses/>
+*/
+
+#ifndef TURING_MACHINE_SOLVER_LOG_REPLAYER_H
+#define TURING_MACHINE_SOLVER_LOG_REPLAYER_H
+
+#include "game_runner.h"
+#include "solver_cache.h"
+#include "work_stealing_pool.h"
+#include "quicky_exception.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <ostream>
+
+namespace turing_machine_solver
+{
+    /**
+     * Replay sessions recorded by ask log files. Each file of a directory
+     * is one session whose tokens are played directly on a solver like
+     * game_runner does, sessions being distributed on a thread pool
+     */
+    class log_replayer
+    {
+    public:
+
+        /**
+         * @param p_expected_name file giving expected solution of sessions,
+         * one "<log file name> <code>" pair per line, none if empty
+         */
+        inline explicit
+        log_replayer(const std::string & p_expected_name = "");
+
+        /**
+         * Replay all regular files of a directory in name order and write
+         * one result line per session followed by a summary
+         * @param p_directory directory containing log files
+         * @param p_output output stream
+         * @param p_nb_threads number of threads, 0 means hardware concurrency
+         * @return number of sessions that are in error or diverge from
+         * their expected solution
+         */
+        inline
+        unsigned int
+        replay_directory(const std::string & p_directory
+                        ,std::ostream & p_output
+                        ,unsigned int p_nb_threads = 0
+                        ) const;
+
+        /**
+         * Indicate if result of a session differs from its expected
+         * solution, always false if session has no expected solution
+         */
+        [[nodiscard]] inline
+        bool
+        is_divergent(const std::string & p_session_name
+                    ,const game_result & p_result
+                    ) const;
+
+    private:
+
+        [[nodiscard]] inline static
+        std::string
+        read_file(const std::filesystem::path & p_path);
+
+        std::map<std::string, unsigned int> m_expected;
+    };
+
+    //-------------------------------------------------------------------------
+    log_replayer::log_replayer(const std::string & p_expected_name)
+    {
+        if(p_expected_name.empty())
+        {
+            return;
+        }
+        std::ifstream l_file{p_expected_name};
+        if(!l_file.is_open())
+        {
+            throw quicky_exception::quicky_runtime_exception("Unable to open " + p_expected_name, __LINE__, __FILE__);
+        }
+        std::string l_line;
+        while(std::getline(l_file, l_line))
+        {
+            std::stringstream l_stream{l_line};
+            std::string l_name;
+            unsigned int l_code;
+            if(!(l_stream >> l_name))
+            {
+                continue;
+            }
+            if(!(l_stream >> l_code))
+            {
+                throw quicky_exception::quicky_logic_exception("Bad expected solution line \"" + l_line + "\"", __LINE__, __FILE__);
+            }
+            m_expected[l_name] = l_code;
+        }
+    }
+
+    //-------------------------------------------------------------------------
+    bool
+    log_replayer::is_divergent(const std::string & p_session_name
+                              ,const game_result & p_result
+                              ) const
+    {
+        auto l_iter = m_expected.find(p_session_name);
+        return m_expected.end() != l_iter && p_result.get_solution() != l_iter->second;
+    }
+
+    //-------------------------------------------------------------------------
+    std::string
+    log_replayer::read_file(const std::filesystem::path & p_path)
+    {
+        std::ifstream l_file{p_path, std::ios::binary};
+        if(!l_file.is_open())
+        {
+            throw quicky_exception::quicky_runtime_exception("Unable to open " + p_path.string(), __LINE__, __FILE__);
+        }
+        std::stringstream l_content;
+        l_content << l_file.rdbuf();
+        return l_content.str();
+    }
+
+    //-------------------------------------------------------------------------
+    unsigned int
+    log_replayer::replay_directory(const std::string & p_directory
+                                  ,std::ostream & p_output
+                                  ,unsigned int p_nb_threads
+                                  ) const
+    {
+        std::vector<std::filesystem::path> l_paths;
+        for(const auto & l_entry: std::filesystem::directory_iterator{p_directory})
+        {
+            if(l_entry.is_regular_file())
+            {
+                l_paths.emplace_back(l_entry.path());
+            }
+        }
+        std::sort(l_paths.begin(), l_paths.end());
+
+        std::vector<std::optional<game_result>> l_results(l_paths.size());
+        solver_cache l_cache{game_runner::m_cache_memory_cap};
+        work_stealing_pool l_pool{p_nb_threads};
+        auto l_start = std::chrono::steady_clock::now();
+        l_pool.run(l_paths.size()
+                  ,[&](size_t p_index, unsigned int)
+                   {
+                       // Log files hold a single line of comma separated tokens
+                       std::string l_script = read_file(l_paths[p_index]);
+                       l_results[p_index].emplace(game_runner::run(l_script, &l_cache));
+                   }
+                  );
+        auto l_duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - l_start);
+
+        unsigned int l_nb_solved = 0;
+        unsigned int l_nb_incomplete = 0;
+        unsigned int l_nb_errors = 0;
+        unsigned int l_nb_divergent = 0;
+        std::string l_output;
+        for(size_t l_index = 0; l_index < l_paths.size(); ++l_index)
+        {
+            const game_result & l_result = *l_results[l_index];
+            std::string l_name = l_paths[l_index].filename().string();
+            std::stringstream l_stream;
+            l_stream << l_name << " " << l_result;
+            switch(l_result.get_status())
+            {
+                case game_result::status::SOLVED:
+                    ++l_nb_solved;
+                    break;
+                case game_result::status::INCOMPLETE:
+                    ++l_nb_incomplete;
+                    break;
+                case game_result::status::ERROR:
+                    ++l_nb_errors;
+                    break;
+            }
+            if(is_divergent(l_name, l_result))
+            {
+                ++l_nb_divergent;
+                l_stream << " DIVERGENT expected " << m_expected.find(l_name)->second;
+            }
+            l_output += l_stream.str();
+            l_output += '\n';
+        }
+        p_output << l_output;
+        p_output << l_paths.size() << " sessions replayed in " << l_duration.count() << "ms with " << l_pool.get_nb_threads() << " threads: ";
+        p_output << l_nb_solved << " solved, " << l_nb_incomplete << " incomplete, " << l_nb_errors << " errors, " << l_nb_divergent << " divergent" << std::endl;
+        return l_nb_errors + l_nb_divergent;
+    }
+}
+#endif //TURING_MACHINE_SOLVER_LOG_REPLAYER_H
+// EOF
@@ -0,0 +1,300 @@
+/*    This file is part of turing_machine_solver
+      Copyright (C) 2024  Julien Thevenon ( julien_thevenon at yahoo.fr )
+
+      This program is free software: you can redistribute it and/or modify
+      it under the terms of the GNU General Public License as published by
+      the Free Software Foundation, either version 3 of the License, or
+      (at your option) any later version.
+
+      This program is distributed in the hope that it will be useful,
+      but WITHOUT ANY WARRANTY; without even the implied warranty of
+      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+      GNU General Public License for more details.
+
+      You should have received a copy of the GNU General Public License
+      along with this program.  If not, see <http://www.gnu.org/licenses/>
+*/
+
+#ifndef TURING_MACHINE_SOLVER_MAP_SOLVER_H
+#define TURING_MACHINE_SOLVER_MAP_SOLVER_H
+
+#include "solver.h"
+#include "candidate.h"
+#include "condition_table.h"
+#include "quicky_exception.h"
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <ostream>
+#include <set>
+#include <vector>
+
+namespace turing_machine_solver
+{
+    /**
+     * Conditions satisfied by a code for each checker, one set of condition
+     * indexes per checker. Displayed like potential_checkers
+     */
+    class set_signature
+    {
+        friend std::ostream & operator<<(std::ostream &, const set_signature & );
+
+    public:
+
+        inline
+        void
+        add(std::set<unsigned int> && p_value);
+
+        [[nodiscard]] inline
+        bool
+        is_valid() const;
+
+        [[nodiscard]] inline
+        bool
+        is_compliant_with(unsigned int p_index
+                         ,const set_signature & p_signature
+                         ,bool p_checker_result
+                         ) const;
+
+        [[nodiscard]] inline
+        bool
+        operator<(const set_signature & p_signature) const;
+
+    private:
+
+        std::vector<std::set<unsigned int>> m_content;
+    };
+
+    /**
+     * Reference engine for differential fuzzing: the solver as it was
+     * before its state became fixed size arrays, with maps between
+     * candidates and their signatures and no bit manipulation. It is slow
+     * but straightforward, so solver is checked against it
+     */
+    class map_solver
+    {
+    public:
+
+        typedef set_signature signature;
+
+        /**
+         * @param p_checkers_id ids of checkers of game registry
+         */
+        inline explicit
+        map_solver(const std::vector<unsigned int> & p_checkers_id);
+
+        [[nodiscard]] inline
+        unsigned int
+        get_remaining_candidates() const;
+
+        [[nodiscard]] inline
+        code_set
+        get_remaining_codes() const;
+
+        /**
+         * Signature of a remaining code
+         */
+        [[nodiscard]] inline
+        const set_signature &
+        get_related_checkers(const candidate & p_candidate) const;
+
+        /**
+         * Remove candidates whose signature is not compliant with result
+         * of a checker for a code
+         * @param p_signature signature of checked code
+         */
+        inline
+        void
+        analyze_result(const set_signature & p_signature
+                      ,unsigned int p_checker_index
+                      ,bool p_result
+                      );
+
+    private:
+
+        std::vector<std::shared_ptr<checker_if>> m_checkers;
+
+        std::map<candidate, set_signature> m_candidate_to_checkers;
+
+        std::map<set_signature, candidate> m_checkers_to_candidate;
+    };
+
+    //-------------------------------------------------------------------------
+    void
+    set_signature::add(std::set<unsigned int> && p_value)
+    {
+        m_content.emplace_back(std::move(p_value));
+    }
+
+    //-------------------------------------------------------------------------
+    bool
+    set_signature::is_valid() const
+    {
+        return std::all_of(m_content.begin()
+                          ,m_content.end()
+                          ,[](const std::set<unsigned int> & p_item)
+                             {return !p_item.empty();}
+                          );
+    }
+
+    //-------------------------------------------------------------------------
+    bool
+    set_signature::is_compliant_with(unsigned int p_index
+                                    ,const set_signature & p_signature
+                                    ,bool p_checker_result
+                                    ) const
+    {
+        if(p_index >= m_content.size() || m_content.size() != p_signature.m_content.size())
+        {
+            throw quicky_exception::quicky_logic_exception("Bad index " + std::to_string(p_index), __LINE__, __FILE__);
+        }
+        if(m_content[p_index] == p_signature.m_content[p_index])
+        {
+            return p_checker_result;
+        }
+        std::vector<unsigned int> l_intersection;
+        std::set_intersection(m_content[p_index].begin()
+                             ,m_content[p_index].end()
+                             ,p_signature.m_content[p_index].begin()
+                             ,p_signature.m_content[p_index].end()
+                             ,std::back_inserter(l_intersection)
+                             );
+        return !l_intersection.empty() || !p_checker_result;
+    }
+
+    //-------------------------------------------------------------------------
+    bool
+    set_signature::operator<(const set_signature & p_signature) const
+    {
+        return m_content < p_signature.m_content;
+    }
+
+    //-------------------------------------------------------------------------
+    std::ostream &
+    operator<<(std::ostream & p_stream
+              ,const set_signature & p_signature
+              )
+    {
+        for(const auto & l_iter: p_signature.m_content)
+        {
+            if(l_iter.size() == 1)
+            {
+                p_stream << *l_iter.begin();
+            }
+            else if(l_iter.size() > 1)
+            {
+                p_stream << "(" ;
+                for(const auto & l_iter_value: l_iter)
+                {
+                    p_stream << l_iter_value;
+                }
+                p_stream << ")";
+            }
+            else
+            {
+                p_stream << "-";
+            }
+        }
+        return p_stream;
+    }
+
+    //-------------------------------------------------------------------------
+    map_solver::map_solver(const std::vector<unsigned int> & p_checkers_id)
+    {
+        if(p_checkers_id.size() > potential_checkers::m_max_checkers)
+        {
+            throw quicky_exception::quicky_logic_exception("Too many checkers " + std::to_string(p_checkers_id.size()), __LINE__, __FILE__);
+        }
+        for(auto l_id: p_checkers_id)
+        {
+            m_checkers.emplace_back(solver::get_registry().get_checker(l_id));
+        }
+        // A signature shared by several candidates does not tell them apart
+        // so all of them are removed once every candidate is related
+        std::set<set_signature> l_bad_checkers;
+        for(unsigned int l_code_index = 0; l_code_index < condition_table::m_nb_codes; ++l_code_index)
+        {
+            candidate l_candidate = condition_table::index_code(l_code_index);
+            set_signature l_signature;
+            for(const auto & l_checker: m_checkers)
+            {
+                l_signature.add(l_checker->get_correct_conditions(l_candidate));
+            }
+            if(!l_signature.is_valid() || l_bad_checkers.contains(l_signature))
+            {
+                continue;
+            }
+            auto l_iter = m_checkers_to_candidate.find(l_signature);
+            if(m_checkers_to_candidate.end() != l_iter)
+            {
+                m_candidate_to_checkers.erase(l_iter->second);
+                m_checkers_to_candidate.erase(l_iter);
+                l_bad_checkers.insert(l_signature);
+                continue;
+            }
+            m_candidate_to_checkers.emplace(l_candidate, l_signature);
+            m_checkers_to_candidate.emplace(l_signature, l_candidate);
+        }
+    }
+
+    //-------------------------------------------------------------------------
+    unsigned int
+    map_solver::get_remaining_candidates() const
+    {
+        return static_cast<unsigned int>(m_candidate_to_checkers.size());
+    }
+
+    //-------------------------------------------------------------------------
+    code_set
+    map_solver::get_remaining_codes() const
+    {
+        code_set l_result;
+        for(const auto & l_iter: m_candidate_to_checkers)
+        {
+            l_result.set(condition_table::code_index(l_iter.first));
+        }
+        return l_result;
+    }
+
+    //-------------------------------------------------------------------------
+    const set_signature &
+    map_solver::get_related_checkers(const candidate & p_candidate) const
+    {
+        auto l_iter = m_candidate_to_checkers.find(p_candidate);
+        if(m_candidate_to_checkers.end() == l_iter)
+        {
+            throw quicky_exception::quicky_logic_exception("Bad candidate", __LINE__, __FILE__);
+        }
+        return l_iter->second;
+    }
+
+    //-------------------------------------------------------------------------
+    void
+    map_solver::analyze_result(const set_signature & p_signature
+                              ,unsigned int p_checker_index
+                              ,bool p_result
+                              )
+    {
+        if(p_checker_index >= m_checkers.size())
+        {
+            throw quicky_exception::quicky_logic_exception("Bad checker value " + std::to_string(p_checker_index), __LINE__, __FILE__);
+        }
+        std::vector<candidate> l_bad_candidates;
+        for(const auto & l_iter: m_candidate_to_checkers)
+        {
+            if(!l_iter.second.is_compliant_with(p_checker_index, p_signature, p_result))
+            {
+                l_bad_candidates.emplace_back(l_iter.first);
+            }
+        }
+        for(const auto & l_candidate: l_bad_candidates)
+        {
+            auto l_iter = m_candidate_to_checkers.find(l_candidate);
+            m_checkers_to_candidate.erase(l_iter->second);
+            m_candidate_to_checkers.erase(l_iter);
+        }
+    }
+}
+#endif //TURING_MACHINE_SOLVER_MAP_SOLVER_H
+// EOF
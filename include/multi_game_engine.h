@@ -0,0 +1,464 @@
+/*    This file is part of turing_machine_solver
+      Copyright (C) 2024  Julien Thevenon ( julien_thevenon at yahoo.fr )
+
+      This program is free software: you can redistribute it and/or modify
+      it under the terms of the GNU General Public License as published by
+      the Free Software Foundation, either version 3 of the License, or
+      (at your option) any later version.
+
+      This program is distributed in the hope that it will be useful,
+      but WITHOUT ANY WARRANTY; without even the implied warranty of
+      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+      GNU General Public License for more details.
+
+      You should have received a copy of the GNU General Public License
+      along with this program.  If not, see <http://www.gnu.org/licenses/>
+*/
+
+#ifndef TURING_MACHINE_SOLVER_MULTI_GAME_ENGINE_H
+#define TURING_MACHINE_SOLVER_MULTI_GAME_ENGINE_H
+
+#include "bitset_solver.h"
+#include "condition_table.h"
+#include "quicky_exception.h"
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+namespace turing_machine_solver
+{
+    /**
+     * Result of a checker for a code in a game of multi_game_engine
+     */
+    class game_answer
+    {
+    public:
+        unsigned int m_lane;
+
+        unsigned int m_code_index;
+
+        unsigned int m_checker_index;
+
+        bool m_result;
+    };
+
+    /**
+     * Up to 64 games sharing the same checkers, with the same results as
+     * one bitset_solver per game. State is bit-sliced: for each code a word
+     * whose bit N tells if code remains in game of lane N, so a batch of
+     * results is applied with one AND per code for each distinct result
+     */
+    class multi_game_engine
+    {
+    public:
+
+        static constexpr unsigned int m_nb_lanes = 64;
+
+        /**
+         * @param p_checkers_id ids of checkers of game registry
+         */
+        inline explicit
+        multi_game_engine(const std::vector<unsigned int> & p_checkers_id);
+
+        /**
+         * Start a game in a free lane
+         * @return lane of game
+         */
+        inline
+        unsigned int
+        add_game();
+
+        /**
+         * Free lane of a game
+         */
+        inline
+        void
+        remove_game(unsigned int p_lane);
+
+        /**
+         * Apply results of a batch, several results of the same game are
+         * allowed. Checked codes must be initial candidates, like signatures
+         * kept by solver users they can be checked after their elimination.
+         * Batch is checked before any result is applied
+         */
+        inline
+        void
+        analyze_results(const std::vector<game_answer> & p_answers);
+
+        [[nodiscard]] inline
+        code_set
+        get_remaining_codes(unsigned int p_lane) const;
+
+        /**
+         * Conditions satisfied by a code for each checker, same value as
+         * bitset_solver signature
+         */
+        [[nodiscard]] inline
+        packed_signature
+        get_signature(unsigned int p_code_index) const;
+
+        [[nodiscard]] inline
+        unsigned int
+        get_remaining_candidates(unsigned int p_lane) const;
+
+        /**
+         * Lanes of games
+         */
+        [[nodiscard]] inline
+        uint64_t
+        get_active_games() const;
+
+        /**
+         * Lanes of games with exactly one remaining code
+         */
+        [[nodiscard]] inline
+        uint64_t
+        get_solved_games() const;
+
+        /**
+         * Lanes of games without remaining code
+         */
+        [[nodiscard]] inline
+        uint64_t
+        get_contradicted_games() const;
+
+    private:
+
+        inline
+        void
+        check_lane(unsigned int p_lane) const;
+
+        /**
+         * Codes kept by result of a checker for codes satisfying some
+         * conditions, rules are those of bitset_solver::analyze_result
+         */
+        [[nodiscard]] inline
+        code_set
+        compute_kept_codes(unsigned int p_checker_index
+                          ,uint16_t p_conditions
+                          ,bool p_result
+                          ) const;
+
+        /**
+         * Initial candidates of a game
+         */
+        code_set m_initial;
+
+        /**
+         * Condition masks per checker
+         */
+        std::vector<std::vector<code_set>> m_masks;
+
+        /**
+         * Conditions satisfied by each code per checker
+         */
+        std::vector<std::array<uint16_t, condition_table::m_nb_codes>> m_conditions;
+
+        std::array<uint64_t, condition_table::m_nb_codes> m_lanes;
+
+        uint64_t m_active;
+    };
+
+    /**
+     * Solver interface over a multi_game_engine so that differential_fuzzer
+     * can compare it with solver. Game is played in two lanes receiving the
+     * same answers, and a third lane receives opposite answers in the same
+     * batches, first or last in turn, so that grouping of answers is
+     * exercised. Engine takes the
+     * checked code instead of its signature: it is the initial candidate
+     * with this signature as initial candidates have distinct signatures
+     */
+    class multi_game_solver
+    {
+    public:
+
+        typedef packed_signature signature;
+
+        inline explicit
+        multi_game_solver(const std::vector<unsigned int> & p_checkers_id);
+
+        [[nodiscard]] inline
+        code_set
+        get_remaining_codes() const;
+
+        [[nodiscard]] inline
+        packed_signature
+        get_related_checkers(const candidate & p_candidate) const;
+
+        /**
+         * Throw if lanes of the game diverge
+         */
+        inline
+        void
+        analyze_result(const packed_signature & p_signature
+                      ,unsigned int p_checker_index
+                      ,bool p_result
+                      );
+
+    private:
+        multi_game_engine m_engine;
+
+        std::array<unsigned int, 3> m_lanes;
+
+        code_set m_initial;
+
+        unsigned int m_nb_batches;
+    };
+
+    //-------------------------------------------------------------------------
+    multi_game_engine::multi_game_engine(const std::vector<unsigned int> & p_checkers_id)
+    :m_initial{bitset_solver{p_checkers_id}.get_remaining_codes()}
+    ,m_conditions(p_checkers_id.size())
+    ,m_lanes{}
+    ,m_active{0}
+    {
+        for(unsigned int l_checker_index = 0; l_checker_index < p_checkers_id.size(); ++l_checker_index)
+        {
+            auto l_checker = solver::get_checker(p_checkers_id[l_checker_index]);
+            std::vector<code_set> l_masks;
+            for(unsigned int l_condition_index = 0; l_condition_index < l_checker->get_grade(); ++l_condition_index)
+            {
+                l_masks.emplace_back(condition_table::compute_mask(*l_checker, l_condition_index));
+                for(unsigned int l_code_index = 0; l_code_index < condition_table::m_nb_codes; ++l_code_index)
+                {
+                    m_conditions[l_checker_index][l_code_index] |= static_cast<uint16_t>(l_masks.back().test(l_code_index) << l_condition_index);
+                }
+            }
+            m_masks.emplace_back(std::move(l_masks));
+        }
+    }
+
+    //-------------------------------------------------------------------------
+    unsigned int
+    multi_game_engine::add_game()
+    {
+        if(!~m_active)
+        {
+            throw quicky_exception::quicky_logic_exception("No free lane", __LINE__, __FILE__);
+        }
+        auto l_lane = static_cast<unsigned int>(std::countr_one(m_active));
+        uint64_t l_bit = uint64_t(1) << l_lane;
+        m_active |= l_bit;
+        for(unsigned int l_code_index = 0; l_code_index < condition_table::m_nb_codes; ++l_code_index)
+        {
+            m_lanes[l_code_index] = (m_lanes[l_code_index] & ~l_bit) | (m_initial.test(l_code_index) ? l_bit : 0);
+        }
+        return l_lane;
+    }
+
+    //-------------------------------------------------------------------------
+    void
+    multi_game_engine::remove_game(unsigned int p_lane)
+    {
+        check_lane(p_lane);
+        m_active &= ~(uint64_t(1) << p_lane);
+    }
+
+    //-------------------------------------------------------------------------
+    void
+    multi_game_engine::check_lane(unsigned int p_lane) const
+    {
+        if(p_lane >= m_nb_lanes || !(m_active >> p_lane & 1))
+        {
+            throw quicky_exception::quicky_logic_exception("Bad lane " + std::to_string(p_lane), __LINE__, __FILE__);
+        }
+    }
+
+    //-------------------------------------------------------------------------
+    code_set
+    multi_game_engine::compute_kept_codes(unsigned int p_checker_index
+                                         ,uint16_t p_conditions
+                                         ,bool p_result
+                                         ) const
+    {
+        const std::vector<code_set> & l_masks = m_masks[p_checker_index];
+        // True result keeps codes sharing a condition, false result keeps
+        // codes whose conditions differ
+        code_set l_codes;
+        if(!p_result)
+        {
+            l_codes.set();
+        }
+        for(unsigned int l_condition_index = 0; l_condition_index < l_masks.size(); ++l_condition_index)
+        {
+            bool l_checked = p_conditions >> l_condition_index & 1;
+            if(p_result)
+            {
+                l_codes |= l_checked ? l_masks[l_condition_index] : code_set();
+            }
+            else
+            {
+                l_codes &= l_checked ? l_masks[l_condition_index] : ~l_masks[l_condition_index];
+            }
+        }
+        return p_result ? l_codes : ~l_codes;
+    }
+
+    //-------------------------------------------------------------------------
+    void
+    multi_game_engine::analyze_results(const std::vector<game_answer> & p_answers)
+    {
+        std::vector<uint16_t> l_conditions(p_answers.size());
+        for(size_t l_index = 0; l_index < p_answers.size(); ++l_index)
+        {
+            const game_answer & l_answer = p_answers[l_index];
+            check_lane(l_answer.m_lane);
+            if(l_answer.m_checker_index >= m_masks.size())
+            {
+                throw quicky_exception::quicky_logic_exception("Bad checker value " + std::to_string(l_answer.m_checker_index), __LINE__, __FILE__);
+            }
+            if(l_answer.m_code_index >= condition_table::m_nb_codes || !m_initial.test(l_answer.m_code_index))
+            {
+                throw quicky_exception::quicky_logic_exception("Bad candidate", __LINE__, __FILE__);
+            }
+            l_conditions[l_index] = m_conditions[l_answer.m_checker_index][l_answer.m_code_index];
+        }
+
+        // Answers with the same checker, conditions and result share kept
+        // codes so they are applied together to the lanes of their games
+        std::vector<bool> l_done(p_answers.size(), false);
+        for(size_t l_index = 0; l_index < p_answers.size(); ++l_index)
+        {
+            if(l_done[l_index])
+            {
+                continue;
+            }
+            const game_answer & l_answer = p_answers[l_index];
+            uint64_t l_group = 0;
+            for(size_t l_other = l_index; l_other < p_answers.size(); ++l_other)
+            {
+                const game_answer & l_other_answer = p_answers[l_other];
+                if(!l_done[l_other] && l_other_answer.m_checker_index == l_answer.m_checker_index && l_other_answer.m_result == l_answer.m_result && l_conditions[l_other] == l_conditions[l_index])
+                {
+                    l_done[l_other] = true;
+                    l_group |= uint64_t(1) << l_other_answer.m_lane;
+                }
+            }
+            code_set l_kept = compute_kept_codes(l_answer.m_checker_index, l_conditions[l_index], l_answer.m_result);
+            for(unsigned int l_code_index = 0; l_code_index < condition_table::m_nb_codes; ++l_code_index)
+            {
+                m_lanes[l_code_index] &= ~(l_group & (uint64_t(0) - !l_kept.test(l_code_index)));
+            }
+        }
+    }
+
+    //-------------------------------------------------------------------------
+    code_set
+    multi_game_engine::get_remaining_codes(unsigned int p_lane) const
+    {
+        check_lane(p_lane);
+        code_set l_codes;
+        for(unsigned int l_code_index = 0; l_code_index < condition_table::m_nb_codes; ++l_code_index)
+        {
+            l_codes[l_code_index] = m_lanes[l_code_index] >> p_lane & 1;
+        }
+        return l_codes;
+    }
+
+    //-------------------------------------------------------------------------
+    packed_signature
+    multi_game_engine::get_signature(unsigned int p_code_index) const
+    {
+        packed_signature l_signature;
+        for(unsigned int l_checker_index = 0; l_checker_index < m_conditions.size(); ++l_checker_index)
+        {
+            l_signature.set(l_checker_index, m_conditions[l_checker_index][p_code_index]);
+        }
+        return l_signature;
+    }
+
+    //-------------------------------------------------------------------------
+    unsigned int
+    multi_game_engine::get_remaining_candidates(unsigned int p_lane) const
+    {
+        return static_cast<unsigned int>(get_remaining_codes(p_lane).count());
+    }
+
+    //-------------------------------------------------------------------------
+    uint64_t
+    multi_game_engine::get_active_games() const
+    {
+        return m_active;
+    }
+
+    //-------------------------------------------------------------------------
+    uint64_t
+    multi_game_engine::get_solved_games() const
+    {
+        // Bit-sliced counter saturating at two
+        uint64_t l_one = 0;
+        uint64_t l_two = 0;
+        for(auto l_lanes: m_lanes)
+        {
+            l_two |= l_one & l_lanes;
+            l_one |= l_lanes;
+        }
+        return l_one & ~l_two & m_active;
+    }
+
+    //-------------------------------------------------------------------------
+    uint64_t
+    multi_game_engine::get_contradicted_games() const
+    {
+        uint64_t l_any = 0;
+        for(auto l_lanes: m_lanes)
+        {
+            l_any |= l_lanes;
+        }
+        return ~l_any & m_active;
+    }
+
+    //-------------------------------------------------------------------------
+    multi_game_solver::multi_game_solver(const std::vector<unsigned int> & p_checkers_id)
+    :m_engine{p_checkers_id}
+    ,m_lanes{m_engine.add_game(), m_engine.add_game(), m_engine.add_game()}
+    ,m_initial{m_engine.get_remaining_codes(m_lanes[0])}
+    ,m_nb_batches{0}
+    {
+    }
+
+    //-------------------------------------------------------------------------
+    code_set
+    multi_game_solver::get_remaining_codes() const
+    {
+        return m_engine.get_remaining_codes(m_lanes[0]);
+    }
+
+    //-------------------------------------------------------------------------
+    packed_signature
+    multi_game_solver::get_related_checkers(const candidate & p_candidate) const
+    {
+        unsigned int l_code_index = condition_table::code_index(p_candidate);
+        if(!get_remaining_codes().test(l_code_index))
+        {
+            throw quicky_exception::quicky_logic_exception("Bad candidate", __LINE__, __FILE__);
+        }
+        return m_engine.get_signature(l_code_index);
+    }
+
+    //-------------------------------------------------------------------------
+    void
+    multi_game_solver::analyze_result(const packed_signature & p_signature
+                                     ,unsigned int p_checker_index
+                                     ,bool p_result
+                                     )
+    {
+        unsigned int l_code_index = 0;
+        while(l_code_index < condition_table::m_nb_codes && !(m_initial.test(l_code_index) && m_engine.get_signature(l_code_index) == p_signature))
+        {
+            ++l_code_index;
+        }
+        std::vector<game_answer> l_batch{{m_lanes[0], l_code_index, p_checker_index, p_result}
+                                        ,{m_lanes[1], l_code_index, p_checker_index, p_result}
+                                        };
+        l_batch.insert(m_nb_batches++ % 2 ? l_batch.begin() : l_batch.end(), {m_lanes[2], l_code_index, p_checker_index, !p_result});
+        m_engine.analyze_results(l_batch);
+        if(m_engine.get_remaining_codes(m_lanes[0]) != m_engine.get_remaining_codes(m_lanes[1]))
+        {
+            throw quicky_exception::quicky_logic_exception("Lanes of same game diverge", __LINE__, __FILE__);
+        }
+    }
+}
+#endif //TURING_MACHINE_SOLVER_MULTI_GAME_ENGINE_H
+// EOF
@@ -0,0 +1,404 @@
+/*    This file is part of turing_machine_solver
+      Copyright (C) 2024  Julien Thevenon ( julien_thevenon at yahoo.fr )
+
+      This program is free software: you can redistribute it and/or modify
+      it under the terms of the GNU General Public License as published by
+      the Free Software Foundation, either version 3 of the License, or
+      (at your option) any later version.
+
+      This program is distributed in the hope that it will be useful,
+      but WITHOUT ANY WARRANTY; without even the implied warranty of
+      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+      GNU General Public License for more details.
+
+      You should have received a copy of the GNU General Public License
+      along with this program.  If not, see <http://www.gnu.org/licenses/>
+*/
+
+#ifndef TURING_MACHINE_SOLVER_NIGHTMARE_SOLVER_H
+#define TURING_MACHINE_SOLVER_NIGHTMARE_SOLVER_H
+
+#include "solver.h"
+#include "criteria_space.h"
+#include "output_sink.h"
+#include "quicky_exception.h"
+#include <bitset>
+#include <vector>
+#include <algorithm>
+
+namespace turing_machine_solver
+{
+    /**
+     * Solver for Nightmare mode where verifier to checker assignment is
+     * unknown. State is the set of (permutation, criteria) couples
+     * consistent with results. Criteria are the condition index of each
+     * checker, only criteria selecting a single code are kept. For each
+     * criteria a bitset of permutations indicates which verifier to checker
+     * assignments are still possible
+     */
+    class nightmare_solver
+    {
+    public:
+        /**
+         * @param p_checkers_id ids of checkers used in game
+         * @param p_sink destination of messages, nothing is displayed if
+         * null. Sink must outlive solver
+         */
+        inline explicit
+        nightmare_solver(const std::vector<unsigned int> & p_checkers_id
+                        ,output_sink * p_sink = &output_sink::get_console()
+                        );
+
+        /**
+         * Number of codes that are still potential solutions
+         */
+        [[nodiscard]] inline
+        unsigned int
+        get_remaining_candidates() const;
+
+        /**
+         * Codes that are still potential solutions
+         */
+        [[nodiscard]] inline
+        code_set
+        get_remaining_codes() const;
+
+        /**
+         * Number of (permutation, criteria) couples still possible
+         */
+        [[nodiscard]] inline
+        unsigned int
+        get_remaining_states() const;
+
+        /**
+         * Remove states not compliant with verifier result
+         * @param p_candidate candidate proposed to verifier
+         * @param p_verifier_index index of verifier
+         * @param p_result verifier answer
+         */
+        inline
+        void
+        analyze_result(const candidate & p_candidate
+                      ,unsigned int p_verifier_index
+                      ,bool p_result
+                      );
+
+        /**
+         * Compute how states would be split by a verifier answer
+         * @param p_candidate candidate proposed to verifier
+         * @param p_verifier_index index of verifier
+         * @return number of states compliant with true and false answers
+         */
+        [[nodiscard]] inline
+        std::pair<unsigned int, unsigned int>
+        evaluate_query(const candidate & p_candidate
+                      ,unsigned int p_verifier_index
+                      ) const;
+
+        /**
+         * Query minimising expected number of remaining states
+         * @return candidate and verifier index
+         */
+        [[nodiscard]] inline
+        std::pair<candidate, unsigned int>
+        get_best_query() const;
+
+        /**
+         * Indicate which checkers can still be behind a verifier
+         * @param p_verifier_index index of verifier
+         * @return bitfield of checker indexes
+         */
+        [[nodiscard]] inline
+        unsigned int
+        get_possible_checkers(unsigned int p_verifier_index) const;
+
+        inline
+        void
+        display_remaining() const;
+
+        static constexpr unsigned int m_max_checkers = 6;
+
+    private:
+
+        typedef std::bitset<720> permutation_set;
+
+        /**
+         * Permutations compatible with verifier answering p_result
+         * for candidate p_code_index with criteria p_criteria_index
+         */
+        [[nodiscard]] inline
+        permutation_set
+        get_compliant_permutations(unsigned int p_criteria_index
+                                  ,unsigned int p_code_index
+                                  ,unsigned int p_verifier_index
+                                  ,bool p_result
+                                  ) const;
+
+        inline
+        void
+        remove_criteria(unsigned int p_criteria_index);
+
+        std::vector<std::shared_ptr<checker_if>> m_checkers;
+
+        criteria_space m_space;
+
+        /**
+         * m_verifier_permutations[V][C] contains permutations assigning
+         * checker C to verifier V
+         */
+        std::vector<std::vector<permutation_set>> m_verifier_permutations;
+
+        /**
+         * Indexes of remaining criteria in criteria space
+         */
+        std::vector<unsigned int> m_criteria;
+
+        /**
+         * Permutations still possible for each remaining criteria
+         */
+        std::vector<permutation_set> m_permutations;
+
+        output_sink * m_sink;
+    };
+
+    //-------------------------------------------------------------------------
+    nightmare_solver::nightmare_solver(const std::vector<unsigned int> & p_checkers_id
+                                      ,output_sink * p_sink
+                                      )
+    :m_checkers{[&]()
+                {
+                    if(p_checkers_id.empty() || p_checkers_id.size() > m_max_checkers)
+                    {
+                        throw quicky_exception::quicky_logic_exception("Nightmare mode support 1 to " + std::to_string(m_max_checkers) + " checkers"
+                                                                      ,__LINE__
+                                                                      ,__FILE__
+                                                                      );
+                    }
+                    std::vector<std::shared_ptr<checker_if>> l_checkers;
+                    for(auto l_id: p_checkers_id)
+                    {
+                        l_checkers.emplace_back(solver::get_checker(l_id));
+                    }
+                    return l_checkers;
+                }()
+               }
+    ,m_space{m_checkers}
+    ,m_verifier_permutations(m_checkers.size(), std::vector<permutation_set>(m_checkers.size()))
+    ,m_sink{p_sink}
+    {
+        std::vector<unsigned int> l_permutation(m_checkers.size());
+        for(unsigned int l_index = 0; l_index < l_permutation.size(); ++l_index)
+        {
+            l_permutation[l_index] = l_index;
+        }
+        permutation_set l_all_permutations;
+        unsigned int l_permutation_index = 0;
+        do
+        {
+            for(unsigned int l_verifier_index = 0; l_verifier_index < l_permutation.size(); ++l_verifier_index)
+            {
+                m_verifier_permutations[l_verifier_index][l_permutation[l_verifier_index]].set(l_permutation_index);
+            }
+            l_all_permutations.set(l_permutation_index);
+            ++l_permutation_index;
+        } while(std::next_permutation(l_permutation.begin(), l_permutation.end()));
+
+        m_criteria = m_space.get_all_indexes();
+        m_permutations.assign(m_criteria.size(), l_all_permutations);
+
+        if(m_sink)
+        {
+            m_sink->write_line(verbosity::SUMMARY, m_space.get_nb_criteria(), " criteria combinations with a single solution");
+        }
+        display_remaining();
+    }
+
+    //-------------------------------------------------------------------------
+    unsigned int
+    nightmare_solver::get_remaining_candidates() const
+    {
+        return static_cast<unsigned int>(get_remaining_codes().count());
+    }
+
+    //-------------------------------------------------------------------------
+    code_set
+    nightmare_solver::get_remaining_codes() const
+    {
+        return m_space.get_solutions(m_criteria);
+    }
+
+    //-------------------------------------------------------------------------
+    unsigned int
+    nightmare_solver::get_remaining_states() const
+    {
+        unsigned int l_result = 0;
+        for(const auto & l_iter: m_permutations)
+        {
+            l_result += static_cast<unsigned int>(l_iter.count());
+        }
+        return l_result;
+    }
+
+    //-------------------------------------------------------------------------
+    nightmare_solver::permutation_set
+    nightmare_solver::get_compliant_permutations(unsigned int p_criteria_index
+                                                ,unsigned int p_code_index
+                                                ,unsigned int p_verifier_index
+                                                ,bool p_result
+                                                ) const
+    {
+        permutation_set l_result;
+        for(unsigned int l_checker_index = 0; l_checker_index < m_checkers.size(); ++l_checker_index)
+        {
+            if(m_space.is_accepted(m_criteria[p_criteria_index], l_checker_index, p_code_index) == p_result)
+            {
+                l_result |= m_verifier_permutations[p_verifier_index][l_checker_index];
+            }
+        }
+        return l_result;
+    }
+
+    //-------------------------------------------------------------------------
+    void
+    nightmare_solver::remove_criteria(unsigned int p_criteria_index)
+    {
+        std::swap(m_criteria[p_criteria_index], m_criteria.back());
+        std::swap(m_permutations[p_criteria_index], m_permutations.back());
+        m_criteria.pop_back();
+        m_permutations.pop_back();
+    }
+
+    //-------------------------------------------------------------------------
+    void
+    nightmare_solver::analyze_result(const candidate & p_candidate
+                                    ,unsigned int p_verifier_index
+                                    ,bool p_result
+                                    )
+    {
+        if(p_verifier_index >= m_checkers.size())
+        {
+            throw quicky_exception::quicky_logic_exception("Bad verifier value " + std::to_string(p_verifier_index) + ", should be in range [0," + std::to_string(m_checkers.size() - 1) + ']'
+                                                          , __LINE__
+                                                          , __FILE__
+                                                          );
+        }
+        unsigned int l_code_index = condition_table::code_index(p_candidate);
+        unsigned int l_criteria_index = 0;
+        while(l_criteria_index < m_criteria.size())
+        {
+            m_permutations[l_criteria_index] &= get_compliant_permutations(l_criteria_index, l_code_index, p_verifier_index, p_result);
+            if(m_permutations[l_criteria_index].none())
+            {
+                remove_criteria(l_criteria_index);
+            }
+            else
+            {
+                ++l_criteria_index;
+            }
+        }
+        display_remaining();
+    }
+
+    //-------------------------------------------------------------------------
+    std::pair<unsigned int, unsigned int>
+    nightmare_solver::evaluate_query(const candidate & p_candidate
+                                    ,unsigned int p_verifier_index
+                                    ) const
+    {
+        assert(p_verifier_index < m_checkers.size());
+        unsigned int l_code_index = condition_table::code_index(p_candidate);
+        unsigned int l_nb_true = 0;
+        unsigned int l_nb_total = 0;
+        for(unsigned int l_criteria_index = 0; l_criteria_index < m_criteria.size(); ++l_criteria_index)
+        {
+            l_nb_true += static_cast<unsigned int>((m_permutations[l_criteria_index] & get_compliant_permutations(l_criteria_index, l_code_index, p_verifier_index, true)).count());
+            l_nb_total += static_cast<unsigned int>(m_permutations[l_criteria_index].count());
+        }
+        return {l_nb_true, l_nb_total - l_nb_true};
+    }
+
+    //-------------------------------------------------------------------------
+    std::pair<candidate, unsigned int>
+    nightmare_solver::get_best_query() const
+    {
+        std::pair<candidate, unsigned int> l_result{condition_table::index_code(0), 0};
+        unsigned long long l_best_score = ~0ull;
+        for(unsigned int l_code_index = 0; l_code_index < condition_table::m_nb_codes; ++l_code_index)
+        {
+            candidate l_candidate = condition_table::index_code(l_code_index);
+            for(unsigned int l_verifier_index = 0; l_verifier_index < m_checkers.size(); ++l_verifier_index)
+            {
+                auto [l_nb_true, l_nb_false] = evaluate_query(l_candidate, l_verifier_index);
+                // Sum of squares is proportional to expected remaining states
+                unsigned long long l_score = static_cast<unsigned long long>(l_nb_true) * l_nb_true + static_cast<unsigned long long>(l_nb_false) * l_nb_false;
+                if(l_score < l_best_score)
+                {
+                    l_best_score = l_score;
+                    l_result = {l_candidate, l_verifier_index};
+                }
+            }
+        }
+        return l_result;
+    }
+
+    //-------------------------------------------------------------------------
+    unsigned int
+    nightmare_solver::get_possible_checkers(unsigned int p_verifier_index) const
+    {
+        assert(p_verifier_index < m_checkers.size());
+        permutation_set l_permutations;
+        for(const auto & l_iter: m_permutations)
+        {
+            l_permutations |= l_iter;
+        }
+        unsigned int l_result = 0;
+        for(unsigned int l_checker_index = 0; l_checker_index < m_checkers.size(); ++l_checker_index)
+        {
+            if((l_permutations & m_verifier_permutations[p_verifier_index][l_checker_index]).any())
+            {
+                l_result |= 1u << l_checker_index;
+            }
+        }
+        return l_result;
+    }
+
+    //-------------------------------------------------------------------------
+    void
+    nightmare_solver::display_remaining() const
+    {
+        if(!m_sink || !m_sink->is_enabled(verbosity::SUMMARY))
+        {
+            return;
+        }
+        m_sink->write_line(verbosity::SUMMARY, get_remaining_candidates(), " candidates remaining");
+        m_sink->write_line(verbosity::SUMMARY, get_remaining_states(), " verifier assignment and criteria combinations remaining");
+        for(unsigned int l_verifier_index = 0; l_verifier_index < m_checkers.size(); ++l_verifier_index)
+        {
+            m_sink->write(verbosity::SUMMARY, "Verifier ", l_verifier_index, " ->");
+            unsigned int l_possible = get_possible_checkers(l_verifier_index);
+            for(unsigned int l_checker_index = 0; l_checker_index < m_checkers.size(); ++l_checker_index)
+            {
+                if(l_possible & (1u << l_checker_index))
+                {
+                    m_sink->write(verbosity::SUMMARY, " ", m_checkers[l_checker_index]->get_id());
+                }
+            }
+            m_sink->write_line(verbosity::SUMMARY);
+        }
+        code_set l_codes = get_remaining_codes();
+        if(l_codes.count() == 1)
+        {
+            m_sink->write(verbosity::SUMMARY, "SOLUTION FOUND :");
+        }
+        for(unsigned int l_code_index = 0; l_code_index < condition_table::m_nb_codes; ++l_code_index)
+        {
+            if(l_codes.test(l_code_index))
+            {
+                m_sink->write_line(verbosity::SUMMARY, condition_table::index_code(l_code_index));
+            }
+        }
+        m_sink->flush();
+    }
+}
+#endif //TURING_MACHINE_SOLVER_NIGHTMARE_SOLVER_H
+// EOF
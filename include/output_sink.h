@@ -0,0 +1,192 @@
+/*    This file is part of turing_machine_solver
+      Copyright (C) 2024  Julien Thevenon ( julien_thevenon at yahoo.fr )
+
+      This program is free software: you can redistribute it and/or modify
+      it under the terms of the GNU General Public License as published by
+      the Free Software Foundation, either version 3 of the License, or
+      (at your option) any later version.
+
+      This program is distributed in the hope that it will be useful,
+      but WITHOUT ANY WARRANTY; without even the implied warranty of
+      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+      GNU General Public License for more details.
+
+      You should have received a copy of the GNU General Public License
+      along with this program.  If not, see <http://www.gnu.org/licenses/>
+*/
+
+#ifndef TURING_MACHINE_SOLVER_OUTPUT_SINK_H
+#define TURING_MACHINE_SOLVER_OUTPUT_SINK_H
+
+#include <iostream>
+#include <ostream>
+#include <sstream>
+
+namespace turing_machine_solver
+{
+    enum class verbosity {QUIET, SUMMARY, DEBUG};
+
+    /**
+     * Buffered destination of messages with a verbosity level. Messages of
+     * a disabled level are not formatted. Buffer is written to stream when
+     * it is full or flushed, so owner should flush at end of each report
+     * to keep order with other outputs. Not thread safe
+     */
+    class output_sink
+    {
+    public:
+        inline explicit
+        output_sink(std::ostream & p_stream
+                   ,verbosity p_level = verbosity::SUMMARY
+                   );
+
+        inline
+        ~output_sink();
+
+        output_sink(const output_sink &) = delete;
+
+        output_sink &
+        operator=(const output_sink &) = delete;
+
+        [[nodiscard]] inline
+        bool
+        is_enabled(verbosity p_level) const;
+
+        inline
+        void
+        set_level(verbosity p_level);
+
+        [[nodiscard]] inline
+        verbosity
+        get_level() const;
+
+        /**
+         * Write values followed by an end of line if level is enabled
+         */
+        template <typename... ARGS>
+        inline
+        void
+        write_line(verbosity p_level
+                  ,const ARGS & ... p_args
+                  );
+
+        /**
+         * Write values without end of line if level is enabled
+         */
+        template <typename... ARGS>
+        inline
+        void
+        write(verbosity p_level
+             ,const ARGS & ... p_args
+             );
+
+        inline
+        void
+        flush();
+
+        /**
+         * Sink writing on std::cout
+         */
+        [[nodiscard]] inline static
+        output_sink &
+        get_console();
+
+    private:
+
+        std::ostream & m_stream;
+
+        verbosity m_level;
+
+        std::ostringstream m_buffer;
+
+        static constexpr std::streamoff m_buffer_capacity = 64 * 1024;
+    };
+
+    //-------------------------------------------------------------------------
+    output_sink::output_sink(std::ostream & p_stream
+                            ,verbosity p_level
+                            )
+    :m_stream{p_stream}
+    ,m_level{p_level}
+    {
+    }
+
+    //-------------------------------------------------------------------------
+    output_sink::~output_sink()
+    {
+        flush();
+    }
+
+    //-------------------------------------------------------------------------
+    bool
+    output_sink::is_enabled(verbosity p_level) const
+    {
+        return verbosity::QUIET != p_level && p_level <= m_level;
+    }
+
+    //-------------------------------------------------------------------------
+    void
+    output_sink::set_level(verbosity p_level)
+    {
+        m_level = p_level;
+    }
+
+    //-------------------------------------------------------------------------
+    verbosity
+    output_sink::get_level() const
+    {
+        return m_level;
+    }
+
+    //-------------------------------------------------------------------------
+    template <typename... ARGS>
+    void
+    output_sink::write_line(verbosity p_level
+                           ,const ARGS & ... p_args
+                           )
+    {
+        if(is_enabled(p_level))
+        {
+            (m_buffer << ... << p_args) << '\n';
+            if(m_buffer.tellp() > m_buffer_capacity)
+            {
+                flush();
+            }
+        }
+    }
+
+    //-------------------------------------------------------------------------
+    template <typename... ARGS>
+    void
+    output_sink::write(verbosity p_level
+                      ,const ARGS & ... p_args
+                      )
+    {
+        if(is_enabled(p_level))
+        {
+            (m_buffer << ... << p_args);
+        }
+    }
+
+    //-------------------------------------------------------------------------
+    void
+    output_sink::flush()
+    {
+        if(m_buffer.tellp() > 0)
+        {
+            m_stream << m_buffer.view();
+            m_buffer.str("");
+        }
+        m_stream.flush();
+    }
+
+    //-------------------------------------------------------------------------
+    output_sink &
+    output_sink::get_console()
+    {
+        static output_sink l_console{std::cout};
+        return l_console;
+    }
+}
+#endif //TURING_MACHINE_SOLVER_OUTPUT_SINK_H
+// EOF
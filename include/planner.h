@@ -0,0 +1,316 @@
+/*    This file is part of turing_machine_solver
+      Copyright (C) 2024  Julien Thevenon ( julien_thevenon at yahoo.fr )
+
+      This program is free software: you can redistribute it and/or modify
+      it under the terms of the GNU General Public License as published by
+      the Free Software Foundation, either version 3 of the License, or
+      (at your option) any later version.
+
+      This program is distributed in the hope that it will be useful,
+      but WITHOUT ANY WARRANTY; without even the implied warranty of
+      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+      GNU General Public License for more details.
+
+      You should have received a copy of the GNU General Public License
+      along with this program.  If not, see <http://www.gnu.org/licenses/>
+*/
+
+#ifndef TURING_MACHINE_SOLVER_PLANNER_H
+#define TURING_MACHINE_SOLVER_PLANNER_H
+
+#include "criteria_space.h"
+#include "query_suggestion.h"
+#include "quicky_exception.h"
+#include <vector>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <cmath>
+
+namespace turing_machine_solver
+{
+    /**
+     * Suggest the query (code, checker) minimising expected number of
+     * remaining criteria. Exact mode evaluates every query on every
+     * criteria. Anytime mode works within a deadline: it starts from a cheap
+     * heuristic, screens queries on a sample of criteria then evaluates
+     * exactly the most promising ones until deadline. Sampled scores provide
+     * a lower bound of the optimal score holding with 95% confidence, hence
+     * an optimality gap estimate. Suggestion is only proved optimal when all
+     * queries are evaluated or ideal score is reached
+     */
+    class planner
+    {
+    public:
+        inline explicit
+        planner(const criteria_space & p_space
+               ,unsigned int p_seed = 0
+               );
+
+        [[nodiscard]] inline
+        query_suggestion
+        suggest(const std::vector<unsigned int> & p_criteria);
+
+        /**
+         * Suggest a query within a deadline
+         * @param p_criteria indexes of remaining criteria
+         * @param p_deadline time when best query found so far is returned
+         * @param p_codes codes that can be proposed
+         * @return best query found
+         */
+        [[nodiscard]] inline
+        query_suggestion
+        suggest(const std::vector<unsigned int> & p_criteria
+               ,std::chrono::steady_clock::time_point p_deadline
+               ,const code_set & p_codes = code_set().set()
+               );
+
+        /**
+         * Remove criteria not compliant with checker answer
+         * @param p_criteria indexes of criteria to filter
+         * @param p_code_index index of proposed code
+         * @param p_checker_index index of checker
+         * @param p_result checker answer
+         */
+        inline
+        void
+        filter(std::vector<unsigned int> & p_criteria
+              ,unsigned int p_code_index
+              ,unsigned int p_checker_index
+              ,bool p_result
+              ) const;
+
+        /**
+         * Number of criteria accepting a suggested query, ie remaining
+         * criteria if checker answer is true
+         */
+        [[nodiscard]] inline
+        unsigned int
+        count_accepted(const std::vector<unsigned int> & p_criteria
+                      ,const query_suggestion & p_suggestion
+                      ) const;
+
+        static constexpr unsigned int m_sample_size = 64;
+
+    private:
+
+        [[nodiscard]] inline
+        unsigned int
+        count_accepted(const std::vector<unsigned int> & p_criteria
+                      ,unsigned int p_query
+                      ) const;
+
+        /**
+         * Expected number of remaining criteria
+         * @param p_nb_criteria number of criteria
+         * @param p_ratio ratio of criteria accepting the query
+         */
+        [[nodiscard]] inline static
+        double
+        compute_score(double p_nb_criteria
+                     ,double p_ratio
+                     );
+
+        const criteria_space & m_space;
+
+        std::mt19937 m_random;
+    };
+
+    //-------------------------------------------------------------------------
+    planner::planner(const criteria_space & p_space
+                    ,unsigned int p_seed
+                    )
+    :m_space{p_space}
+    ,m_random{p_seed}
+    {
+    }
+
+    //-------------------------------------------------------------------------
+    unsigned int
+    planner::count_accepted(const std::vector<unsigned int> & p_criteria
+                           ,unsigned int p_query
+                           ) const
+    {
+        unsigned int l_code_index = p_query / m_space.get_nb_checkers();
+        unsigned int l_checker_index = p_query % m_space.get_nb_checkers();
+        unsigned int l_result = 0;
+        for(auto l_index: p_criteria)
+        {
+            l_result += m_space.is_accepted(l_index, l_checker_index, l_code_index);
+        }
+        return l_result;
+    }
+
+    //-------------------------------------------------------------------------
+    unsigned int
+    planner::count_accepted(const std::vector<unsigned int> & p_criteria
+                           ,const query_suggestion & p_suggestion
+                           ) const
+    {
+        return count_accepted(p_criteria, p_suggestion.get_code_index() * m_space.get_nb_checkers() + p_suggestion.get_checker_index());
+    }
+
+    //-------------------------------------------------------------------------
+    double
+    planner::compute_score(double p_nb_criteria
+                          ,double p_ratio
+                          )
+    {
+        return p_nb_criteria * (p_ratio * p_ratio + (1 - p_ratio) * (1 - p_ratio));
+    }
+
+    //-------------------------------------------------------------------------
+    void
+    planner::filter(std::vector<unsigned int> & p_criteria
+                   ,unsigned int p_code_index
+                   ,unsigned int p_checker_index
+                   ,bool p_result
+                   ) const
+    {
+        if(p_checker_index >= m_space.get_nb_checkers())
+        {
+            throw quicky_exception::quicky_logic_exception("Bad checker value " + std::to_string(p_checker_index), __LINE__, __FILE__);
+        }
+        std::erase_if(p_criteria
+                     ,[&](unsigned int p_index)
+                      {return m_space.is_accepted(p_index, p_checker_index, p_code_index) != p_result;}
+                     );
+    }
+
+    //-------------------------------------------------------------------------
+    query_suggestion
+    planner::suggest(const std::vector<unsigned int> & p_criteria)
+    {
+        return suggest(p_criteria, std::chrono::steady_clock::time_point::max());
+    }
+
+    //-------------------------------------------------------------------------
+    query_suggestion
+    planner::suggest(const std::vector<unsigned int> & p_criteria
+                    ,std::chrono::steady_clock::time_point p_deadline
+                    ,const code_set & p_codes
+                    )
+    {
+        if(p_criteria.empty())
+        {
+            throw quicky_exception::quicky_logic_exception("No criteria remaining", __LINE__, __FILE__);
+        }
+        if(p_codes.none())
+        {
+            throw quicky_exception::quicky_logic_exception("No code can be proposed", __LINE__, __FILE__);
+        }
+        unsigned int l_nb_checkers = m_space.get_nb_checkers();
+        unsigned int l_nb_queries = condition_table::m_nb_codes * l_nb_checkers;
+        auto l_nb_criteria = static_cast<double>(p_criteria.size());
+        // Best possible score is reached when answer splits criteria in halves
+        double l_ideal_score = compute_score(l_nb_criteria, std::floor(l_nb_criteria / 2) / l_nb_criteria);
+
+        std::vector<double> l_lower_bounds(l_nb_queries, l_ideal_score);
+        std::vector<bool> l_evaluated(l_nb_queries, false);
+        unsigned int l_nb_evaluated = 0;
+        unsigned int l_best_query = 0;
+        double l_best_score = l_nb_criteria + 1;
+
+        auto l_evaluate = [&](unsigned int p_query)
+        {
+            double l_score = compute_score(l_nb_criteria, count_accepted(p_criteria, p_query) / l_nb_criteria);
+            l_lower_bounds[p_query] = l_score;
+            l_evaluated[p_query] = true;
+            ++l_nb_evaluated;
+            if(l_score < l_best_score)
+            {
+                l_best_score = l_score;
+                l_best_query = p_query;
+            }
+        };
+
+        // Heuristic start: propose a code that is still a potential
+        // solution to every checker
+        unsigned int l_code_index = m_space.get_solution(p_criteria.front());
+        if(!p_codes.test(l_code_index))
+        {
+            l_code_index = condition_table::first_code(p_codes);
+        }
+        for(unsigned int l_checker_index = 0; l_checker_index < l_nb_checkers; ++l_checker_index)
+        {
+            l_evaluate(l_code_index * l_nb_checkers + l_checker_index);
+        }
+
+        // Screening of all queries on a sample of criteria
+        std::vector<unsigned int> l_sample{p_criteria};
+        std::shuffle(l_sample.begin(), l_sample.end(), m_random);
+        l_sample.resize(std::min<size_t>(l_sample.size(), m_sample_size));
+        std::vector<unsigned int> l_queries;
+        std::vector<double> l_estimations(l_nb_queries, l_nb_criteria);
+        for(unsigned int l_query = 0; l_query < l_nb_queries; ++l_query)
+        {
+            if(p_codes.test(l_query / l_nb_checkers))
+            {
+                l_queries.emplace_back(l_query);
+            }
+            else
+            {
+                // Forbidden queries are not taken into account
+                l_lower_bounds[l_query] = l_nb_criteria;
+                l_evaluated[l_query] = true;
+            }
+        }
+        l_nb_queries = static_cast<unsigned int>(l_queries.size());
+        std::shuffle(l_queries.begin(), l_queries.end(), m_random);
+        // Hoeffding inequality gives the confidence interval of accepted
+        // ratio, union bound over screened queries makes all intervals hold
+        // together with 95% confidence
+        double l_delta = l_sample.size() == p_criteria.size() ? 0 : std::sqrt(std::log(2 * l_nb_queries / 0.05) / (2.0 * l_sample.size()));
+        for(auto l_query: l_queries)
+        {
+            if(std::chrono::steady_clock::now() >= p_deadline)
+            {
+                break;
+            }
+            if(l_evaluated[l_query])
+            {
+                continue;
+            }
+            double l_ratio = count_accepted(l_sample, l_query) / static_cast<double>(l_sample.size());
+            l_estimations[l_query] = compute_score(l_nb_criteria, l_ratio);
+            double l_low = std::max(0.0, l_ratio - l_delta);
+            double l_high = std::min(1.0, l_ratio + l_delta);
+            l_lower_bounds[l_query] = (l_low <= 0.5 && 0.5 <= l_high) ? l_ideal_score : std::min(compute_score(l_nb_criteria, l_low), compute_score(l_nb_criteria, l_high));
+        }
+
+        // Exact evaluation of most promising queries first
+        std::stable_sort(l_queries.begin()
+                        ,l_queries.end()
+                        ,[&](unsigned int p_first, unsigned int p_second)
+                         {return l_estimations[p_first] < l_estimations[p_second];}
+                        );
+        for(auto l_query: l_queries)
+        {
+            if(l_best_score <= l_ideal_score || std::chrono::steady_clock::now() >= p_deadline)
+            {
+                break;
+            }
+            if(!l_evaluated[l_query])
+            {
+                l_evaluate(l_query);
+            }
+        }
+
+        double l_lower_bound = std::max(l_ideal_score, *std::min_element(l_lower_bounds.begin(), l_lower_bounds.end()));
+        // Once ideal score is reached remaining queries cannot do better
+        if(l_best_score <= l_ideal_score)
+        {
+            l_lower_bound = l_best_score;
+        }
+        return {l_best_query / l_nb_checkers
+               ,l_best_query % l_nb_checkers
+               ,l_best_score
+               ,l_lower_bound
+               ,l_ideal_score
+               ,l_nb_evaluated
+               ,l_nb_queries
+               };
+    }
+}
+#endif //TURING_MACHINE_SOLVER_PLANNER_H
+// EOF
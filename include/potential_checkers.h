@@ -20,26 +20,41 @@
 
 #include "quicky_exception.h"
 #include <cassert>
+#include <cstdint>
 #include <ostream>
-#include <vector>
+#include <array>
 #include <set>
-#include <sstream>
+#include <string>
 #include <algorithm>
 
 namespace turing_machine_solver
 {
+    /**
+     * Conditions satisfied by a code for each checker, stored as one
+     * bitfield per checker in a fixed size array so copies and
+     * comparisons never allocate
+     */
     class potential_checkers
     {
         friend std::ostream & operator<<(std::ostream &, const potential_checkers & );
 
     public:
+
+        static constexpr unsigned int m_max_checkers = 6;
+
+        static constexpr unsigned int m_max_conditions = 16;
+
         inline explicit
-        potential_checkers() = default;
+        potential_checkers();
 
         inline
         void
         add(std::set<unsigned int> && p_value);
 
+        [[nodiscard]] inline
+        unsigned int
+        get_nb_checkers() const;
+
         [[nodiscard]] inline
         bool
         is_valid() const;
@@ -57,14 +72,43 @@ namespace turing_machine_solver
 
     private:
 
-        std::vector<std::set<unsigned int>> m_content;
+        std::array<uint16_t, m_max_checkers> m_content;
+
+        uint8_t m_nb_checkers;
     };
 
+    //-------------------------------------------------------------------------
+    potential_checkers::potential_checkers()
+    :m_content{}
+    ,m_nb_checkers{0}
+    {
+    }
+
     //-------------------------------------------------------------------------
     void
     potential_checkers::add(std::set<unsigned int> && p_value)
     {
-        m_content.emplace_back(std::move(p_value));
+        if(m_nb_checkers == m_max_checkers)
+        {
+            throw quicky_exception::quicky_logic_exception("More than " + std::to_string(m_max_checkers) + " checkers", __LINE__, __FILE__);
+        }
+        uint16_t l_conditions = 0;
+        for(auto l_condition: p_value)
+        {
+            if(l_condition >= m_max_conditions)
+            {
+                throw quicky_exception::quicky_logic_exception("Bad condition index " + std::to_string(l_condition), __LINE__, __FILE__);
+            }
+            l_conditions |= static_cast<uint16_t>(1u << l_condition);
+        }
+        m_content[m_nb_checkers++] = l_conditions;
+    }
+
+    //-------------------------------------------------------------------------
+    unsigned int
+    potential_checkers::get_nb_checkers() const
+    {
+        return m_nb_checkers;
     }
 
     //-------------------------------------------------------------------------
@@ -72,9 +116,9 @@ namespace turing_machine_solver
     potential_checkers::is_valid() const
     {
         return std::all_of(m_content.begin()
-                          ,m_content.end()
-                          ,[](const std::set<unsigned int> & p_item)
-                             {return !p_item.empty();}
+                          ,m_content.begin() + m_nb_checkers
+                          ,[](uint16_t p_item)
+                             {return p_item;}
                           );
     }
 
@@ -85,30 +129,20 @@ namespace turing_machine_solver
                                          ,bool p_checker_result
                                          ) const
     {
-        assert(m_content.size() == p_checkers.m_content.size());
-        if(p_index < m_content.size())
+        assert(m_nb_checkers == p_checkers.m_nb_checkers);
+        if(p_index < m_nb_checkers)
         {
             if(m_content[p_index] == p_checkers.m_content[p_index])
             {
                 return p_checker_result;
             }
+            else if(!(m_content[p_index] & p_checkers.m_content[p_index]))
+            {
+                return !p_checker_result;
+            }
             else
             {
-                std::vector<unsigned int> l_intersection;
-                std::set_intersection(m_content[p_index].begin()
-                                     ,m_content[p_index].end()
-                                     ,p_checkers.m_content[p_index].begin()
-                                     ,p_checkers.m_content[p_index].end()
-                                     ,std::back_inserter(l_intersection)
-                                     );
-                if(l_intersection.empty())
-                {
-                    return !p_checker_result;
-                }
-                else
-                {
-                    return true;
-                }
+                return true;
             }
         }
         throw quicky_exception::quicky_logic_exception("Bad index " + std::to_string(p_index)
@@ -121,25 +155,9 @@ namespace turing_machine_solver
     bool
     potential_checkers::operator<(const potential_checkers & p_checkers) const
     {
-        assert(m_content.size() == p_checkers.m_content.size());
-        for(unsigned int l_index = 0; l_index < m_content.size(); l_index++)
-        {
-            if(!std::equal(m_content[l_index].begin()
-                          ,m_content[l_index].end()
-                          ,p_checkers.m_content[l_index].begin()
-                          ,p_checkers.m_content[l_index].end()
-                          )
-              )
-            {
-                return std::lexicographical_compare(m_content[l_index].begin()
-                                                   ,m_content[l_index].end()
-                                                   ,p_checkers.m_content[l_index].begin()
-                                                   ,p_checkers.m_content[l_index].end()
-                                                   );
-            }
-
-        }
-        return false;
+        assert(m_nb_checkers == p_checkers.m_nb_checkers);
+        // Unused bitfields are null so whole arrays can be compared
+        return m_content < p_checkers.m_content;
     }
 
     //-------------------------------------------------------------------------
@@ -148,28 +166,27 @@ namespace turing_machine_solver
               ,const potential_checkers & p_potential_checkers
               )
     {
-        for(const auto & l_iter: p_potential_checkers.m_content)
+        for(unsigned int l_index = 0; l_index < p_potential_checkers.m_nb_checkers; ++l_index)
         {
-            if(l_iter.size() == 1)
+            uint16_t l_conditions = p_potential_checkers.m_content[l_index];
+            if(!l_conditions)
             {
-                p_stream << *l_iter.begin();
+                p_stream << "-";
+                continue;
             }
-            else if(l_iter.size() > 1)
+            bool l_several = l_conditions & (l_conditions - 1);
+            p_stream << (l_several ? "(" : "");
+            for(unsigned int l_condition = 0; l_condition < potential_checkers::m_max_conditions; ++l_condition)
             {
-                p_stream << "(" ;
-                for(const auto & l_iter_value: l_iter)
+                if(l_conditions & (1u << l_condition))
                 {
-                    p_stream << l_iter_value;
+                    p_stream << l_condition;
                 }
-                p_stream << ")";
-            }
-            else
-            {
-                p_stream << "-";
             }
+            p_stream << (l_several ? ")" : "");
         }
         return p_stream;
     }
 }
 #endif //TURING_MACHINE_SOLVER_POTENTIAL_CHECKERS_H
-// EOF
\ No newline at end of file
+// EOF
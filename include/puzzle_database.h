@@ -0,0 +1,245 @@
+/*    This file is part of turing_machine_solver
+      Copyright (C) 2024  Julien Thevenon ( julien_thevenon at yahoo.fr )
+
+      This program is free software: you can redistribute it and/or modify
+      it under the terms of the GNU General Public License as published by
+      the Free Software Foundation, either version 3 of the License, or
+      (at your option) any later version.
+
+      This program is distributed in the hope that it will be useful,
+      but WITHOUT ANY WARRANTY; without even the implied warranty of
+      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+      GNU General Public License for more details.
+
+      You should have received a copy of the GNU General Public License
+      along with this program.  If not, see <http://www.gnu.org/licenses/>
+*/
+
+#ifndef TURING_MACHINE_SOLVER_PUZZLE_DATABASE_H
+#define TURING_MACHINE_SOLVER_PUZZLE_DATABASE_H
+
+#include "puzzle_record.h"
+#include "puzzle_enumerator.h"
+#include "quicky_exception.h"
+#include <vector>
+#include <string>
+#include <optional>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace turing_machine_solver
+{
+    /**
+     * Read only database of puzzles with a single solution. File is a 16
+     * bytes header ("TMDB", version, number of records) followed by
+     * puzzle_record entries sorted by key. It is memory mapped so opening
+     * does not parse anything and lookup is a binary search on mapped bytes
+     */
+    class puzzle_database
+    {
+    public:
+
+        inline explicit
+        puzzle_database(const std::string & p_file_name);
+
+        puzzle_database(const puzzle_database &) = delete;
+
+        puzzle_database &
+        operator=(const puzzle_database &) = delete;
+
+        inline
+        ~puzzle_database();
+
+        [[nodiscard]] inline
+        uint64_t
+        get_nb_records() const;
+
+        /**
+         * Search puzzle defined by a list of checkers
+         * @param p_checkers_id checker ids in any order
+         * @return record if puzzle is in database
+         */
+        [[nodiscard]] inline
+        std::optional<puzzle_record>
+        find(std::vector<unsigned int> p_checkers_id) const;
+
+        /**
+         * Build database from enumeration result files
+         * @param p_input_names enumeration result files
+         * @param p_output_name database file
+         * @return number of records
+         */
+        inline static
+        uint64_t
+        build(const std::vector<std::string> & p_input_names
+             ,const std::string & p_output_name
+             );
+
+        static constexpr uint32_t m_version = 1;
+
+    private:
+
+        static constexpr unsigned int m_header_size = 16;
+
+        int m_file_descriptor;
+
+        size_t m_size;
+
+        const uint8_t * m_content;
+
+        uint64_t m_nb_records;
+    };
+
+    //-------------------------------------------------------------------------
+    puzzle_database::puzzle_database(const std::string & p_file_name)
+    :m_file_descriptor{::open(p_file_name.c_str(), O_RDONLY)}
+    ,m_size{0}
+    ,m_content{nullptr}
+    ,m_nb_records{0}
+    {
+        if(m_file_descriptor < 0)
+        {
+            throw quicky_exception::quicky_runtime_exception("Unable to open " + p_file_name, __LINE__, __FILE__);
+        }
+        struct stat l_stat{};
+        if(fstat(m_file_descriptor, &l_stat) || static_cast<size_t>(l_stat.st_size) < m_header_size)
+        {
+            ::close(m_file_descriptor);
+            throw quicky_exception::quicky_runtime_exception(p_file_name + " is not a puzzle database", __LINE__, __FILE__);
+        }
+        m_size = static_cast<size_t>(l_stat.st_size);
+        void * l_content = mmap(nullptr, m_size, PROT_READ, MAP_SHARED, m_file_descriptor, 0);
+        if(MAP_FAILED == l_content)
+        {
+            ::close(m_file_descriptor);
+            throw quicky_exception::quicky_runtime_exception("Unable to map " + p_file_name, __LINE__, __FILE__);
+        }
+        m_content = static_cast<const uint8_t *>(l_content);
+        uint32_t l_version = 0;
+        for(unsigned int l_index = 0; l_index < 4; ++l_index)
+        {
+            l_version |= static_cast<uint32_t>(m_content[4 + l_index]) << (8 * l_index);
+        }
+        for(unsigned int l_index = 0; l_index < 8; ++l_index)
+        {
+            m_nb_records |= static_cast<uint64_t>(m_content[8 + l_index]) << (8 * l_index);
+        }
+        // Number of records is bounded before multiplication so a crafted
+        // header cannot wrap size computation
+        if(std::memcmp(m_content, "TMDB", 4) || m_version != l_version
+           || m_nb_records > (m_size - m_header_size) / puzzle_record::m_size
+           || m_size != m_header_size + m_nb_records * puzzle_record::m_size
+          )
+        {
+            munmap(const_cast<uint8_t *>(m_content), m_size);
+            ::close(m_file_descriptor);
+            throw quicky_exception::quicky_runtime_exception(p_file_name + " is not a puzzle database", __LINE__, __FILE__);
+        }
+    }
+
+    //-------------------------------------------------------------------------
+    puzzle_database::~puzzle_database()
+    {
+        munmap(const_cast<uint8_t *>(m_content), m_size);
+        ::close(m_file_descriptor);
+    }
+
+    //-------------------------------------------------------------------------
+    uint64_t
+    puzzle_database::get_nb_records() const
+    {
+        return m_nb_records;
+    }
+
+    //-------------------------------------------------------------------------
+    std::optional<puzzle_record>
+    puzzle_database::find(std::vector<unsigned int> p_checkers_id) const
+    {
+        std::sort(p_checkers_id.begin(), p_checkers_id.end());
+        if(p_checkers_id.size() > puzzle_record::m_max_checkers
+           || std::adjacent_find(p_checkers_id.begin(), p_checkers_id.end()) != p_checkers_id.end()
+           || std::any_of(p_checkers_id.begin(), p_checkers_id.end(), [](unsigned int p_id){return !p_id || p_id > 255;})
+          )
+        {
+            return std::nullopt;
+        }
+        puzzle_record::key_t l_key = puzzle_record::make_key(p_checkers_id);
+        uint64_t l_begin = 0;
+        uint64_t l_end = m_nb_records;
+        while(l_begin < l_end)
+        {
+            uint64_t l_middle = l_begin + (l_end - l_begin) / 2;
+            const uint8_t * l_record = m_content + m_header_size + l_middle * puzzle_record::m_size;
+            int l_compare = std::memcmp(l_record, l_key.data(), l_key.size());
+            if(!l_compare)
+            {
+                return puzzle_record::deserialize(l_record);
+            }
+            if(l_compare < 0)
+            {
+                l_begin = l_middle + 1;
+            }
+            else
+            {
+                l_end = l_middle;
+            }
+        }
+        return std::nullopt;
+    }
+
+    //-------------------------------------------------------------------------
+    uint64_t
+    puzzle_database::build(const std::vector<std::string> & p_input_names
+                          ,const std::string & p_output_name
+                          )
+    {
+        std::vector<puzzle_record> l_records;
+        for(const auto & l_input_name: p_input_names)
+        {
+            std::vector<puzzle_record> l_file_records = puzzle_enumerator::read_records(l_input_name);
+            l_records.insert(l_records.end(), l_file_records.begin(), l_file_records.end());
+        }
+        auto l_compare = [](const puzzle_record & p_first, const puzzle_record & p_second)
+        {
+            return p_first.get_key() < p_second.get_key();
+        };
+        std::sort(l_records.begin(), l_records.end(), l_compare);
+        // Shards can be merged several times
+        l_records.erase(std::unique(l_records.begin()
+                                   ,l_records.end()
+                                   ,[](const puzzle_record & p_first, const puzzle_record & p_second)
+                                    {return p_first.get_key() == p_second.get_key();}
+                                   )
+                       ,l_records.end()
+                       );
+
+        std::vector<uint8_t> l_content(m_header_size + l_records.size() * puzzle_record::m_size);
+        std::memcpy(l_content.data(), "TMDB", 4);
+        for(unsigned int l_index = 0; l_index < 4; ++l_index)
+        {
+            l_content[4 + l_index] = static_cast<uint8_t>(m_version >> (8 * l_index));
+        }
+        for(unsigned int l_index = 0; l_index < 8; ++l_index)
+        {
+            l_content[8 + l_index] = static_cast<uint8_t>(static_cast<uint64_t>(l_records.size()) >> (8 * l_index));
+        }
+        for(size_t l_index = 0; l_index < l_records.size(); ++l_index)
+        {
+            l_records[l_index].serialize(&l_content[m_header_size + l_index * puzzle_record::m_size]);
+        }
+        std::ofstream l_output_file{p_output_name, std::ios::binary | std::ios::trunc};
+        if(!l_output_file.is_open())
+        {
+            throw quicky_exception::quicky_runtime_exception("Unable to open " + p_output_name, __LINE__, __FILE__);
+        }
+        l_output_file.write(reinterpret_cast<const char *>(l_content.data()), static_cast<std::streamsize>(l_content.size()));
+        return l_records.size();
+    }
+}
+#endif //TURING_MACHINE_SOLVER_PUZZLE_DATABASE_H
+// EOF
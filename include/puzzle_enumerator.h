@@ -0,0 +1,631 @@
+/*    This file is part of turing_machine_solver
+      Copyright (C) 2024  Julien Thevenon ( julien_thevenon at yahoo.fr )
+
+      This program is free software: you can redistribute it and/or modify
+      it under the terms of the GNU General Public License as published by
+      the Free Software Foundation, either version 3 of the License, or
+      (at your option) any later version.
+
+      This program is distributed in the hope that it will be useful,
+      but WITHOUT ANY WARRANTY; without even the implied warranty of
+      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+      GNU General Public License for more details.
+
+      You should have received a copy of the GNU General Public License
+      along with this program.  If not, see <http://www.gnu.org/licenses/>
+*/
+
+#ifndef TURING_MACHINE_SOLVER_PUZZLE_ENUMERATOR_H
+#define TURING_MACHINE_SOLVER_PUZZLE_ENUMERATOR_H
+
+#include "solver.h"
+#include "condition_table.h"
+#include "puzzle_record.h"
+#include "work_stealing_pool.h"
+#include "quicky_exception.h"
+#include <vector>
+#include <array>
+#include <optional>
+#include <algorithm>
+#include <fstream>
+#include <filesystem>
+#include <iterator>
+#include <mutex>
+#include <functional>
+#include <limits>
+#include <string>
+#include <cassert>
+#include <iostream>
+
+namespace turing_machine_solver
+{
+    /**
+     * Enumerate combinations of checkers having exactly one solution, ie
+     * combinations for which solver would report a single remaining
+     * candidate right after construction. Instead of building a solver,
+     * each combination is analysed with precomputed condition bitfields.
+     * Combinations are ranked in lexicographic order, size by size, so that
+     * work can be split in shards. Result file of a shard is a header
+     * followed by blocks, one per chunk of combinations, and is also used as
+     * checkpoint: completed chunks are skipped when run is resumed. Header
+     * stores checker ids and a hash of their conditions so that a run is
+     * not resumed with other checkers or card definitions
+     */
+    class puzzle_enumerator
+    {
+    public:
+        /**
+         * @param p_checkers_id ids of checkers that can be combined
+         * @param p_min_size minimal number of checkers in a combination
+         * @param p_max_size maximal number of checkers in a combination
+         */
+        inline
+        puzzle_enumerator(const std::vector<unsigned int> & p_checkers_id
+                         ,unsigned int p_min_size = 4
+                         ,unsigned int p_max_size = 6
+                         );
+
+        [[nodiscard]] inline static
+        uint64_t
+        binomial(unsigned int p_n
+                ,unsigned int p_k
+                );
+
+        /**
+         * Total number of combinations of all sizes
+         */
+        [[nodiscard]] inline
+        uint64_t
+        get_nb_combinations() const;
+
+        /**
+         * Ids of checkers of combination with this rank
+         */
+        [[nodiscard]] inline
+        std::vector<unsigned int>
+        unrank(uint64_t p_rank) const;
+
+        /**
+         * Rank of a combination of checkers ids in increasing order
+         */
+        [[nodiscard]] inline
+        uint64_t
+        rank(const std::vector<unsigned int> & p_checkers_id) const;
+
+        /**
+         * Check if a combination has exactly one solution
+         * @param p_checkers_id ids of checkers in increasing order
+         * @return record describing solution if any
+         */
+        [[nodiscard]] inline
+        std::optional<puzzle_record>
+        analyze(const std::vector<unsigned int> & p_checkers_id) const;
+
+        /**
+         * Enumerate combinations of a shard
+         * @param p_shard index of shard in [0, p_nb_shards[
+         * @param p_nb_shards number of shards
+         * @param p_output_name name of result file
+         * @param p_nb_threads number of threads, 0 means hardware concurrency
+         */
+        inline
+        void
+        run(unsigned int p_shard
+           ,unsigned int p_nb_shards
+           ,const std::string & p_output_name
+           ,unsigned int p_nb_threads = 0
+           ) const;
+
+        /**
+         * Read records of a result file
+         */
+        [[nodiscard]] inline static
+        std::vector<puzzle_record>
+        read_records(const std::string & p_file_name);
+
+        static constexpr uint64_t m_chunk_size = 4096;
+
+        static constexpr uint32_t m_version = 2;
+
+    private:
+
+        /**
+         * Maximal number of conditions of a checker so that conditions of
+         * all checkers of a combination fit in 64 bits
+         */
+        static constexpr unsigned int m_max_grade = 64 / puzzle_record::m_max_checkers;
+
+        /**
+         * Position of catalogue hash in header, followed by number of
+         * checkers
+         */
+        static constexpr unsigned int m_catalogue_hash_position = 28;
+
+        /**
+         * Header size without checker ids, which use one byte each
+         */
+        static constexpr unsigned int m_header_size = m_catalogue_hash_position + 12;
+
+        /**
+         * Size of header of a result file, 0 if content is not a result
+         * file of current version
+         */
+        [[nodiscard]] inline static
+        size_t
+        get_header_size(const std::vector<uint8_t> & p_content);
+
+        static constexpr unsigned int m_block_header_size = 12;
+
+        inline static
+        void
+        write_uint(std::vector<uint8_t> & p_buffer
+                  ,uint64_t p_value
+                  ,unsigned int p_nb_bytes
+                  );
+
+        [[nodiscard]] inline static
+        uint64_t
+        read_uint(const uint8_t * p_buffer
+                 ,unsigned int p_nb_bytes
+                 );
+
+        /**
+         * Parse result file content
+         * @param p_content file content
+         * @param p_header_size size of header of file
+         * @param p_func called for each complete block with chunk index,
+         * number of records and pointer on first record
+         * @return size of valid content
+         */
+        inline static
+        size_t
+        parse(const std::vector<uint8_t> & p_content
+             ,size_t p_header_size
+             ,const std::function<void(uint64_t, uint32_t, const uint8_t *)> & p_func
+             );
+
+        std::vector<unsigned int> m_checkers_id;
+
+        /**
+         * For each checker, bitfield of conditions satisfied by each code
+         */
+        std::vector<std::array<uint16_t, condition_table::m_nb_codes>> m_conditions;
+
+        /**
+         * FNV-1a hash of checker ids and of their conditions bitfields
+         */
+        uint64_t m_catalogue_hash;
+
+        unsigned int m_min_size;
+
+        unsigned int m_max_size;
+    };
+
+    //-------------------------------------------------------------------------
+    puzzle_enumerator::puzzle_enumerator(const std::vector<unsigned int> & p_checkers_id
+                                        ,unsigned int p_min_size
+                                        ,unsigned int p_max_size
+                                        )
+    :m_checkers_id{p_checkers_id}
+    ,m_catalogue_hash{14695981039346656037ull}
+    ,m_min_size{p_min_size}
+    ,m_max_size{p_max_size}
+    {
+        std::sort(m_checkers_id.begin(), m_checkers_id.end());
+        if(!m_min_size || m_min_size > m_max_size || m_max_size > puzzle_record::m_max_checkers || m_max_size > m_checkers_id.size())
+        {
+            throw quicky_exception::quicky_logic_exception("Bad combination sizes [" + std::to_string(m_min_size) + "," + std::to_string(m_max_size) + "]", __LINE__, __FILE__);
+        }
+        auto l_hash = [&](uint64_t p_value)
+        {
+            m_catalogue_hash = (m_catalogue_hash ^ p_value) * 1099511628211ull;
+        };
+        for(auto l_id: m_checkers_id)
+        {
+            if(l_id > std::numeric_limits<uint8_t>::max())
+            {
+                throw quicky_exception::quicky_logic_exception("Checker id " + std::to_string(l_id) + " does not fit in result file header", __LINE__, __FILE__);
+            }
+            auto l_checker = solver::get_checker(l_id);
+            if(l_checker->get_grade() > m_max_grade)
+            {
+                throw quicky_exception::quicky_logic_exception("Checker " + std::to_string(l_id) + " has too many conditions", __LINE__, __FILE__);
+            }
+            std::array<uint16_t, condition_table::m_nb_codes> l_conditions{};
+            for(unsigned int l_condition_index = 0; l_condition_index < l_checker->get_grade(); ++l_condition_index)
+            {
+                code_set l_mask = condition_table::compute_mask(*l_checker, l_condition_index);
+                for(unsigned int l_code_index = 0; l_code_index < condition_table::m_nb_codes; ++l_code_index)
+                {
+                    l_conditions[l_code_index] |= static_cast<uint16_t>(l_mask.test(l_code_index) << l_condition_index);
+                }
+            }
+            m_conditions.emplace_back(l_conditions);
+            l_hash(l_id);
+            for(auto l_code_conditions: l_conditions)
+            {
+                l_hash(l_code_conditions);
+            }
+        }
+    }
+
+    //-------------------------------------------------------------------------
+    uint64_t
+    puzzle_enumerator::binomial(unsigned int p_n
+                               ,unsigned int p_k
+                               )
+    {
+        if(p_k > p_n)
+        {
+            return 0;
+        }
+        uint64_t l_result = 1;
+        for(unsigned int l_index = 1; l_index <= p_k; ++l_index)
+        {
+            l_result = l_result * (p_n - p_k + l_index) / l_index;
+        }
+        return l_result;
+    }
+
+    //-------------------------------------------------------------------------
+    uint64_t
+    puzzle_enumerator::get_nb_combinations() const
+    {
+        uint64_t l_result = 0;
+        for(unsigned int l_size = m_min_size; l_size <= m_max_size; ++l_size)
+        {
+            l_result += binomial(static_cast<unsigned int>(m_checkers_id.size()), l_size);
+        }
+        return l_result;
+    }
+
+    //-------------------------------------------------------------------------
+    std::vector<unsigned int>
+    puzzle_enumerator::unrank(uint64_t p_rank) const
+    {
+        auto l_n = static_cast<unsigned int>(m_checkers_id.size());
+        unsigned int l_size = m_min_size;
+        while(l_size <= m_max_size && p_rank >= binomial(l_n, l_size))
+        {
+            p_rank -= binomial(l_n, l_size);
+            ++l_size;
+        }
+        if(l_size > m_max_size)
+        {
+            throw quicky_exception::quicky_logic_exception("Rank out of range", __LINE__, __FILE__);
+        }
+        std::vector<unsigned int> l_result;
+        unsigned int l_position = 0;
+        for(unsigned int l_index = 0; l_index < l_size; ++l_index)
+        {
+            // Skip all combinations starting with smaller elements
+            while(p_rank >= binomial(l_n - 1 - l_position, l_size - 1 - l_index))
+            {
+                p_rank -= binomial(l_n - 1 - l_position, l_size - 1 - l_index);
+                ++l_position;
+            }
+            l_result.emplace_back(m_checkers_id[l_position]);
+            ++l_position;
+        }
+        return l_result;
+    }
+
+    //-------------------------------------------------------------------------
+    uint64_t
+    puzzle_enumerator::rank(const std::vector<unsigned int> & p_checkers_id) const
+    {
+        auto l_n = static_cast<unsigned int>(m_checkers_id.size());
+        auto l_size = static_cast<unsigned int>(p_checkers_id.size());
+        if(l_size < m_min_size || l_size > m_max_size)
+        {
+            throw quicky_exception::quicky_logic_exception("Bad combination size " + std::to_string(l_size), __LINE__, __FILE__);
+        }
+        uint64_t l_result = 0;
+        for(unsigned int l_smaller_size = m_min_size; l_smaller_size < l_size; ++l_smaller_size)
+        {
+            l_result += binomial(l_n, l_smaller_size);
+        }
+        unsigned int l_position = 0;
+        for(unsigned int l_index = 0; l_index < l_size; ++l_index)
+        {
+            auto l_iter = std::lower_bound(m_checkers_id.begin(), m_checkers_id.end(), p_checkers_id[l_index]);
+            if(m_checkers_id.end() == l_iter || *l_iter != p_checkers_id[l_index])
+            {
+                throw quicky_exception::quicky_logic_exception("Unknown checker " + std::to_string(p_checkers_id[l_index]), __LINE__, __FILE__);
+            }
+            auto l_element = static_cast<unsigned int>(l_iter - m_checkers_id.begin());
+            if(l_element < l_position)
+            {
+                throw quicky_exception::quicky_logic_exception("Checker ids must be increasing", __LINE__, __FILE__);
+            }
+            for(; l_position < l_element; ++l_position)
+            {
+                l_result += binomial(l_n - 1 - l_position, l_size - 1 - l_index);
+            }
+            ++l_position;
+        }
+        return l_result;
+    }
+
+    //-------------------------------------------------------------------------
+    std::optional<puzzle_record>
+    puzzle_enumerator::analyze(const std::vector<unsigned int> & p_checkers_id) const
+    {
+        std::vector<const std::array<uint16_t, condition_table::m_nb_codes> *> l_conditions;
+        for(auto l_id: p_checkers_id)
+        {
+            auto l_iter = std::lower_bound(m_checkers_id.begin(), m_checkers_id.end(), l_id);
+            assert(l_iter != m_checkers_id.end() && *l_iter == l_id);
+            l_conditions.emplace_back(&m_conditions[l_iter - m_checkers_id.begin()]);
+        }
+
+        // Same rules as solver: a code is kept if it satisfies at least one
+        // condition of each checker and if no other kept code satisfies
+        // exactly the same conditions. Conditions of all checkers are packed
+        // in a 64 bits key, m_max_grade bits per checker
+        std::array<std::pair<uint64_t, unsigned int>, condition_table::m_nb_codes> l_keys;
+        unsigned int l_nb_keys = 0;
+        for(unsigned int l_code_index = 0; l_code_index < condition_table::m_nb_codes; ++l_code_index)
+        {
+            uint64_t l_key = 0;
+            bool l_valid = true;
+            for(unsigned int l_index = 0; l_valid && l_index < l_conditions.size(); ++l_index)
+            {
+                uint16_t l_code_conditions = (*l_conditions[l_index])[l_code_index];
+                l_valid = l_code_conditions;
+                l_key = (l_key << m_max_grade) | l_code_conditions;
+            }
+            if(l_valid)
+            {
+                l_keys[l_nb_keys++] = {l_key, l_code_index};
+            }
+        }
+        std::sort(l_keys.begin(), l_keys.begin() + l_nb_keys);
+        std::optional<unsigned int> l_solution;
+        unsigned int l_index = 0;
+        while(l_index < l_nb_keys)
+        {
+            unsigned int l_next = l_index + 1;
+            while(l_next < l_nb_keys && l_keys[l_next].first == l_keys[l_index].first)
+            {
+                ++l_next;
+            }
+            if(l_next == l_index + 1)
+            {
+                if(l_solution)
+                {
+                    return std::nullopt;
+                }
+                l_solution = l_keys[l_index].second;
+            }
+            l_index = l_next;
+        }
+        if(!l_solution)
+        {
+            return std::nullopt;
+        }
+        std::vector<uint16_t> l_solution_conditions;
+        for(auto l_iter: l_conditions)
+        {
+            l_solution_conditions.emplace_back((*l_iter)[*l_solution]);
+        }
+        return puzzle_record{p_checkers_id, *l_solution, l_solution_conditions};
+    }
+
+    //-------------------------------------------------------------------------
+    void
+    puzzle_enumerator::write_uint(std::vector<uint8_t> & p_buffer
+                                 ,uint64_t p_value
+                                 ,unsigned int p_nb_bytes
+                                 )
+    {
+        for(unsigned int l_index = 0; l_index < p_nb_bytes; ++l_index)
+        {
+            p_buffer.emplace_back(static_cast<uint8_t>(p_value >> (8 * l_index)));
+        }
+    }
+
+    //-------------------------------------------------------------------------
+    uint64_t
+    puzzle_enumerator::read_uint(const uint8_t * p_buffer
+                                ,unsigned int p_nb_bytes
+                                )
+    {
+        uint64_t l_result = 0;
+        for(unsigned int l_index = 0; l_index < p_nb_bytes; ++l_index)
+        {
+            l_result |= static_cast<uint64_t>(p_buffer[l_index]) << (8 * l_index);
+        }
+        return l_result;
+    }
+
+    //-------------------------------------------------------------------------
+    size_t
+    puzzle_enumerator::get_header_size(const std::vector<uint8_t> & p_content)
+    {
+        if(p_content.size() < m_header_size || std::string(p_content.begin(), p_content.begin() + 4) != "TMSE" || read_uint(&p_content[4], 4) != m_version)
+        {
+            return 0;
+        }
+        size_t l_size = m_header_size + read_uint(&p_content[m_catalogue_hash_position + 8], 4);
+        return l_size <= p_content.size() ? l_size : 0;
+    }
+
+    //-------------------------------------------------------------------------
+    size_t
+    puzzle_enumerator::parse(const std::vector<uint8_t> & p_content
+                            ,size_t p_header_size
+                            ,const std::function<void(uint64_t, uint32_t, const uint8_t *)> & p_func
+                            )
+    {
+        size_t l_position = p_header_size;
+        while(l_position + m_block_header_size <= p_content.size())
+        {
+            uint64_t l_chunk = read_uint(&p_content[l_position], 8);
+            auto l_nb_records = static_cast<uint32_t>(read_uint(&p_content[l_position + 8], 4));
+            size_t l_end = l_position + m_block_header_size + static_cast<size_t>(l_nb_records) * puzzle_record::m_size;
+            if(l_end > p_content.size())
+            {
+                break;
+            }
+            p_func(l_chunk, l_nb_records, p_content.data() + l_position + m_block_header_size);
+            l_position = l_end;
+        }
+        return l_position;
+    }
+
+    //-------------------------------------------------------------------------
+    std::vector<puzzle_record>
+    puzzle_enumerator::read_records(const std::string & p_file_name)
+    {
+        std::ifstream l_file{p_file_name, std::ios::binary};
+        if(!l_file.is_open())
+        {
+            throw quicky_exception::quicky_runtime_exception("Unable to open " + p_file_name, __LINE__, __FILE__);
+        }
+        std::vector<uint8_t> l_content{std::istreambuf_iterator<char>(l_file), std::istreambuf_iterator<char>()};
+        size_t l_header_size = get_header_size(l_content);
+        if(!l_header_size)
+        {
+            throw quicky_exception::quicky_runtime_exception(p_file_name + " is not an enumeration result of version " + std::to_string(m_version), __LINE__, __FILE__);
+        }
+        std::vector<puzzle_record> l_result;
+        parse(l_content
+             ,l_header_size
+             ,[&](uint64_t, uint32_t p_nb_records, const uint8_t * p_records)
+              {
+                  for(uint32_t l_index = 0; l_index < p_nb_records; ++l_index)
+                  {
+                      l_result.emplace_back(puzzle_record::deserialize(p_records + l_index * puzzle_record::m_size));
+                  }
+              }
+             );
+        return l_result;
+    }
+
+    //-------------------------------------------------------------------------
+    void
+    puzzle_enumerator::run(unsigned int p_shard
+                          ,unsigned int p_nb_shards
+                          ,const std::string & p_output_name
+                          ,unsigned int p_nb_threads
+                          ) const
+    {
+        if(p_shard >= p_nb_shards)
+        {
+            throw quicky_exception::quicky_logic_exception("Bad shard " + std::to_string(p_shard) + "/" + std::to_string(p_nb_shards), __LINE__, __FILE__);
+        }
+        uint64_t l_nb_combinations = get_nb_combinations();
+        uint64_t l_begin = l_nb_combinations * p_shard / p_nb_shards;
+        uint64_t l_end = l_nb_combinations * (p_shard + 1) / p_nb_shards;
+        uint64_t l_nb_chunks = (l_end - l_begin + m_chunk_size - 1) / m_chunk_size;
+
+        std::vector<uint8_t> l_header;
+        l_header.insert(l_header.end(), {'T', 'M', 'S', 'E'});
+        write_uint(l_header, m_version, 4);
+        write_uint(l_header, p_shard, 4);
+        write_uint(l_header, p_nb_shards, 4);
+        write_uint(l_header, l_nb_combinations, 8);
+        write_uint(l_header, puzzle_record::m_size, 4);
+        write_uint(l_header, m_catalogue_hash, 8);
+        write_uint(l_header, m_checkers_id.size(), 4);
+        assert(l_header.size() == m_header_size);
+        for(auto l_id: m_checkers_id)
+        {
+            write_uint(l_header, l_id, 1);
+        }
+
+        // Resume from previous run if any
+        std::vector<bool> l_done(l_nb_chunks, false);
+        uint64_t l_nb_found = 0;
+        if(std::filesystem::exists(p_output_name))
+        {
+            std::ifstream l_file{p_output_name, std::ios::binary};
+            std::vector<uint8_t> l_content{std::istreambuf_iterator<char>(l_file), std::istreambuf_iterator<char>()};
+            l_file.close();
+            // Content shorter than header is an interrupted header write
+            if(l_content.size() >= l_header.size())
+            {
+                if(get_header_size(l_content) != l_header.size() || !std::equal(l_header.begin(), l_header.begin() + m_catalogue_hash_position, l_content.begin()) || !std::equal(l_header.begin() + m_catalogue_hash_position + 8, l_header.end(), l_content.begin() + m_catalogue_hash_position + 8))
+                {
+                    throw quicky_exception::quicky_runtime_exception(p_output_name + " was produced by another enumeration", __LINE__, __FILE__);
+                }
+                if(read_uint(&l_content[m_catalogue_hash_position], 8) != m_catalogue_hash)
+                {
+                    throw quicky_exception::quicky_runtime_exception(p_output_name + " was produced with other card definitions", __LINE__, __FILE__);
+                }
+            }
+            size_t l_valid_size = 0;
+            if(l_content.size() >= l_header.size())
+            {
+                l_valid_size = parse(l_content
+                                    ,l_header.size()
+                                    ,[&](uint64_t p_chunk, uint32_t p_nb_records, const uint8_t *)
+                                     {
+                                         if(p_chunk < l_nb_chunks)
+                                         {
+                                             l_done[p_chunk] = true;
+                                             l_nb_found += p_nb_records;
+                                         }
+                                     }
+                                    );
+            }
+            std::filesystem::resize_file(p_output_name, l_valid_size);
+        }
+
+        std::ofstream l_output_file{p_output_name, std::ios::binary | std::ios::app};
+        if(!l_output_file.is_open())
+        {
+            throw quicky_exception::quicky_runtime_exception("Unable to open " + p_output_name, __LINE__, __FILE__);
+        }
+        if(!std::filesystem::file_size(p_output_name))
+        {
+            l_output_file.write(reinterpret_cast<const char *>(l_header.data()), static_cast<std::streamsize>(l_header.size()));
+            l_output_file.flush();
+        }
+
+        std::vector<size_t> l_tasks;
+        for(uint64_t l_chunk = 0; l_chunk < l_nb_chunks; ++l_chunk)
+        {
+            if(!l_done[l_chunk])
+            {
+                l_tasks.emplace_back(l_chunk);
+            }
+        }
+        std::cout << "Shard " << p_shard << "/" << p_nb_shards << ": combinations [" << l_begin << "," << l_end << "[, ";
+        std::cout << l_nb_chunks - l_tasks.size() << "/" << l_nb_chunks << " chunks already done" << std::endl;
+
+        std::mutex l_output_mutex;
+        work_stealing_pool l_pool{p_nb_threads};
+        l_pool.run(l_tasks
+                  ,[&](size_t p_chunk, unsigned int)
+                   {
+                       std::vector<uint8_t> l_block;
+                       write_uint(l_block, p_chunk, 8);
+                       write_uint(l_block, 0, 4);
+                       uint32_t l_nb_records = 0;
+                       uint64_t l_chunk_end = std::min(l_end, l_begin + (p_chunk + 1) * m_chunk_size);
+                       for(uint64_t l_rank = l_begin + p_chunk * m_chunk_size; l_rank < l_chunk_end; ++l_rank)
+                       {
+                           if(auto l_record = analyze(unrank(l_rank)))
+                           {
+                               l_block.resize(l_block.size() + puzzle_record::m_size);
+                               l_record->serialize(&l_block[l_block.size() - puzzle_record::m_size]);
+                               ++l_nb_records;
+                           }
+                       }
+                       for(unsigned int l_index = 0; l_index < 4; ++l_index)
+                       {
+                           l_block[8 + l_index] = static_cast<uint8_t>(l_nb_records >> (8 * l_index));
+                       }
+                       std::lock_guard<std::mutex> l_lock(l_output_mutex);
+                       l_output_file.write(reinterpret_cast<const char *>(l_block.data()), static_cast<std::streamsize>(l_block.size()));
+                       l_output_file.flush();
+                       l_nb_found += l_nb_records;
+                   }
+                  );
+        std::cout << "Shard " << p_shard << "/" << p_nb_shards << ": " << l_nb_found << " combinations with a single solution" << std::endl;
+    }
+}
+#endif //TURING_MACHINE_SOLVER_PUZZLE_ENUMERATOR_H
+// EOF
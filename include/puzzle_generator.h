@@ -0,0 +1,380 @@
+/*    This file is part of turing_machine_solver
+      Copyright (C) 2024  Julien Thevenon ( julien_thevenon at yahoo.fr )
+
+      This program is free software: you can redistribute it and/or modify
+      it under the terms of the GNU General Public License as published by
+      the Free Software Foundation, either version 3 of the License, or
+      (at your option) any later version.
+
+      This program is distributed in the hope that it will be useful,
+      but WITHOUT ANY WARRANTY; without even the implied warranty of
+      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+      GNU General Public License for more details.
+
+      You should have received a copy of the GNU General Public License
+      along with this program.  If not, see <http://www.gnu.org/licenses/>
+*/
+
+#ifndef TURING_MACHINE_SOLVER_PUZZLE_GENERATOR_H
+#define TURING_MACHINE_SOLVER_PUZZLE_GENERATOR_H
+
+#include "solver.h"
+#include "condition_table.h"
+#include "criteria_space.h"
+#include "difficulty_rater.h"
+#include "puzzle_record.h"
+#include "quicky_exception.h"
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <ostream>
+#include <random>
+#include <vector>
+
+namespace turing_machine_solver
+{
+    /**
+     * Puzzle drawn by puzzle_generator: checkers in increasing id order and
+     * condition index of each checker
+     */
+    class random_puzzle
+    {
+        friend std::ostream & operator<<(std::ostream &, const random_puzzle & );
+
+    public:
+        std::vector<unsigned int> m_checkers_id;
+
+        std::vector<unsigned int> m_criteria;
+
+        /**
+         * Index of the only code satisfying criteria
+         */
+        unsigned int m_code_index;
+
+        /**
+         * Expected number of checks of difficulty_rater greedy strategy,
+         * which does not use the fact that criteria is unique
+         */
+        double m_difficulty;
+    };
+
+    /**
+     * Draw random puzzles: a checker set having a single criteria that
+     * selects exactly one code with each checker being needed. Criteria
+     * of a drawn checker set are searched with AND and popcount of
+     * precomputed condition masks, the search stopping at the second one,
+     * and only puzzles passing it are rated
+     */
+    class puzzle_generator
+    {
+    public:
+        /**
+         * @param p_seed seed of random generator, same seed gives same puzzles
+         * @param p_min_size minimal number of checkers of a puzzle
+         * @param p_max_size maximal number of checkers of a puzzle
+         * @param p_min_difficulty minimal expected number of checks of a puzzle
+         * @param p_max_difficulty maximal expected number of checks of a puzzle
+         * @param p_checkers_id ids of checkers that can be drawn
+         */
+        inline explicit
+        puzzle_generator(uint64_t p_seed
+                        ,unsigned int p_min_size = 4
+                        ,unsigned int p_max_size = 6
+                        ,double p_min_difficulty = 0
+                        ,double p_max_difficulty = std::numeric_limits<double>::max()
+                        ,const std::vector<unsigned int> & p_checkers_id = solver::get_checker_ids()
+                        );
+
+        /**
+         * Draw samples until one is accepted
+         * @param p_max_attempts maximal number of samples
+         */
+        [[nodiscard]] inline
+        random_puzzle
+        generate(uint64_t p_max_attempts = 10000000);
+
+        /**
+         * Draw one sample
+         * @return puzzle if sample is accepted
+         */
+        [[nodiscard]] inline
+        std::optional<random_puzzle>
+        try_generate();
+
+        /**
+         * Number of samples drawn since construction
+         */
+        [[nodiscard]] inline
+        uint64_t
+        get_nb_attempts() const;
+
+        /**
+         * Search criteria of checkers selecting exactly one code with each
+         * checker being needed
+         * @param p_indexes index of checkers in generator checker list
+         * @return criteria if it is the only one
+         */
+        [[nodiscard]] inline
+        std::optional<std::vector<unsigned int>>
+        find_unique_criteria(const std::vector<unsigned int> & p_indexes) const;
+
+    private:
+
+        /**
+         * Search criteria extending a partial one until two are found
+         * @param p_indexes index of checkers in generator checker list
+         * @param p_prefixes codes satisfying conditions of first checkers
+         * of partial criteria, one entry per position plus one
+         * @param p_criteria partial criteria
+         * @param p_found first criteria found
+         * @param p_count number of criteria found
+         */
+        inline
+        void
+        search_criteria(const std::vector<unsigned int> & p_indexes
+                       ,std::vector<code_set> & p_prefixes
+                       ,std::vector<unsigned int> & p_criteria
+                       ,std::vector<unsigned int> & p_found
+                       ,unsigned int & p_count
+                       ) const;
+
+        /**
+         * Check that criteria selects exactly one code and that each
+         * checker is needed to select it
+         * @param p_indexes index of checkers in generator checker list
+         * @param p_prefixes codes satisfying conditions of first checkers
+         * of criteria, one entry per position plus one
+         * @param p_criteria condition index of each checker
+         */
+        [[nodiscard]] inline
+        bool
+        is_minimal(const std::vector<unsigned int> & p_indexes
+                  ,const std::vector<code_set> & p_prefixes
+                  ,const std::vector<unsigned int> & p_criteria
+                  ) const;
+
+        std::vector<unsigned int> m_checkers_id;
+
+        condition_table m_table;
+
+        std::mt19937_64 m_generator;
+
+        unsigned int m_min_size;
+
+        unsigned int m_max_size;
+
+        double m_min_difficulty;
+
+        double m_max_difficulty;
+
+        uint64_t m_nb_attempts;
+
+        /**
+         * Index of checkers, first ones are drawn by partial shuffle
+         */
+        std::vector<unsigned int> m_indexes;
+    };
+
+    //-------------------------------------------------------------------------
+    std::ostream & operator<<(std::ostream & p_stream, const random_puzzle & p_puzzle)
+    {
+        for(unsigned int l_index = 0; l_index < p_puzzle.m_checkers_id.size(); ++l_index)
+        {
+            p_stream << (l_index ? "," : "") << p_puzzle.m_checkers_id[l_index];
+        }
+        p_stream << " " << condition_table::index_code(p_puzzle.m_code_index) << " -> ";
+        for(auto l_condition_index: p_puzzle.m_criteria)
+        {
+            p_stream << l_condition_index;
+        }
+        auto l_flags = p_stream.flags();
+        auto l_precision = p_stream.precision(3);
+        p_stream << " difficulty=" << std::fixed << p_puzzle.m_difficulty;
+        p_stream.flags(l_flags);
+        p_stream.precision(l_precision);
+        return p_stream;
+    }
+
+    //-------------------------------------------------------------------------
+    puzzle_generator::puzzle_generator(uint64_t p_seed
+                                      ,unsigned int p_min_size
+                                      ,unsigned int p_max_size
+                                      ,double p_min_difficulty
+                                      ,double p_max_difficulty
+                                      ,const std::vector<unsigned int> & p_checkers_id
+                                      )
+    :m_checkers_id{p_checkers_id}
+    ,m_table{[&]()
+             {
+                 std::sort(m_checkers_id.begin(), m_checkers_id.end());
+                 std::vector<std::shared_ptr<checker_if>> l_checkers;
+                 for(auto l_id: m_checkers_id)
+                 {
+                     l_checkers.emplace_back(solver::get_checker(l_id));
+                 }
+                 return l_checkers;
+             }()
+            }
+    ,m_generator{p_seed}
+    ,m_min_size{p_min_size}
+    ,m_max_size{p_max_size}
+    ,m_min_difficulty{p_min_difficulty}
+    ,m_max_difficulty{p_max_difficulty}
+    ,m_nb_attempts{0}
+    ,m_indexes(m_checkers_id.size())
+    {
+        if(!m_min_size || m_min_size > m_max_size || m_max_size > puzzle_record::m_max_checkers || m_max_size > m_checkers_id.size())
+        {
+            throw quicky_exception::quicky_logic_exception("Bad puzzle sizes [" + std::to_string(m_min_size) + "," + std::to_string(m_max_size) + "]", __LINE__, __FILE__);
+        }
+        if(!(m_min_difficulty <= m_max_difficulty))
+        {
+            throw quicky_exception::quicky_logic_exception("Bad difficulties [" + std::to_string(m_min_difficulty) + "," + std::to_string(m_max_difficulty) + "]", __LINE__, __FILE__);
+        }
+        std::iota(m_indexes.begin(), m_indexes.end(), 0);
+    }
+
+    //-------------------------------------------------------------------------
+    random_puzzle
+    puzzle_generator::generate(uint64_t p_max_attempts)
+    {
+        for(uint64_t l_attempt = 0; l_attempt < p_max_attempts; ++l_attempt)
+        {
+            if(auto l_puzzle = try_generate())
+            {
+                return *l_puzzle;
+            }
+        }
+        throw quicky_exception::quicky_logic_exception("No puzzle found in " + std::to_string(p_max_attempts) + " attempts", __LINE__, __FILE__);
+    }
+
+    //-------------------------------------------------------------------------
+    std::optional<random_puzzle>
+    puzzle_generator::try_generate()
+    {
+        ++m_nb_attempts;
+        auto l_size = std::uniform_int_distribution<unsigned int>{m_min_size, m_max_size}(m_generator);
+        // Partial Fisher-Yates shuffle draws distinct checkers
+        for(unsigned int l_position = 0; l_position < l_size; ++l_position)
+        {
+            auto l_other = std::uniform_int_distribution<unsigned int>{l_position, static_cast<unsigned int>(m_indexes.size()) - 1}(m_generator);
+            std::swap(m_indexes[l_position], m_indexes[l_other]);
+        }
+        std::vector<unsigned int> l_indexes{m_indexes.begin(), m_indexes.begin() + l_size};
+        std::sort(l_indexes.begin(), l_indexes.end());
+
+        auto l_criteria = find_unique_criteria(l_indexes);
+        if(!l_criteria)
+        {
+            return std::nullopt;
+        }
+        code_set l_codes;
+        l_codes.set();
+        for(unsigned int l_position = 0; l_position < l_size; ++l_position)
+        {
+            l_codes &= m_table.get_mask(l_indexes[l_position], (*l_criteria)[l_position]);
+        }
+
+        random_puzzle l_puzzle{{}, *l_criteria, condition_table::first_code(l_codes), 0.0};
+        for(auto l_index: l_indexes)
+        {
+            l_puzzle.m_checkers_id.emplace_back(m_checkers_id[l_index]);
+        }
+        criteria_space l_space{condition_table{m_table, l_indexes}};
+        l_puzzle.m_difficulty = difficulty_rater{l_space}.get_greedy_expected_checks();
+        if(l_puzzle.m_difficulty < m_min_difficulty || l_puzzle.m_difficulty > m_max_difficulty)
+        {
+            return std::nullopt;
+        }
+        return l_puzzle;
+    }
+
+    //-------------------------------------------------------------------------
+    uint64_t
+    puzzle_generator::get_nb_attempts() const
+    {
+        return m_nb_attempts;
+    }
+
+    //-------------------------------------------------------------------------
+    std::optional<std::vector<unsigned int>>
+    puzzle_generator::find_unique_criteria(const std::vector<unsigned int> & p_indexes) const
+    {
+        std::vector<code_set> l_prefixes{code_set().set()};
+        std::vector<unsigned int> l_criteria;
+        std::vector<unsigned int> l_found;
+        unsigned int l_count = 0;
+        search_criteria(p_indexes, l_prefixes, l_criteria, l_found, l_count);
+        if(1 != l_count)
+        {
+            return std::nullopt;
+        }
+        return l_found;
+    }
+
+    //-------------------------------------------------------------------------
+    void
+    puzzle_generator::search_criteria(const std::vector<unsigned int> & p_indexes
+                                     ,std::vector<code_set> & p_prefixes
+                                     ,std::vector<unsigned int> & p_criteria
+                                     ,std::vector<unsigned int> & p_found
+                                     ,unsigned int & p_count
+                                     ) const
+    {
+        if(p_criteria.size() == p_indexes.size())
+        {
+            if(is_minimal(p_indexes, p_prefixes, p_criteria) && !p_count++)
+            {
+                p_found = p_criteria;
+            }
+            return;
+        }
+        auto l_position = static_cast<unsigned int>(p_criteria.size());
+        for(unsigned int l_condition_index = 0; l_condition_index < m_table.get_grade(p_indexes[l_position]) && p_count < 2; ++l_condition_index)
+        {
+            code_set l_codes = p_prefixes.back() & m_table.get_mask(p_indexes[l_position], l_condition_index);
+            // Prune as soon as no code remains, when checker does not
+            // remove any code as it would not be needed, or when a single
+            // code remains before last checker as next checkers would not
+            // be needed
+            if(l_codes.any() && l_codes != p_prefixes.back() && (l_position + 1 == p_indexes.size() || l_codes.count() > 1))
+            {
+                p_prefixes.emplace_back(l_codes);
+                p_criteria.emplace_back(l_condition_index);
+                search_criteria(p_indexes, p_prefixes, p_criteria, p_found, p_count);
+                p_criteria.pop_back();
+                p_prefixes.pop_back();
+            }
+        }
+    }
+
+    //-------------------------------------------------------------------------
+    bool
+    puzzle_generator::is_minimal(const std::vector<unsigned int> & p_indexes
+                                ,const std::vector<code_set> & p_prefixes
+                                ,const std::vector<unsigned int> & p_criteria
+                                ) const
+    {
+        if(p_prefixes.back().count() != 1)
+        {
+            return false;
+        }
+        // Checker is needed if codes selected by the other ones are not
+        // reduced to solution
+        code_set l_suffix;
+        l_suffix.set();
+        for(auto l_position = static_cast<unsigned int>(p_criteria.size()); l_position-- > 0;)
+        {
+            if((p_prefixes[l_position] & l_suffix).count() == 1)
+            {
+                return false;
+            }
+            l_suffix &= m_table.get_mask(p_indexes[l_position], p_criteria[l_position]);
+        }
+        return true;
+    }
+}
+#endif //TURING_MACHINE_SOLVER_PUZZLE_GENERATOR_H
+// EOF
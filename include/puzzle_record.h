@@ -0,0 +1,274 @@
+/*    This file is part of turing_machine_solver
+      Copyright (C) 2024  Julien Thevenon ( julien_thevenon at yahoo.fr )
+
+      This program is free software: you can redistribute it and/or modify
+      it under the terms of the GNU General Public License as published by
+      the Free Software Foundation, either version 3 of the License, or
+      (at your option) any later version.
+
+      This program is distributed in the hope that it will be useful,
+      but WITHOUT ANY WARRANTY; without even the implied warranty of
+      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+      GNU General Public License for more details.
+
+      You should have received a copy of the GNU General Public License
+      along with this program.  If not, see <http://www.gnu.org/licenses/>
+*/
+
+#ifndef TURING_MACHINE_SOLVER_PUZZLE_RECORD_H
+#define TURING_MACHINE_SOLVER_PUZZLE_RECORD_H
+
+#include "condition_table.h"
+#include "quicky_exception.h"
+#include <array>
+#include <vector>
+#include <cstdint>
+#include <ostream>
+
+namespace turing_machine_solver
+{
+    /**
+     * Fixed size binary record associating a list of checker ids with its
+     * unique solution and the conditions of each checker satisfied by this
+     * solution. Layout, little endian:
+     * - 6 bytes: checker ids in increasing order, unused ids are 0
+     * - 1 byte : number of checkers
+     * - 1 byte : solution code index
+     * - 6 x 2 bytes: bitfield of conditions satisfied by solution for each checker
+     */
+    class puzzle_record
+    {
+        friend std::ostream & operator<<(std::ostream &, const puzzle_record & );
+
+    public:
+
+        static constexpr unsigned int m_max_checkers = 6;
+
+        static constexpr unsigned int m_size = m_max_checkers + 2 + 2 * m_max_checkers;
+
+        typedef std::array<uint8_t, m_max_checkers> key_t;
+
+        inline
+        puzzle_record(const std::vector<unsigned int> & p_checkers_id
+                     ,unsigned int p_code_index
+                     ,const std::vector<uint16_t> & p_conditions
+                     );
+
+        [[nodiscard]] inline
+        std::vector<unsigned int>
+        get_checkers_id() const;
+
+        [[nodiscard]] inline
+        unsigned int
+        get_nb_checkers() const;
+
+        [[nodiscard]] inline
+        unsigned int
+        get_code_index() const;
+
+        /**
+         * Bitfield of conditions of a checker satisfied by solution
+         */
+        [[nodiscard]] inline
+        uint16_t
+        get_conditions(unsigned int p_checker_index) const;
+
+        [[nodiscard]] inline
+        const key_t &
+        get_key() const;
+
+        /**
+         * Build key of a checker list. Ids must be in increasing order
+         */
+        [[nodiscard]] inline static
+        key_t
+        make_key(const std::vector<unsigned int> & p_checkers_id);
+
+        inline
+        void
+        serialize(uint8_t * p_buffer) const;
+
+        [[nodiscard]] inline static
+        puzzle_record
+        deserialize(const uint8_t * p_buffer);
+
+        /**
+         * Display conditions bitfield of a checker like potential_checkers
+         */
+        inline static
+        void
+        display_conditions(std::ostream & p_stream
+                          ,uint16_t p_conditions
+                          );
+
+    private:
+
+        inline
+        puzzle_record();
+
+        key_t m_key;
+
+        uint8_t m_nb_checkers;
+
+        uint8_t m_code_index;
+
+        std::array<uint16_t, m_max_checkers> m_conditions;
+    };
+
+    //-------------------------------------------------------------------------
+    puzzle_record::puzzle_record()
+    :m_key{}
+    ,m_nb_checkers{0}
+    ,m_code_index{0}
+    ,m_conditions{}
+    {
+    }
+
+    //-------------------------------------------------------------------------
+    puzzle_record::puzzle_record(const std::vector<unsigned int> & p_checkers_id
+                                ,unsigned int p_code_index
+                                ,const std::vector<uint16_t> & p_conditions
+                                )
+    :m_key{make_key(p_checkers_id)}
+    ,m_nb_checkers{static_cast<uint8_t>(p_checkers_id.size())}
+    ,m_code_index{static_cast<uint8_t>(p_code_index)}
+    ,m_conditions{}
+    {
+        assert(p_conditions.size() == p_checkers_id.size());
+        assert(p_code_index < condition_table::m_nb_codes);
+        for(unsigned int l_index = 0; l_index < p_conditions.size(); ++l_index)
+        {
+            m_conditions[l_index] = p_conditions[l_index];
+        }
+    }
+
+    //-------------------------------------------------------------------------
+    puzzle_record::key_t
+    puzzle_record::make_key(const std::vector<unsigned int> & p_checkers_id)
+    {
+        if(p_checkers_id.size() > m_max_checkers)
+        {
+            throw quicky_exception::quicky_logic_exception("Too many checkers " + std::to_string(p_checkers_id.size()), __LINE__, __FILE__);
+        }
+        key_t l_key{};
+        for(unsigned int l_index = 0; l_index < p_checkers_id.size(); ++l_index)
+        {
+            if(!p_checkers_id[l_index] || p_checkers_id[l_index] > 255 || (l_index && p_checkers_id[l_index] <= p_checkers_id[l_index - 1]))
+            {
+                throw quicky_exception::quicky_logic_exception("Checker ids must be increasing in range [1,255]", __LINE__, __FILE__);
+            }
+            l_key[l_index] = static_cast<uint8_t>(p_checkers_id[l_index]);
+        }
+        return l_key;
+    }
+
+    //-------------------------------------------------------------------------
+    std::vector<unsigned int>
+    puzzle_record::get_checkers_id() const
+    {
+        return {m_key.begin(), m_key.begin() + m_nb_checkers};
+    }
+
+    //-------------------------------------------------------------------------
+    unsigned int
+    puzzle_record::get_nb_checkers() const
+    {
+        return m_nb_checkers;
+    }
+
+    //-------------------------------------------------------------------------
+    unsigned int
+    puzzle_record::get_code_index() const
+    {
+        return m_code_index;
+    }
+
+    //-------------------------------------------------------------------------
+    uint16_t
+    puzzle_record::get_conditions(unsigned int p_checker_index) const
+    {
+        assert(p_checker_index < m_nb_checkers);
+        return m_conditions[p_checker_index];
+    }
+
+    //-------------------------------------------------------------------------
+    const puzzle_record::key_t &
+    puzzle_record::get_key() const
+    {
+        return m_key;
+    }
+
+    //-------------------------------------------------------------------------
+    void
+    puzzle_record::serialize(uint8_t * p_buffer) const
+    {
+        for(unsigned int l_index = 0; l_index < m_max_checkers; ++l_index)
+        {
+            p_buffer[l_index] = m_key[l_index];
+        }
+        p_buffer[m_max_checkers] = m_nb_checkers;
+        p_buffer[m_max_checkers + 1] = m_code_index;
+        for(unsigned int l_index = 0; l_index < m_max_checkers; ++l_index)
+        {
+            p_buffer[m_max_checkers + 2 + 2 * l_index] = static_cast<uint8_t>(m_conditions[l_index] & 0xFF);
+            p_buffer[m_max_checkers + 3 + 2 * l_index] = static_cast<uint8_t>(m_conditions[l_index] >> 8);
+        }
+    }
+
+    //-------------------------------------------------------------------------
+    puzzle_record
+    puzzle_record::deserialize(const uint8_t * p_buffer)
+    {
+        puzzle_record l_record;
+        for(unsigned int l_index = 0; l_index < m_max_checkers; ++l_index)
+        {
+            l_record.m_key[l_index] = p_buffer[l_index];
+        }
+        l_record.m_nb_checkers = p_buffer[m_max_checkers];
+        l_record.m_code_index = p_buffer[m_max_checkers + 1];
+        if(l_record.m_nb_checkers > m_max_checkers || l_record.m_code_index >= condition_table::m_nb_codes)
+        {
+            throw quicky_exception::quicky_logic_exception("Corrupted puzzle record", __LINE__, __FILE__);
+        }
+        for(unsigned int l_index = 0; l_index < m_max_checkers; ++l_index)
+        {
+            l_record.m_conditions[l_index] = static_cast<uint16_t>(p_buffer[m_max_checkers + 2 + 2 * l_index] | (p_buffer[m_max_checkers + 3 + 2 * l_index] << 8));
+        }
+        return l_record;
+    }
+
+    //-------------------------------------------------------------------------
+    void
+    puzzle_record::display_conditions(std::ostream & p_stream
+                                     ,uint16_t p_conditions
+                                     )
+    {
+        bool l_several = p_conditions & (p_conditions - 1);
+        p_stream << (l_several ? "(" : "");
+        for(unsigned int l_condition_index = 0; l_condition_index < 16; ++l_condition_index)
+        {
+            if(p_conditions & (1u << l_condition_index))
+            {
+                p_stream << l_condition_index;
+            }
+        }
+        p_stream << (l_several ? ")" : "");
+    }
+
+    //-------------------------------------------------------------------------
+    std::ostream & operator<<(std::ostream & p_stream, const puzzle_record & p_record)
+    {
+        for(unsigned int l_index = 0; l_index < p_record.get_nb_checkers(); ++l_index)
+        {
+            p_stream << (l_index ? "," : "") << static_cast<unsigned int>(p_record.m_key[l_index]);
+        }
+        p_stream << " " << condition_table::index_code(p_record.get_code_index()) << " -> ";
+        for(unsigned int l_index = 0; l_index < p_record.get_nb_checkers(); ++l_index)
+        {
+            puzzle_record::display_conditions(p_stream, p_record.get_conditions(l_index));
+        }
+        return p_stream;
+    }
+}
+#endif //TURING_MACHINE_SOLVER_PUZZLE_RECORD_H
+// EOF
@@ -0,0 +1,216 @@
+/*    This file is part of turing_machine_solver
+      Copyright (C) 2024  Julien Thevenon ( julien_thevenon at yahoo.fr )
+
+      This program is free software: you can redistribute it and/or modify
+      it under the terms of the GNU General Public License as published by
+      the Free Software Foundation, either version 3 of the License, or
+      (at your option) any later version.
+
+      This program is distributed in the hope that it will be useful,
+      but WITHOUT ANY WARRANTY; without even the implied warranty of
+      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+      GNU General Public License for more details.
+
+      You should have received a copy of the GNU General Public License
+      along with this program.  If not, see <http://www.gnu.org/licenses/>
+*/
+
+#ifndef TURING_MACHINE_SOLVER_QUERY_SUGGESTION_H
+#define TURING_MACHINE_SOLVER_QUERY_SUGGESTION_H
+
+#include "condition_table.h"
+#include <ostream>
+#include <iomanip>
+
+namespace turing_machine_solver
+{
+    /**
+     * Query proposed by planner: a code to propose to a checker with the
+     * expected number of remaining criteria after checker answer
+     */
+    class query_suggestion
+    {
+        friend std::ostream & operator<<(std::ostream &, const query_suggestion & );
+
+    public:
+        inline
+        query_suggestion(unsigned int p_code_index
+                        ,unsigned int p_checker_index
+                        ,double p_score
+                        ,double p_lower_bound
+                        ,double p_ideal_score
+                        ,unsigned int p_nb_evaluated
+                        ,unsigned int p_nb_queries
+                        );
+
+        [[nodiscard]] inline
+        unsigned int
+        get_code_index() const;
+
+        [[nodiscard]] inline
+        candidate
+        get_candidate() const;
+
+        [[nodiscard]] inline
+        unsigned int
+        get_checker_index() const;
+
+        /**
+         * Expected number of remaining criteria after checker answer
+         */
+        [[nodiscard]] inline
+        double
+        get_score() const;
+
+        /**
+         * Lower bound of best score among all queries. Unless suggestion is
+         * exact it is estimated on a sample of criteria and holds with 95%
+         * confidence
+         */
+        [[nodiscard]] inline
+        double
+        get_lower_bound() const;
+
+        /**
+         * Difference between score and lower bound, 0 when suggestion is
+         * exact
+         */
+        [[nodiscard]] inline
+        double
+        get_gap() const;
+
+        /**
+         * Number of queries whose score has been computed on all criteria
+         */
+        [[nodiscard]] inline
+        unsigned int
+        get_nb_evaluated() const;
+
+        [[nodiscard]] inline
+        unsigned int
+        get_nb_queries() const;
+
+        /**
+         * Indicate if suggestion is proved optimal: every query was
+         * evaluated or ideal score was reached. A null gap alone only gives
+         * a confidence estimate
+         */
+        [[nodiscard]] inline
+        bool
+        is_exact() const;
+
+    private:
+        unsigned int m_code_index;
+
+        unsigned int m_checker_index;
+
+        double m_score;
+
+        double m_lower_bound;
+
+        /**
+         * Score of a query splitting criteria in halves, no query can do
+         * better
+         */
+        double m_ideal_score;
+
+        unsigned int m_nb_evaluated;
+
+        unsigned int m_nb_queries;
+    };
+
+    //-------------------------------------------------------------------------
+    query_suggestion::query_suggestion(unsigned int p_code_index
+                                      ,unsigned int p_checker_index
+                                      ,double p_score
+                                      ,double p_lower_bound
+                                      ,double p_ideal_score
+                                      ,unsigned int p_nb_evaluated
+                                      ,unsigned int p_nb_queries
+                                      )
+    :m_code_index{p_code_index}
+    ,m_checker_index{p_checker_index}
+    ,m_score{p_score}
+    ,m_lower_bound{p_lower_bound}
+    ,m_ideal_score{p_ideal_score}
+    ,m_nb_evaluated{p_nb_evaluated}
+    ,m_nb_queries{p_nb_queries}
+    {
+    }
+
+    //-------------------------------------------------------------------------
+    unsigned int
+    query_suggestion::get_code_index() const
+    {
+        return m_code_index;
+    }
+
+    //-------------------------------------------------------------------------
+    candidate
+    query_suggestion::get_candidate() const
+    {
+        return condition_table::index_code(m_code_index);
+    }
+
+    //-------------------------------------------------------------------------
+    unsigned int
+    query_suggestion::get_checker_index() const
+    {
+        return m_checker_index;
+    }
+
+    //-------------------------------------------------------------------------
+    double
+    query_suggestion::get_score() const
+    {
+        return m_score;
+    }
+
+    //-------------------------------------------------------------------------
+    double
+    query_suggestion::get_lower_bound() const
+    {
+        return m_lower_bound;
+    }
+
+    //-------------------------------------------------------------------------
+    double
+    query_suggestion::get_gap() const
+    {
+        return m_score > m_lower_bound ? m_score - m_lower_bound : 0.0;
+    }
+
+    //-------------------------------------------------------------------------
+    unsigned int
+    query_suggestion::get_nb_evaluated() const
+    {
+        return m_nb_evaluated;
+    }
+
+    //-------------------------------------------------------------------------
+    unsigned int
+    query_suggestion::get_nb_queries() const
+    {
+        return m_nb_queries;
+    }
+
+    //-------------------------------------------------------------------------
+    bool
+    query_suggestion::is_exact() const
+    {
+        return m_nb_evaluated == m_nb_queries || m_score <= m_ideal_score;
+    }
+
+    //-------------------------------------------------------------------------
+    std::ostream & operator<<(std::ostream & p_stream, const query_suggestion & p_suggestion)
+    {
+        auto l_precision = p_stream.precision();
+        p_stream << p_suggestion.get_candidate() << " with checker " << p_suggestion.get_checker_index();
+        p_stream << " -> " << std::fixed << std::setprecision(2) << p_suggestion.get_score() << " criteria expected";
+        p_stream << " (gap " << p_suggestion.get_gap() << ", " << p_suggestion.get_nb_evaluated() << "/" << p_suggestion.get_nb_queries() << " queries evaluated)";
+        p_stream << std::defaultfloat << std::setprecision(static_cast<int>(l_precision));
+        return p_stream;
+    }
+}
+#endif //TURING_MACHINE_SOLVER_QUERY_SUGGESTION_H
+// EOF
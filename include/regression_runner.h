@@ -0,0 +1,506 @@
+/*    This file is part of turing_machine_solver
+      Copyright (C) 2024  Julien Thevenon ( julien_thevenon at yahoo.fr )
+
+      This program is free software: you can redistribute it and/or modify
+      it under the terms of the GNU General Public License as published by
+      the Free Software Foundation, either version 3 of the License, or
+      (at your option) any later version.
+
+      This program is distributed in the hope that it will be useful,
+      but WITHOUT ANY WARRANTY; without even the implied warranty of
+      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+      GNU General Public License for more details.
+
+      You should have received a copy of the GNU General Public License
+      along with this program.  If not, see <http://www.gnu.org/licenses/>
+*/
+
+#ifndef TURING_MACHINE_SOLVER_REGRESSION_RUNNER_H
+#define TURING_MACHINE_SOLVER_REGRESSION_RUNNER_H
+
+#include "game_runner.h"
+#include "game_server.h"
+#include "allocation_counter.h"
+#include "solver_cache.h"
+#include "work_stealing_pool.h"
+#include "quicky_exception.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <ostream>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace turing_machine_solver
+{
+    /**
+     * Run functional tests described by test.info files. Script of a game
+     * test is played in process by game_runner, by a solver restored from
+     * its serialized state between rounds and by a game_server session.
+     * Solutions read from solver state are compared to the one of expected
+     * output, so nothing is displayed nor parsed.
+     * A test whose args start with "--" is a command test: each args line
+     * is a command line of this executable, arguments being separated by
+     * spaces. Commands are run in order in a scratch copy of test directory
+     * and must succeed, expected output must be found in standard output of
+     * the last one
+     */
+    class regression_runner
+    {
+    public:
+
+        /**
+         * Run all tests of sub directories of a directory, in directory
+         * name order, and write one result line per test and a summary
+         * @param p_tests_directory directory containing test directories
+         * @param p_output output stream
+         * @param p_nb_threads number of threads, 0 means hardware concurrency
+         * @return number of failed tests
+         */
+        inline static
+        unsigned int
+        run(const std::string & p_tests_directory
+           ,std::ostream & p_output
+           ,unsigned int p_nb_threads = 0
+           );
+
+        /**
+         * Play checks of all tests and count heap allocations done between
+         * end of solver construction and solution, while results are
+         * analysed and solver state is queried. Allocations are only
+         * counted when ENABLE_ALLOCATION_CHECK is defined
+         * @param p_tests_directory directory containing test directories
+         * @param p_output output stream
+         * @return number of tests whose game allocated memory
+         */
+        inline static
+        unsigned int
+        check_allocations(const std::string & p_tests_directory
+                         ,std::ostream & p_output
+                         );
+
+    private:
+
+        /**
+         * Sub directories containing a test.info file, in name order
+         */
+        inline static
+        std::vector<std::filesystem::path>
+        list_tests(const std::string & p_tests_directory);
+
+        /**
+         * Args lines and expected output of a test
+         */
+        inline static
+        std::pair<std::vector<std::string>, std::string>
+        read_test(const std::filesystem::path & p_info_path);
+
+        /**
+         * Indicate if args lines are the script of a game test
+         */
+        inline static
+        bool
+        is_game(const std::vector<std::string> & p_args);
+
+        /**
+         * Outcome of a test
+         * @return empty string if test passed, failure reason otherwise
+         */
+        inline static
+        std::string
+        check(const std::string & p_expected
+             ,const game_result & p_result
+             );
+
+        /**
+         * Play checks of a game test on a solver replaced between rounds by
+         * the one restored from its serialized state
+         * @return empty string if solution is the expected one, failure
+         * reason otherwise
+         */
+        inline static
+        std::string
+        check_serialization(const std::string & p_script
+                           ,const std::string & p_expected
+                           );
+
+        /**
+         * Play checks of a game test through requests of a game_server
+         * session
+         * @return empty string if solution is the expected one, failure
+         * reason otherwise
+         */
+        inline static
+        std::string
+        check_server(const std::string & p_script
+                    ,const std::string & p_expected
+                    );
+
+        /**
+         * Run commands of a command test in a scratch copy of its directory
+         * @return empty string if test passed, failure reason otherwise
+         */
+        inline static
+        std::string
+        run_commands(const std::filesystem::path & p_directory
+                    ,const std::vector<std::string> & p_args
+                    ,const std::string & p_expected
+                    );
+
+        static constexpr std::string_view m_solution_prefix = "SOLUTION FOUND :";
+    };
+
+    //-------------------------------------------------------------------------
+    std::pair<std::vector<std::string>, std::string>
+    regression_runner::read_test(const std::filesystem::path & p_info_path)
+    {
+        std::ifstream l_file{p_info_path};
+        if(!l_file.is_open())
+        {
+            throw quicky_exception::quicky_runtime_exception("Unable to open " + p_info_path.string(), __LINE__, __FILE__);
+        }
+        std::vector<std::string> l_args;
+        std::string l_expected;
+        std::string l_line;
+        while(std::getline(l_file, l_line))
+        {
+            if(!l_line.empty() && '\r' == l_line.back())
+            {
+                l_line.pop_back();
+            }
+            if(l_line.starts_with("args:"))
+            {
+                std::string l_arg = l_line.substr(5);
+                if(l_arg.size() >= 2 && '"' == l_arg.front() && '"' == l_arg.back())
+                {
+                    l_arg = l_arg.substr(1, l_arg.size() - 2);
+                }
+                l_args.emplace_back(l_arg);
+            }
+            else if(l_line.starts_with("expected_stdout_string:"))
+            {
+                l_expected = l_line.substr(23);
+            }
+        }
+        if(l_args.empty())
+        {
+            throw quicky_exception::quicky_runtime_exception("No args in " + p_info_path.string(), __LINE__, __FILE__);
+        }
+        return {l_args, l_expected};
+    }
+
+    //-------------------------------------------------------------------------
+    bool
+    regression_runner::is_game(const std::vector<std::string> & p_args)
+    {
+        return 1 == p_args.size() && !p_args.front().starts_with("--");
+    }
+
+    //-------------------------------------------------------------------------
+    std::string
+    regression_runner::check(const std::string & p_expected
+                            ,const game_result & p_result
+                            )
+    {
+        if(!p_expected.starts_with(m_solution_prefix))
+        {
+            return "expected output is not a solution";
+        }
+        if(p_result.get_status() != game_result::status::SOLVED)
+        {
+            std::stringstream l_stream;
+            l_stream << "game not solved: " << p_result;
+            return l_stream.str();
+        }
+        // Details are solution code and its conditions, as displayed after prefix
+        if(p_expected.substr(m_solution_prefix.size()) != p_result.get_details())
+        {
+            return "solution " + p_result.get_details() + " instead of " + p_expected.substr(m_solution_prefix.size());
+        }
+        return "";
+    }
+
+    //-------------------------------------------------------------------------
+    std::string
+    regression_runner::check_serialization(const std::string & p_script
+                                          ,const std::string & p_expected
+                                          )
+    {
+        auto [l_ids, l_checks] = game_runner::parse_checks(p_script);
+        solver l_solver{l_ids, false};
+        std::optional<unsigned int> l_current_code;
+        for(const auto & [l_code, l_checker_index, l_result]: l_checks)
+        {
+            // Like game_runner, remaining checks of a solved game are ignored
+            if(l_solver.get_remaining_candidates() <= 1)
+            {
+                break;
+            }
+            // Conditions are only restored for remaining codes so state is
+            // saved between rounds, like a game moved between processes
+            if(l_current_code && *l_current_code != l_code)
+            {
+                l_solver = solver::deserialize(l_solver.serialize());
+            }
+            l_current_code = l_code;
+            l_solver.analyze_result(candidate{l_code}, l_checker_index, l_result);
+        }
+        l_solver = solver::deserialize(l_solver.serialize());
+        if(1 != l_solver.get_remaining_candidates())
+        {
+            return "serialization: " + std::to_string(l_solver.get_remaining_candidates()) + " candidates remaining";
+        }
+        candidate l_solution = condition_table::index_code(condition_table::first_code(l_solver.get_remaining_codes()));
+        std::stringstream l_stream;
+        l_stream << l_solution << " -> " << l_solver.get_related_checkers(l_solution);
+        if(p_expected.substr(m_solution_prefix.size()) != l_stream.str())
+        {
+            return "serialization: solution " + l_stream.str() + " instead of " + p_expected.substr(m_solution_prefix.size());
+        }
+        return "";
+    }
+
+    //-------------------------------------------------------------------------
+    std::string
+    regression_runner::check_server(const std::string & p_script
+                                   ,const std::string & p_expected
+                                   )
+    {
+        auto [l_ids, l_checks] = game_runner::parse_checks(p_script);
+        game_server l_server;
+        std::string l_request = "create";
+        for(unsigned int l_index = 0; l_index < l_ids.size(); ++l_index)
+        {
+            l_request += (l_index ? "," : " ") + std::to_string(l_ids[l_index]);
+        }
+        // Response is OK <session> <remaining candidates>
+        std::string l_response = l_server.handle(l_request);
+        std::stringstream l_stream{l_response};
+        std::string l_status;
+        uint64_t l_session;
+        unsigned int l_nb_remaining;
+        if(!(l_stream >> l_status >> l_session >> l_nb_remaining) || "OK" != l_status)
+        {
+            return "server: \"" + l_request + "\" -> \"" + l_response + "\"";
+        }
+        for(const auto & [l_code, l_checker_index, l_result]: l_checks)
+        {
+            if(l_nb_remaining <= 1)
+            {
+                break;
+            }
+            // Response is OK <remaining candidates>
+            l_request = "apply " + std::to_string(l_session) + "," + std::to_string(l_code) + "," + std::to_string(l_checker_index) + "," + std::to_string(l_result);
+            l_response = l_server.handle(l_request);
+            l_stream = std::stringstream{l_response};
+            if(!(l_stream >> l_status >> l_nb_remaining) || "OK" != l_status)
+            {
+                return "server: \"" + l_request + "\" -> \"" + l_response + "\"";
+            }
+        }
+        l_response = l_server.handle("state " + std::to_string(l_session));
+        std::string l_expected = "OK 1 " + p_expected.substr(m_solution_prefix.size());
+        if(l_expected != l_response)
+        {
+            return "server: state \"" + l_response + "\" instead of \"" + l_expected + "\"";
+        }
+        return "";
+    }
+
+    //-------------------------------------------------------------------------
+    std::string
+    regression_runner::run_commands(const std::filesystem::path & p_directory
+                                   ,const std::vector<std::string> & p_args
+                                   ,const std::string & p_expected
+                                   )
+    {
+        // Files written by commands stay in scratch directory
+        std::filesystem::path l_executable = std::filesystem::read_symlink("/proc/self/exe");
+        std::filesystem::path l_scratch = std::filesystem::temp_directory_path() / ("turing_machine_solver_" + p_directory.filename().string() + "_" + std::to_string(::getpid()));
+        std::filesystem::remove_all(l_scratch);
+        std::filesystem::copy(p_directory, l_scratch, std::filesystem::copy_options::recursive);
+        auto l_quote = [](const std::string & p_string)
+        {
+            std::string l_result = "'";
+            for(char l_char: p_string)
+            {
+                l_result += '\'' == l_char ? std::string("'\\''") : std::string(1, l_char);
+            }
+            return l_result + "'";
+        };
+        std::string l_failure;
+        std::string l_output;
+        for(size_t l_index = 0; l_failure.empty() && l_index < p_args.size(); ++l_index)
+        {
+            std::string l_command = "cd " + l_quote(l_scratch.string()) + " && " + l_quote(l_executable.string());
+            std::stringstream l_stream{p_args[l_index]};
+            std::string l_arg;
+            while(l_stream >> l_arg)
+            {
+                l_command += " " + l_quote(l_arg);
+            }
+            l_command += " < /dev/null";
+            FILE * l_pipe = ::popen(l_command.c_str(), "r");
+            if(!l_pipe)
+            {
+                l_failure = "unable to run command " + std::to_string(l_index);
+                break;
+            }
+            l_output.clear();
+            char l_buffer[4096];
+            size_t l_size;
+            while((l_size = std::fread(l_buffer, 1, sizeof(l_buffer), l_pipe)) > 0)
+            {
+                l_output.append(l_buffer, l_size);
+            }
+            int l_status = ::pclose(l_pipe);
+            if(!WIFEXITED(l_status) || WEXITSTATUS(l_status))
+            {
+                // Last line gives error message of command
+                std::string l_last_line = l_output.substr(0, l_output.find_last_not_of('\n') + 1);
+                l_last_line = l_last_line.substr(l_last_line.find_last_of('\n') + 1);
+                l_failure = "command " + std::to_string(l_index) + " failed: " + l_last_line;
+            }
+        }
+        std::filesystem::remove_all(l_scratch);
+        if(l_failure.empty() && std::string::npos == l_output.find(p_expected))
+        {
+            l_failure = "\"" + p_expected + "\" not found in output of last command";
+        }
+        return l_failure;
+    }
+
+    //-------------------------------------------------------------------------
+    std::vector<std::filesystem::path>
+    regression_runner::list_tests(const std::string & p_tests_directory)
+    {
+        std::vector<std::filesystem::path> l_directories;
+        for(const auto & l_entry: std::filesystem::directory_iterator{p_tests_directory})
+        {
+            if(l_entry.is_directory() && std::filesystem::is_regular_file(l_entry.path() / "test.info"))
+            {
+                l_directories.emplace_back(l_entry.path());
+            }
+        }
+        std::sort(l_directories.begin(), l_directories.end());
+        return l_directories;
+    }
+
+    //-------------------------------------------------------------------------
+    unsigned int
+    regression_runner::run(const std::string & p_tests_directory
+                          ,std::ostream & p_output
+                          ,unsigned int p_nb_threads
+                          )
+    {
+        std::vector<std::filesystem::path> l_directories = list_tests(p_tests_directory);
+
+        std::vector<std::string> l_failures(l_directories.size());
+        std::vector<std::chrono::microseconds> l_durations(l_directories.size());
+        solver_cache l_cache{game_runner::m_cache_memory_cap};
+        work_stealing_pool l_pool{p_nb_threads};
+        auto l_start = std::chrono::steady_clock::now();
+        l_pool.run(l_directories.size()
+                  ,[&](size_t p_index, unsigned int)
+                   {
+                       auto [l_args, l_expected] = read_test(l_directories[p_index] / "test.info");
+                       if(!is_game(l_args))
+                       {
+                           auto l_command_start = std::chrono::steady_clock::now();
+                           l_failures[p_index] = run_commands(l_directories[p_index], l_args, l_expected);
+                           l_durations[p_index] = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - l_command_start);
+                           return;
+                       }
+                       game_result l_result = game_runner::run(l_args.front(), &l_cache);
+                       l_failures[p_index] = check(l_expected, l_result);
+                       l_durations[p_index] = l_result.get_duration();
+                       try
+                       {
+                           if(l_failures[p_index].empty())
+                           {
+                               l_failures[p_index] = check_serialization(l_args.front(), l_expected);
+                           }
+                           if(l_failures[p_index].empty())
+                           {
+                               l_failures[p_index] = check_server(l_args.front(), l_expected);
+                           }
+                       }
+                       catch(quicky_exception::quicky_logic_exception & e)
+                       {
+                           l_failures[p_index] = e.what();
+                       }
+                       catch(quicky_exception::quicky_runtime_exception & e)
+                       {
+                           l_failures[p_index] = e.what();
+                       }
+                   }
+                  );
+        auto l_duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - l_start);
+
+        unsigned int l_nb_failures = 0;
+        std::string l_output;
+        for(size_t l_index = 0; l_index < l_directories.size(); ++l_index)
+        {
+            bool l_passed = l_failures[l_index].empty();
+            l_nb_failures += !l_passed;
+            l_output += (l_passed ? "PASS " : "FAIL ") + l_directories[l_index].filename().string();
+            l_output += " " + std::to_string(l_durations[l_index].count()) + "us";
+            l_output += (l_passed ? "" : " " + l_failures[l_index]) + '\n';
+        }
+        p_output << l_output;
+        p_output << l_directories.size() << " tests run in " << l_duration.count() << "ms with " << l_pool.get_nb_threads() << " threads: ";
+        p_output << l_directories.size() - l_nb_failures << " passed, " << l_nb_failures << " failed" << std::endl;
+        return l_nb_failures;
+    }
+
+    //-------------------------------------------------------------------------
+    unsigned int
+    regression_runner::check_allocations(const std::string & p_tests_directory
+                                        ,std::ostream & p_output
+                                        )
+    {
+        std::vector<std::filesystem::path> l_directories = list_tests(p_tests_directory);
+        unsigned int l_nb_tests = 0;
+        unsigned int l_nb_failures = 0;
+        for(const auto & l_directory: l_directories)
+        {
+            // Command tests run other processes
+            auto [l_args, l_expected] = read_test(l_directory / "test.info");
+            if(!is_game(l_args))
+            {
+                continue;
+            }
+            ++l_nb_tests;
+            auto [l_ids, l_checks] = game_runner::parse_checks(l_args.front());
+            solver l_solver{l_ids, false};
+            unsigned int l_nb_steps = 0;
+            // Counter is per thread so only allocations of game are seen
+            uint64_t l_nb_allocations = allocation_counter::get_nb_allocations();
+            for(const auto & [l_code, l_checker_index, l_result]: l_checks)
+            {
+                // Like game_runner, remaining checks of a solved game are ignored
+                if(l_solver.get_remaining_candidates() <= 1)
+                {
+                    break;
+                }
+                l_solver.analyze_result(candidate{l_code}, l_checker_index, l_result);
+                (void)l_solver.get_remaining_codes();
+                ++l_nb_steps;
+            }
+            l_nb_allocations = allocation_counter::get_nb_allocations() - l_nb_allocations;
+            l_nb_failures += 0 != l_nb_allocations;
+            p_output << (l_nb_allocations ? "FAIL " : "PASS ") << l_directory.filename().string() << " " << l_nb_allocations << " allocations in " << l_nb_steps << " steps" << '\n';
+        }
+        p_output << l_nb_tests << " tests checked: " << l_nb_tests - l_nb_failures << " without allocation, " << l_nb_failures << " with allocations" << std::endl;
+        return l_nb_failures;
+    }
+}
+#endif //TURING_MACHINE_SOLVER_REGRESSION_RUNNER_H
+// EOF
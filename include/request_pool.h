@@ -0,0 +1,207 @@
+/*    This file is part of turing_machine_solver
+      Copyright (C) 2024  Julien Thevenon ( julien_thevenon at yahoo.fr )
+
+      This program is free software: you can redistribute it and/or modify
+      it under the terms of the GNU General Public License as published by
+      the Free Software Foundation, either version 3 of the License, or
+      (at your option) any later version.
+
+      This program is distributed in the hope that it will be useful,
+      but WITHOUT ANY WARRANTY; without even the implied warranty of
+      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+      GNU General Public License for more details.
+
+      You should have received a copy of the GNU General Public License
+      along with this program.  If not, see <http://www.gnu.org/licenses/>
+*/
+
+#ifndef TURING_MACHINE_SOLVER_REQUEST_POOL_H
+#define TURING_MACHINE_SOLVER_REQUEST_POOL_H
+
+#include "quicky_exception.h"
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace turing_machine_solver
+{
+    /**
+     * Threads processing requests on behalf of a poll loop. Responses are
+     * collected by the loop, which is woken up through a pipe whose read
+     * end is part of its poll set
+     */
+    class request_pool
+    {
+    public:
+        /**
+         * @param p_handler request processing, called concurrently
+         * @param p_nb_threads number of threads, 0 means hardware concurrency
+         */
+        inline explicit
+        request_pool(std::function<std::string(std::string_view)> p_handler
+                    ,unsigned int p_nb_threads = 0
+                    );
+
+        request_pool(const request_pool &) = delete;
+
+        request_pool &
+        operator=(const request_pool &) = delete;
+
+        inline
+        ~request_pool();
+
+        /**
+         * Queue a request
+         * @param p_client identifier given back with response
+         * @param p_request request line
+         */
+        inline
+        void
+        submit(uint64_t p_client
+              ,std::string p_request
+              );
+
+        /**
+         * File descriptor readable when responses are available
+         */
+        [[nodiscard]] inline
+        int
+        get_notification_fd() const;
+
+        /**
+         * Responses available since last call, with identifier of client
+         */
+        [[nodiscard]] inline
+        std::vector<std::pair<uint64_t, std::string>>
+        take_responses();
+
+    private:
+
+        inline
+        void
+        work();
+
+        std::function<std::string(std::string_view)> m_handler;
+
+        std::mutex m_mutex;
+
+        std::condition_variable m_condition;
+
+        std::deque<std::pair<uint64_t, std::string>> m_requests;
+
+        std::vector<std::pair<uint64_t, std::string>> m_responses;
+
+        bool m_stop;
+
+        int m_pipe[2];
+
+        std::vector<std::thread> m_threads;
+    };
+
+    //-------------------------------------------------------------------------
+    request_pool::request_pool(std::function<std::string(std::string_view)> p_handler
+                              ,unsigned int p_nb_threads
+                              )
+    :m_handler{std::move(p_handler)}
+    ,m_stop{false}
+    ,m_pipe{-1, -1}
+    {
+        if(::pipe2(m_pipe, O_NONBLOCK | O_CLOEXEC))
+        {
+            throw quicky_exception::quicky_runtime_exception(std::string("Unable to create pipe: ") + std::strerror(errno), __LINE__, __FILE__);
+        }
+        unsigned int l_nb_threads = p_nb_threads ? p_nb_threads : std::max(1u, std::thread::hardware_concurrency());
+        for(unsigned int l_index = 0; l_index < l_nb_threads; ++l_index)
+        {
+            m_threads.emplace_back([this]{work();});
+        }
+    }
+
+    //-------------------------------------------------------------------------
+    request_pool::~request_pool()
+    {
+        {
+            std::lock_guard<std::mutex> l_lock{m_mutex};
+            m_stop = true;
+        }
+        m_condition.notify_all();
+        for(auto & l_thread: m_threads)
+        {
+            l_thread.join();
+        }
+        ::close(m_pipe[0]);
+        ::close(m_pipe[1]);
+    }
+
+    //-------------------------------------------------------------------------
+    void
+    request_pool::submit(uint64_t p_client
+                        ,std::string p_request
+                        )
+    {
+        {
+            std::lock_guard<std::mutex> l_lock{m_mutex};
+            m_requests.emplace_back(p_client, std::move(p_request));
+        }
+        m_condition.notify_one();
+    }
+
+    //-------------------------------------------------------------------------
+    int
+    request_pool::get_notification_fd() const
+    {
+        return m_pipe[0];
+    }
+
+    //-------------------------------------------------------------------------
+    std::vector<std::pair<uint64_t, std::string>>
+    request_pool::take_responses()
+    {
+        char l_buffer[256];
+        while(::read(m_pipe[0], l_buffer, sizeof(l_buffer)) > 0)
+        {
+        }
+        std::vector<std::pair<uint64_t, std::string>> l_responses;
+        std::lock_guard<std::mutex> l_lock{m_mutex};
+        std::swap(l_responses, m_responses);
+        return l_responses;
+    }
+
+    //-------------------------------------------------------------------------
+    void
+    request_pool::work()
+    {
+        std::unique_lock<std::mutex> l_lock{m_mutex};
+        while(true)
+        {
+            m_condition.wait(l_lock, [this]{return m_stop || !m_requests.empty();});
+            if(m_stop)
+            {
+                return;
+            }
+            auto [l_client, l_request] = std::move(m_requests.front());
+            m_requests.pop_front();
+            l_lock.unlock();
+            std::string l_response = m_handler(l_request);
+            l_lock.lock();
+            m_responses.emplace_back(l_client, std::move(l_response));
+            // A full pipe is already readable so write failure is harmless
+            char l_notification = 0;
+            [[maybe_unused]] auto l_nb_written = ::write(m_pipe[1], &l_notification, 1);
+        }
+    }
+}
+#endif //TURING_MACHINE_SOLVER_REQUEST_POOL_H
+// EOF
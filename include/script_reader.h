@@ -0,0 +1,158 @@
+/*    This file is part of turing_machine_solver
+      Copyright (C) 2024  Julien Thevenon ( julien_thevenon at yahoo.fr )
+
+      This program is free software: you can redistribute it and/or modify
+      it under the terms of the GNU General Public License as published by
+      the Free Software Foundation, either version 3 of the License, or
+      (at your option) any later version.
+
+      This program is distributed in the hope that it will be useful,
+      but WITHOUT ANY WARRANTY; without even the implied warranty of
+      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+      GNU General Public License for more details.
+
+      You should have received a copy of the GNU General Public License
+      along with this program.  If not, see <http://www.gnu.org/licenses/>
+*/
+
+#ifndef TURING_MACHINE_SOLVER_SCRIPT_READER_H
+#define TURING_MACHINE_SOLVER_SCRIPT_READER_H
+
+#include "quicky_exception.h"
+#include <string>
+#include <string_view>
+#include <algorithm>
+#include <charconv>
+
+namespace turing_machine_solver
+{
+    /**
+     * Tokenizer of scripted values, used by ask for scripts and values
+     * typed by player. Tokens are separated by commas and white spaces,
+     * empty tokens are skipped. Script is not copied so it must outlive
+     * the reader
+     */
+    class script_reader
+    {
+    public:
+        inline explicit
+        script_reader(std::string_view p_script);
+
+        /**
+         * Indicate if all tokens have been read
+         */
+        [[nodiscard]] inline
+        bool
+        is_empty() const;
+
+        /**
+         * Offset of first character of next token in script
+         */
+        [[nodiscard]] inline
+        size_t
+        get_position() const;
+
+        [[nodiscard]] inline
+        std::string_view
+        next_token();
+
+        template <typename T>
+        [[nodiscard]] inline
+        T
+        next();
+
+        /**
+         * Continue reading from same position in a script starting with
+         * current one, used when characters are appended to a buffer that
+         * may have been reallocated
+         */
+        inline
+        void
+        extend(std::string_view p_script);
+
+        static constexpr std::string_view m_separators = ", \t\r\n";
+
+    private:
+
+        inline
+        void
+        skip_separators();
+
+        std::string_view m_script;
+
+        size_t m_position;
+    };
+
+    //-------------------------------------------------------------------------
+    script_reader::script_reader(std::string_view p_script)
+    :m_script{p_script}
+    ,m_position{0}
+    {
+        skip_separators();
+    }
+
+    //-------------------------------------------------------------------------
+    bool
+    script_reader::is_empty() const
+    {
+        return m_position == m_script.size();
+    }
+
+    //-------------------------------------------------------------------------
+    size_t
+    script_reader::get_position() const
+    {
+        return m_position;
+    }
+
+    //-------------------------------------------------------------------------
+    std::string_view
+    script_reader::next_token()
+    {
+        if(is_empty())
+        {
+            throw quicky_exception::quicky_logic_exception("Script exhausted", __LINE__, __FILE__);
+        }
+        size_t l_end = std::min(m_script.find_first_of(m_separators, m_position), m_script.size());
+        std::string_view l_token = m_script.substr(m_position, l_end - m_position);
+        m_position = l_end;
+        skip_separators();
+        return l_token;
+    }
+
+    //-------------------------------------------------------------------------
+    template <typename T>
+    T
+    script_reader::next()
+    {
+        size_t l_position = m_position;
+        std::string_view l_token = next_token();
+        T l_result;
+        auto [l_ptr, l_status] = std::from_chars(l_token.data(), l_token.data() + l_token.size(), l_result);
+        if(l_status != std::errc() || l_ptr != l_token.data() + l_token.size())
+        {
+            throw quicky_exception::quicky_logic_exception("Invalid script argument \"" + std::string(l_token) + "\" at offset " + std::to_string(l_position)
+                                                          ,__LINE__
+                                                          ,__FILE__
+                                                          );
+        }
+        return l_result;
+    }
+
+    //-------------------------------------------------------------------------
+    void
+    script_reader::extend(std::string_view p_script)
+    {
+        m_script = p_script;
+        skip_separators();
+    }
+
+    //-------------------------------------------------------------------------
+    void
+    script_reader::skip_separators()
+    {
+        m_position = std::min(m_script.find_first_not_of(m_separators, m_position), m_script.size());
+    }
+}
+#endif //TURING_MACHINE_SOLVER_SCRIPT_READER_H
+// EOF
@@ -19,31 +19,101 @@
 #define TURING_MACHINE_SOLVER_SOLVER_H
 
 #include "potential_checkers.h"
-#include "checker_base.h"
+#include "card_catalogue.h"
+#include "condition_table.h"
+#include "checker_registry.h"
+#include "output_sink.h"
+#include "instrumentation.h"
 #include "enumerator.h"
 #include "quicky_exception.h"
+#include <array>
 #include <map>
 #include <memory>
 #include <iostream>
+#include <limits>
 #include <set>
+#include <vector>
+#include <cstdint>
+#include <cstdlib>
 
 namespace turing_machine_solver
 {
+    /**
+     * Once constructed, state is a fixed size array of conditions of all
+     * codes and a set of remaining codes. Queries and analyze_result do
+     * not allocate memory, only display does when it is enabled
+     */
     class solver
     {
     public:
+        /**
+         * Constructor
+         * @param p_checkers_id ids of checkers used in game
+         * @param p_verbose if false nothing is displayed by solver, else
+         * messages go to console sink
+         */
         inline explicit
-        solver(const std::vector<unsigned int> & p_checkers_id);
+        solver(const std::vector<unsigned int> & p_checkers_id
+              ,bool p_verbose = true
+              );
+
+        /**
+         * Constructor
+         * @param p_registry registry where checkers are defined
+         * @param p_checkers_id ids of checkers used in game
+         * @param p_verbose if false nothing is displayed by solver, else
+         * messages go to console sink
+         */
+        inline
+        solver(const checker_registry & p_registry
+              ,const std::vector<unsigned int> & p_checkers_id
+              ,bool p_verbose = true
+              );
+
+        /**
+         * Constructor
+         * @param p_registry registry where checkers are defined
+         * @param p_checkers_id ids of checkers used in game
+         * @param p_sink destination of messages, nothing is displayed if
+         * null. Sink must outlive solver
+         */
+        inline
+        solver(const checker_registry & p_registry
+              ,const std::vector<unsigned int> & p_checkers_id
+              ,output_sink * p_sink
+              );
+
+        /**
+         * Registry of all checkers of the game, built on first call in a
+         * thread safe way and never modified afterwards
+         */
+        [[nodiscard]] inline static
+        const checker_registry &
+        get_registry();
 
         inline static
         std::shared_ptr<checker_if>
         get_checker(unsigned int p_id);
 
+        /**
+         * Ids of all registered checkers in increasing order
+         */
+        [[nodiscard]] inline static
+        std::vector<unsigned int>
+        get_checker_ids();
+
 
         [[nodiscard]] inline
         unsigned int
         get_remaining_candidates() const;
 
+        /**
+         * Codes of remaining candidates
+         */
+        [[nodiscard]] inline
+        code_set
+        get_remaining_codes() const;
+
         inline
         void
         analyze_result(const potential_checkers & p_checkers
@@ -51,20 +121,103 @@ namespace turing_machine_solver
                       ,bool l_result
                       );
 
+        /**
+         * Analyze result of a check of a proposed code. Conditions of the
+         * code do not change during game so checks of the same code can
+         * be given one by one even once a previous answer eliminated it
+         * @param p_candidate proposed code, must have been a candidate of
+         * initial state
+         */
+        inline
+        void
+        analyze_result(const candidate & p_candidate
+                      ,unsigned int p_checker_index
+                      ,bool p_result
+                      );
+
         [[nodiscard]] inline
         potential_checkers
         get_related_checkers(const candidate & p_candidate) const;
 
+        /**
+         * Enable or disable display, used when a copy of a solver is
+         * given to another game
+         */
+        inline
+        void
+        set_verbose(bool p_verbose);
+
+        /**
+         * Change destination of messages, nothing is displayed if null
+         */
+        inline
+        void
+        set_output(output_sink * p_sink);
+
+        /**
+         * Approximate number of bytes used by solver
+         */
+        [[nodiscard]] inline
+        size_t
+        get_memory_footprint() const;
+
+        /**
+         * Binary image of solver state: checker ids and remaining codes.
+         * Conditions of remaining codes only depend on checkers so they are
+         * recomputed when state is restored
+         */
+        [[nodiscard]] inline
+        std::vector<uint8_t>
+        serialize() const;
+
+        /**
+         * Rebuild a solver from serialize output without redoing
+         * construction, checkers are taken from game registry. Conditions
+         * are only restored for remaining codes so a code eliminated during
+         * current round can no longer be checked: save state between rounds
+         * @param p_data binary image
+         * @param p_verbose if false nothing is displayed by solver
+         */
+        [[nodiscard]] inline static
+        solver
+        deserialize(const std::vector<uint8_t> & p_data
+                   ,bool p_verbose = false
+                   );
+
         inline static
         void
-        display_all_checkers();
+        display_all_checkers(std::ostream & p_stream = std::cout);
 
+        /**
+         * Ensure registry of all checkers is built. Kept for compatibility,
+         * calling it is optional and can be done several times
+         */
         inline static
         void
         register_all_checkers();
 
+        /**
+         * Definition of all checkers of the game, each call compiles
+         * embedded card catalogue. Cards of the catalogue file named by
+         * TURING_MACHINE_SOLVER_CARDS environment variable are added or
+         * replace embedded cards with the same id
+         */
+        [[nodiscard]] inline static
+        std::vector<std::shared_ptr<checker_if>>
+        create_all_checkers();
+
     private:
 
+        /**
+         * Empty solver filled by deserialize
+         */
+        inline explicit
+        solver(output_sink * p_sink);
+
+        [[nodiscard]] inline
+        bool
+        is_displayed(verbosity p_level) const;
+
         inline
         void
         display_remaining();
@@ -81,139 +234,285 @@ namespace turing_machine_solver
         void
         compute_potential_checkers(unsigned int p_max_grade);
 
-        inline static
-        void
-        register_checker(const std::shared_ptr<checker_if> & p_checker);
-
         /**
          * Record relation between candidate and checker
          * @param p_candidate
          * @param p_checkers
+         * @param p_checkers_to_candidate candidates of checkers seen once
          * @param p_bad_checkers list of eliminated checkers
          * @param p_candidate_with_bad_checkers list of candidates related to
          * eliminated checkers
          */
-        inline
+        inline static
         void
         relate_candidate_checker(const candidate & p_candidate
                                 ,const potential_checkers & p_checkers
+                                ,std::map<potential_checkers, candidate> & p_checkers_to_candidate
                                 ,std::set<potential_checkers> & p_bad_checkers
                                 ,std::set<candidate> & p_candidate_with_bad_checkers
                                 );
 
         std::vector<std::shared_ptr<checker_if>> m_checkers;
 
-        std::set<candidate> m_candidates;
+        /**
+         * Conditions of each code, indexed by code index. Only meaningful
+         * for remaining codes
+         */
+        std::array<potential_checkers, condition_table::m_nb_codes> m_code_to_checkers;
 
-        std::set<std::string> m_potential_checkers;
+        code_set m_remaining;
 
-        std::map<candidate, potential_checkers> m_candidate_to_checkers;
+        output_sink * m_sink;
 
-        std::map<potential_checkers, candidate> m_checkers_to_candidate;
+        static constexpr char m_state_magic[4] = {'T', 'M', 'S', 'S'};
 
-        inline static std::map<unsigned int, std::shared_ptr<checker_if>> m_all_checkers;
+        static constexpr uint8_t m_state_version = 1;
+
+        static constexpr size_t m_state_codes_size = (condition_table::m_nb_codes + 7) / 8;
     };
 
     //-------------------------------------------------------------------------
-    solver::solver(const std::vector<unsigned int> & p_checkers_id)
+    solver::solver(const std::vector<unsigned int> & p_checkers_id
+                  ,bool p_verbose
+                  )
+    :solver(get_registry(), p_checkers_id, p_verbose ? &output_sink::get_console() : nullptr)
     {
-        if(m_all_checkers.empty())
+    }
+
+    //-------------------------------------------------------------------------
+    solver::solver(const checker_registry & p_registry
+                  ,const std::vector<unsigned int> & p_checkers_id
+                  ,bool p_verbose
+                  )
+    :solver(p_registry, p_checkers_id, p_verbose ? &output_sink::get_console() : nullptr)
+    {
+    }
+
+    //-------------------------------------------------------------------------
+    solver::solver(const checker_registry & p_registry
+                  ,const std::vector<unsigned int> & p_checkers_id
+                  ,output_sink * p_sink
+                  )
+    :m_sink{p_sink}
+    {
+        if(p_checkers_id.size() > potential_checkers::m_max_checkers)
         {
-            throw quicky_exception::quicky_logic_exception("Checkers have not been registered"
-                                                          ,__LINE__
-                                                          ,__FILE__
-                                                          );
+            throw quicky_exception::quicky_logic_exception("Too many checkers " + std::to_string(p_checkers_id.size()), __LINE__, __FILE__);
         }
-
         unsigned int l_max_grade = 0;
         for(const auto & l_iter_id: p_checkers_id)
         {
-            m_checkers.emplace_back(get_checker(l_iter_id));
+            m_checkers.emplace_back(p_registry.get_checker(l_iter_id));
             if(l_max_grade < m_checkers.back()->get_grade())
             {
                 l_max_grade = m_checkers.back()->get_grade();
             }
         }
 
-        std::vector<combinatorics::symbol> l_symbols{{1,5}, {2, 5}, {3, 5}, {4, 5}, {5, 5}};
-        combinatorics::enumerator l_enumerator{l_symbols, 3};
-        while(l_enumerator.generate())
+        // Construction only state, released once remaining codes are known
+        std::vector<candidate> l_candidates;
         {
-            l_enumerator.display_word();
-            m_candidates.insert({l_enumerator.get_word_item(0), l_enumerator.get_word_item(1), l_enumerator.get_word_item(2)});
+            instrumentation::timer l_timer{instrumentation::phase::ENUMERATION};
+            std::vector<combinatorics::symbol> l_symbols{{1,5}, {2, 5}, {3, 5}, {4, 5}, {5, 5}};
+            combinatorics::enumerator l_enumerator{l_symbols, 3};
+            while(l_enumerator.generate())
+            {
+                candidate l_candidate{l_enumerator.get_word_item(0), l_enumerator.get_word_item(1), l_enumerator.get_word_item(2)};
+                if(is_displayed(verbosity::DEBUG))
+                {
+                    m_sink->write_line(verbosity::DEBUG, "Candidate ", l_candidate);
+                }
+                l_candidates.emplace_back(l_candidate);
+                instrumentation::add(instrumentation::counter::CANDIDATES);
+            }
         }
 
         compute_potential_checkers(l_max_grade);
 
         // Test every candidate with all checkers to restrain candidates
-        std::cout << "Candidates matching with checkers:" << std::endl;
+        if(is_displayed(verbosity::DEBUG))
+        {
+            m_sink->write_line(verbosity::DEBUG, "Candidates matching with checkers:");
+        }
         std::vector<candidate> l_bad_candidates;
+        std::map<potential_checkers, candidate> l_checkers_to_candidate;
         std::set<potential_checkers> l_bad_checkers;
         std::set<candidate> l_candidate_with_bad_checkers;
-        for(const auto & l_iter: m_candidates)
+        for(const auto & l_iter: l_candidates)
         {
             auto l_result = get_correct_conditions(l_iter);
             if(l_result.is_valid())
             {
-                std::cout << l_iter << "->" << l_result << std::endl;
-                relate_candidate_checker(l_iter, l_result, l_bad_checkers, l_candidate_with_bad_checkers);
+                if(is_displayed(verbosity::DEBUG))
+                {
+                    m_sink->write_line(verbosity::DEBUG, l_iter, "->", l_result);
+                }
+                relate_candidate_checker(l_iter, l_result, l_checkers_to_candidate, l_bad_checkers, l_candidate_with_bad_checkers);
             }
             else
             {
                 l_bad_candidates.emplace_back(l_iter);
             }
         }
-        std::cout << l_bad_candidates.size() << " candidates not compliant with potential checkers" << std::endl;
-        std::cout << l_bad_checkers.size() << " checkers associated with several candidates" << std::endl;
-        std::cout << l_candidate_with_bad_checkers.size() << " candidates associated with bad checkers" << std::endl;
-
-        // Remove candidates that have been associated with bad checkers
-        // This is done after because removing them on the fly would not allow
-        // if several potential checkers match 1 candidate
-        for(const auto & l_iter:l_candidate_with_bad_checkers)
+        if(is_displayed(verbosity::SUMMARY))
+        {
+            m_sink->write_line(verbosity::SUMMARY, l_bad_candidates.size(), " candidates not compliant with potential checkers");
+            m_sink->write_line(verbosity::SUMMARY, l_bad_checkers.size(), " checkers associated with several candidates");
+            m_sink->write_line(verbosity::SUMMARY, l_candidate_with_bad_checkers.size(), " candidates associated with bad checkers");
+        }
+
+        // Checkers associated with several candidates have been removed
+        // from map so remaining candidates are the ones it still contains
+        for(const auto & l_iter: l_checkers_to_candidate)
         {
-            m_candidate_to_checkers.erase(l_iter);
+            unsigned int l_code_index = condition_table::code_index(l_iter.second);
+            m_code_to_checkers[l_code_index] = l_iter.first;
+            m_remaining.set(l_code_index);
         }
 
         display_remaining();
     }
 
     //-------------------------------------------------------------------------
-    void
-    solver::display_all_checkers()
+    solver::solver(output_sink * p_sink)
+    :m_sink{p_sink}
     {
-        for(const auto & l_iter: m_all_checkers)
+    }
+
+    //-------------------------------------------------------------------------
+    bool
+    solver::is_displayed(verbosity p_level) const
+    {
+        return m_sink && m_sink->is_enabled(p_level);
+    }
+
+    //-------------------------------------------------------------------------
+    std::vector<uint8_t>
+    solver::serialize() const
+    {
+        // Magic, version, number of checkers, checker ids, remaining codes bitfield
+        std::vector<uint8_t> l_result{m_state_magic, m_state_magic + sizeof(m_state_magic)};
+        l_result.emplace_back(m_state_version);
+        l_result.emplace_back(static_cast<uint8_t>(m_checkers.size()));
+        for(const auto & l_checker: m_checkers)
         {
-            std::cout << l_iter.first << " " << l_iter.second->get_name() << std::endl;
+            if(l_checker->get_id() > std::numeric_limits<uint8_t>::max())
+            {
+                throw quicky_exception::quicky_logic_exception("Checker id " + std::to_string(l_checker->get_id()) + " cannot be serialized, ids must be in range [1,255]", __LINE__, __FILE__);
+            }
+            l_result.emplace_back(static_cast<uint8_t>(l_checker->get_id()));
         }
+        size_t l_codes_position = l_result.size();
+        l_result.resize(l_codes_position + m_state_codes_size, 0);
+        for(unsigned int l_code_index = 0; l_code_index < condition_table::m_nb_codes; ++l_code_index)
+        {
+            if(m_remaining.test(l_code_index))
+            {
+                l_result[l_codes_position + l_code_index / 8] |= static_cast<uint8_t>(1u << (l_code_index % 8));
+            }
+        }
+        return l_result;
+    }
+
+    //-------------------------------------------------------------------------
+    solver
+    solver::deserialize(const std::vector<uint8_t> & p_data
+                       ,bool p_verbose
+                       )
+    {
+        constexpr size_t l_header_size = sizeof(m_state_magic) + 2;
+        if(p_data.size() < l_header_size || !std::equal(m_state_magic, m_state_magic + sizeof(m_state_magic), p_data.begin()))
+        {
+            throw quicky_exception::quicky_logic_exception("Not a solver state", __LINE__, __FILE__);
+        }
+        if(p_data[sizeof(m_state_magic)] != m_state_version)
+        {
+            throw quicky_exception::quicky_logic_exception("Unsupported solver state version " + std::to_string(p_data[sizeof(m_state_magic)]), __LINE__, __FILE__);
+        }
+        size_t l_nb_checkers = p_data[sizeof(m_state_magic) + 1];
+        size_t l_codes_position = l_header_size + l_nb_checkers;
+        if(!l_nb_checkers || l_nb_checkers > potential_checkers::m_max_checkers || p_data.size() != l_codes_position + m_state_codes_size)
+        {
+            throw quicky_exception::quicky_logic_exception("Corrupted solver state", __LINE__, __FILE__);
+        }
+        solver l_solver{p_verbose ? &output_sink::get_console() : nullptr};
+        const checker_registry & l_registry = get_registry();
+        for(size_t l_index = 0; l_index < l_nb_checkers; ++l_index)
+        {
+            l_solver.m_checkers.emplace_back(l_registry.get_checker(p_data[l_header_size + l_index]));
+        }
+        std::set<potential_checkers> l_restored_checkers;
+        for(unsigned int l_code_index = 0; l_code_index < 8 * m_state_codes_size; ++l_code_index)
+        {
+            if(!(p_data[l_codes_position + l_code_index / 8] & (1u << (l_code_index % 8))))
+            {
+                continue;
+            }
+            if(l_code_index >= condition_table::m_nb_codes)
+            {
+                throw quicky_exception::quicky_logic_exception("Corrupted solver state", __LINE__, __FILE__);
+            }
+            candidate l_candidate = condition_table::index_code(l_code_index);
+            potential_checkers l_checkers = l_solver.get_correct_conditions(l_candidate);
+            // A state saved with other checker definitions would give invalid or shared conditions
+            if(!l_checkers.is_valid() || !l_restored_checkers.insert(l_checkers).second)
+            {
+                throw quicky_exception::quicky_logic_exception("Solver state does not match checkers", __LINE__, __FILE__);
+            }
+            l_solver.m_code_to_checkers[l_code_index] = l_checkers;
+            l_solver.m_remaining.set(l_code_index);
+        }
+        l_solver.display_remaining();
+        return l_solver;
+    }
+
+    //-------------------------------------------------------------------------
+    void
+    solver::display_all_checkers(std::ostream & p_stream)
+    {
+        get_registry().display(p_stream);
     }
 
     //-------------------------------------------------------------------------
     void
     solver::display_remaining()
     {
-        std::cout << m_candidate_to_checkers.size() << " candidates remaining" << std::endl;
-        std::cout << m_checkers_to_candidate.size() << " checkers combinations remaining" << std::endl;
-        if(m_candidate_to_checkers.size() == 1)
+        if(!is_displayed(verbosity::SUMMARY))
         {
-            std::cout << "SOLUTION FOUND :";
+            return;
         }
-        for(const auto & l_iter: m_candidate_to_checkers)
+        instrumentation::timer l_timer{instrumentation::phase::DISPLAY};
+        size_t l_nb_remaining = m_remaining.count();
+        m_sink->write_line(verbosity::SUMMARY, l_nb_remaining, " candidates remaining");
+        // Solution line is matched by functional tests, keep its format
+        if(l_nb_remaining == 1)
         {
-            std::cout << l_iter.first << " -> " << l_iter.second << std::endl;
+            unsigned int l_code_index = condition_table::first_code(m_remaining);
+            m_sink->write_line(verbosity::SUMMARY, "SOLUTION FOUND :", condition_table::index_code(l_code_index), " -> ", m_code_to_checkers[l_code_index]);
+        }
+        else
+        {
+            for(unsigned int l_code_index = 0; l_code_index < condition_table::m_nb_codes; ++l_code_index)
+            {
+                if(m_remaining.test(l_code_index))
+                {
+                    m_sink->write_line(verbosity::SUMMARY, condition_table::index_code(l_code_index), " -> ", m_code_to_checkers[l_code_index]);
+                }
+            }
         }
+        m_sink->flush();
     }
 
     //-------------------------------------------------------------------------
     potential_checkers
     solver::get_related_checkers(const candidate & p_candidate) const
     {
-        auto l_iter = m_candidate_to_checkers.find(p_candidate);
-        if(l_iter == m_candidate_to_checkers.end())
+        unsigned int l_code_index = condition_table::code_index(p_candidate);
+        if(!m_remaining.test(l_code_index))
         {
             throw quicky_exception::quicky_logic_exception("Bad candidate", __LINE__, __FILE__);
         }
-        return l_iter->second;
+        return m_code_to_checkers[l_code_index];
     }
 
     //-------------------------------------------------------------------------
@@ -223,43 +522,58 @@ namespace turing_machine_solver
                           ,bool l_result
                           )
     {
-        if(p_checker_index > m_checkers.size())
+        if(p_checker_index >= m_checkers.size())
         {
             throw quicky_exception::quicky_logic_exception("Bad checker value " + std::to_string(p_checker_index) + ", should be in range [0," + std::to_string(m_checkers.size() - 1) + ']'
                                                           , __LINE__
                                                           , __FILE__
                                                           );
         }
-        std::vector<potential_checkers> l_bad_checkers;
-        std::vector<candidate> l_bad_candidates;
-        for(const auto & l_iter_candidate: m_candidate_to_checkers)
         {
-            if(!l_iter_candidate.second.is_compliant_with(p_checker_index, p_checkers, l_result))
+            instrumentation::timer l_timer{instrumentation::phase::ELIMINATION};
+            unsigned int l_nb_eliminated = 0;
+            for(unsigned int l_code_index = 0; l_code_index < condition_table::m_nb_codes; ++l_code_index)
             {
-                l_bad_checkers.emplace_back(l_iter_candidate.second);
-                l_bad_candidates.emplace_back(l_iter_candidate.first);
+                if(m_remaining.test(l_code_index) && !m_code_to_checkers[l_code_index].is_compliant_with(p_checker_index, p_checkers, l_result))
+                {
+                    m_remaining.reset(l_code_index);
+                    ++l_nb_eliminated;
+                }
             }
+            instrumentation::add(instrumentation::counter::ANALYZE_CALLS);
+            instrumentation::add(instrumentation::counter::CODES_ELIMINATED, l_nb_eliminated);
         }
-        for(const auto & l_iter_candidate: l_bad_candidates)
-        {
-            m_candidate_to_checkers.erase(l_iter_candidate);
-        }
-        for(const auto & l_iter_checker: l_bad_checkers)
+        display_remaining();
+    }
+
+    //-------------------------------------------------------------------------
+    void
+    solver::analyze_result(const candidate & p_candidate
+                          ,unsigned int p_checker_index
+                          ,bool p_result
+                          )
+    {
+        unsigned int l_code_index = condition_table::code_index(p_candidate);
+        if(!m_code_to_checkers[l_code_index].get_nb_checkers())
         {
-            m_checkers_to_candidate.erase(l_iter_checker);
+            throw quicky_exception::quicky_logic_exception("Bad candidate", __LINE__, __FILE__);
         }
-        display_remaining();
+        analyze_result(m_code_to_checkers[l_code_index], p_checker_index, p_result);
     }
 
     //-------------------------------------------------------------------------
     potential_checkers
     solver::get_correct_conditions(const candidate & p_candidate)
     {
+        instrumentation::timer l_timer{instrumentation::phase::SIGNATURES};
         potential_checkers l_result;
         for(const auto & l_iter:m_checkers)
         {
             l_result.add(l_iter->get_correct_conditions(p_candidate));
+            // Each condition of checker is evaluated
+            instrumentation::add(instrumentation::counter::PREDICATE_CALLS, l_iter->get_grade());
         }
+        instrumentation::add(instrumentation::counter::SIGNATURES);
         return l_result;
     }
 
@@ -272,6 +586,14 @@ namespace turing_machine_solver
         {
             l_symbols.emplace_back(l_grade + 1, p_max_grade);
         }
+        // Combinations are only displayed
+        if(!is_displayed(verbosity::DEBUG))
+        {
+            return;
+        }
+        instrumentation::timer l_timer{instrumentation::phase::POTENTIAL_CHECKERS};
+        // Only needed during construction so it does not weigh on solver copies
+        std::set<std::string> l_potential_checkers;
         combinatorics::enumerator l_enumerator{l_symbols, static_cast<unsigned int>(m_checkers.size())};
         while(l_enumerator.generate())
         {
@@ -292,918 +614,116 @@ namespace turing_machine_solver
             }
             if(l_ok)
             {
-                std::cout << "Potential checker combination: " << l_str << std::endl;
-                m_potential_checkers.insert(l_str);
+                m_sink->write_line(verbosity::DEBUG, "Potential checker combination: ", l_str);
+                l_potential_checkers.insert(l_str);
             }
         }
-        std::cout << m_potential_checkers.size() << " checker combinations possible" << std::endl;
+        m_sink->write_line(verbosity::DEBUG, l_potential_checkers.size(), " checker combinations possible");
     }
 
     //-------------------------------------------------------------------------
     void
     solver::register_all_checkers()
     {
-        register_checker(std::shared_ptr<checker_if>
-                         {new checker_base<3>
-                          (2
-                          ,"Le chiffre du triangle bleu comparé à 3"
-                          ,{checker_func{[](const candidate &p_candidate) -> bool
-                                         {return p_candidate.get_blue_triangle() < 3;}
-                                        ,"bleu < 3"
-                                        }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {return p_candidate.get_blue_triangle() == 3;}
-                            ,"bleu == 3"
-                            }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {return p_candidate.get_blue_triangle() > 3;}
-                            , "bleu > à 3"
-                            }
-                           }
-                          )
-                         }
-                        );
-        register_checker(std::shared_ptr<checker_if>
-                         {new checker_base<3>
-                          (3
-                          ,"Le chiffre du carre jaune comparé à 3"
-                          ,{checker_func{[](const candidate &p_candidate) -> bool
-                                         {return p_candidate.get_yellow_square() < 3;}
-                                        ,"jaune < 3"
-                                        }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {return p_candidate.get_yellow_square() == 3;}
-                            ,"jaune == 3"
-                            }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {return p_candidate.get_yellow_square() > 3;}
-                             , "jaune > à 3"
-                            }
-                           }
-                          )
-                         }
-                        );
-        register_checker(std::shared_ptr<checker_if>
-                         {new checker_base<3>
-                          (4
-                          ,"Le chiffre du carré jaune comparé à  4"
-                          ,{checker_func{[](const candidate &p_candidate) -> bool
-                                         {return p_candidate.get_yellow_square() < 4;}
-                                        ,"jaune < 4"
-                                        }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {return p_candidate.get_yellow_square() == 4;}
-                            ,"jaune == 4"
-                            }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {return p_candidate.get_yellow_square() > 4;}
-                             , "jaune > à 4"
-                            }
-                           }
-                          )
-                         }
-                        );
-        register_checker(std::shared_ptr<checker_if>
-                         {new checker_base<2>
-                          (5
-                          ,"Triangle bleu est pair ou impair"
-                          ,{checker_func{[](const candidate &p_candidate) -> bool
-                                         {return !(p_candidate.get_blue_triangle() % 2);}
-                                        ,"Bleu est pair"
-                                        }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {return (p_candidate.get_blue_triangle() % 2);}
-                            ,"Jaune est impair"
-                            }
-                           }
-                          )
-                         }
-                        );
-        register_checker(std::shared_ptr<checker_if>
-                         {new checker_base<2>
-                          (6
-                          ,"Carre jaune est pair ou impair"
-                          ,{checker_func{[](const candidate &p_candidate) -> bool
-                                         {return !(p_candidate.get_yellow_square() % 2);}
-                                        ,"Jaune est pair"
-                                        }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {return (p_candidate.get_yellow_square() % 2);}
-                            ,"Jaune est impair"
-                            }
-                           }
-                          )
-                         }
-                        );
-        register_checker(std::shared_ptr<checker_if>
-                         {new checker_base<2>
-                          (7
-                          ,"cercle violet pair ou impair"
-                          ,{checker_func{[](const candidate &p_candidate) -> bool
-                                         {return !(p_candidate.get_purple_circle() % 2);}
-                                        ,"violet est pair"
-                                        }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {return (p_candidate.get_purple_circle() % 2);}
-                            ,"violet est impair"
-                            }
-                           }
-                          )
-                         }
-                        );
-        register_checker(std::shared_ptr<checker_if>
-                         {new checker_base<4>
-                          (8
-                          ,"Le nombre de chiffre 1 dans le code"
-                          ,{checker_func{[](const candidate &p_candidate) -> bool
-                                         {return 0 == (p_candidate.get_yellow_square() == 1)
-                                                    + (p_candidate.get_purple_circle() == 1)
-                                                    + (p_candidate.get_blue_triangle() == 1);
-                                         }
-                                        ,"pas de 1"
-                                        }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {return 1 == (p_candidate.get_yellow_square() == 1)
-                                        + (p_candidate.get_purple_circle() == 1)
-                                        + (p_candidate.get_blue_triangle() == 1);
-                             }
-                            ,"un 1"
-                            }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {return 2 == (p_candidate.get_yellow_square() == 1)
-                                        + (p_candidate.get_purple_circle() == 1)
-                                        + (p_candidate.get_blue_triangle() == 1);
-                             }
-                             , "deux 1"
-                            }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {return 3 == (p_candidate.get_yellow_square() == 1)
-                                        + (p_candidate.get_purple_circle() == 1)
-                                        + (p_candidate.get_blue_triangle() == 1);
-                             }
-                            ,"trois 1"
-                            }
-                           }
-                          )
-                         }
-                        );
-        register_checker(std::shared_ptr<checker_if>
-                         {new checker_base<4>
-                          (9
-                          ,"Le nombre de chiffre 3 dans le code"
-                          ,{checker_func{[](const candidate &p_candidate) -> bool
-                                         {return 0 == (p_candidate.get_yellow_square() == 3)
-                                                    + (p_candidate.get_purple_circle() == 3)
-                                                    + (p_candidate.get_blue_triangle() == 3);
-                                         }
-                                        ,"pas de 3"
-                                        }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {return 1 == (p_candidate.get_yellow_square() == 3)
-                                        + (p_candidate.get_purple_circle() == 3)
-                                        + (p_candidate.get_blue_triangle() == 3);
-                             }
-                            ,"un 3"
-                            }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {return 2 == (p_candidate.get_yellow_square() == 3)
-                                        + (p_candidate.get_purple_circle() == 3)
-                                        + (p_candidate.get_blue_triangle() == 3);
-                             }
-                             , "deux 3"
-                            }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {return 3 == (p_candidate.get_yellow_square() == 3)
-                                        + (p_candidate.get_purple_circle() == 3)
-                                        + (p_candidate.get_blue_triangle() == 3);
-                             }
-                            ,"trois 3"
-                            }
-                           }
-                          )
-                         }
-                        );
-        register_checker(std::shared_ptr<checker_if>
-                         {new checker_base<4>
-                          (10
-                          ,"Le nombre de chiffre 4 dans le code"
-                          ,{checker_func{[](const candidate &p_candidate) -> bool
-                                         {return 0 == (p_candidate.get_yellow_square() == 4)
-                                                    + (p_candidate.get_purple_circle() == 4)
-                                                    + (p_candidate.get_blue_triangle() == 4);
-                                         }
-                                        ,"pas de 4"
-                                        }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {return 1 == (p_candidate.get_yellow_square() == 4)
-                                        + (p_candidate.get_purple_circle() == 4)
-                                        + (p_candidate.get_blue_triangle() == 4);
-                             }
-                            ,"un 4"
-                            }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {return 2 == (p_candidate.get_yellow_square() == 4)
-                                        + (p_candidate.get_purple_circle() == 4)
-                                        + (p_candidate.get_blue_triangle() == 4);
-                             }
-                             , "deux 4"
-                            }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {return 3 == (p_candidate.get_yellow_square() == 4)
-                                        + (p_candidate.get_purple_circle() == 4)
-                                        + (p_candidate.get_blue_triangle() == 4);
-                             }
-                            ,"trois 4"
-                            }
-                           }
-                          )
-                         }
-                        );
-        register_checker(std::shared_ptr<checker_if>
-                         {new checker_base<3>
-                          (11
-                          ,"Le chiffre du triangle bleu comparé au carre jaune"
-                          ,{checker_func{[](const candidate &p_candidate) -> bool
-                                         {return p_candidate.get_blue_triangle() < p_candidate.get_yellow_square();}
-                                        ,"bleu < jaune"
-                                        }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {return p_candidate.get_blue_triangle() == p_candidate.get_yellow_square();}
-                            ,"bleu == jaune"
-                            }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {return p_candidate.get_blue_triangle() > p_candidate.get_yellow_square();}
-                             , "bleu > à jaune"
-                            }
-                           }
-                          )
-                         }
-                        );
-        register_checker(std::shared_ptr<checker_if>
-                         {new checker_base<3>
-                          (12
-                          ,"Le chiffre du triangle bleu comparé au cercle violet"
-                          ,{checker_func{[](const candidate &p_candidate) -> bool
-                                         {return p_candidate.get_blue_triangle() < p_candidate.get_purple_circle();}
-                                        ,"bleu < violet"
-                                        }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {return p_candidate.get_blue_triangle() == p_candidate.get_purple_circle();}
-                            ,"bleu == violet"
-                            }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {return p_candidate.get_blue_triangle() > p_candidate.get_purple_circle();}
-                             , "bleu > à violet"
-                            }
-                           }
-                          )
-                         }
-                        );
-        register_checker(std::shared_ptr<checker_if>
-                         {new checker_base<3>
-                          (13
-                          ,"Le chiffre du carré jaune comparé au cercle violet"
-                          ,{checker_func{[](const candidate &p_candidate) -> bool
-                                         {return p_candidate.get_yellow_square() < p_candidate.get_purple_circle();}
-                                        ,"jaune < violet"
-                                        }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {return p_candidate.get_yellow_square() == p_candidate.get_purple_circle();}
-                            ,"jaune == violet"
-                            }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {return p_candidate.get_yellow_square() > p_candidate.get_purple_circle();}
-                             , "jaune > à violet"
-                            }
-                           }
-                          )
-                         }
-                        );
-        register_checker(std::shared_ptr<checker_if>
-                         {new checker_base<3>
-                          (14
-                          ,"Quelle couleur a le chiffre plus petit que les autres"
-                          ,{checker_func{[](const candidate &p_candidate) -> bool
-                                         {return p_candidate.get_blue_triangle() < p_candidate.get_yellow_square()
-                                             &&  p_candidate.get_blue_triangle() < p_candidate.get_purple_circle();}
-                                        ,"bleu < (jaune && violet)"
-                                        }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {return p_candidate.get_yellow_square() < p_candidate.get_purple_circle()
-                                  && p_candidate.get_yellow_square() < p_candidate.get_blue_triangle();}
-                            ,"jaune < (bleu && violeti)"
-                            }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {return p_candidate.get_purple_circle() < p_candidate.get_yellow_square()
-                                  && p_candidate.get_purple_circle() < p_candidate.get_blue_triangle();}
-                             , "violet < (jaune && bleu)"
-                            }
-                           }
-                          )
-                         }
-                        );
-        register_checker(std::shared_ptr<checker_if>
-                         {new checker_base<3>
-                          (15
-                          ,"Quelle couleur a le chiffre plus grand que les autres"
-                          ,{checker_func{[](const candidate &p_candidate) -> bool
-                                         {return p_candidate.get_blue_triangle() > p_candidate.get_yellow_square()
-                                             &&  p_candidate.get_blue_triangle() > p_candidate.get_purple_circle();}
-                                        ,"bleu > (jaune && violet)"
-                                        }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {return p_candidate.get_yellow_square() > p_candidate.get_purple_circle()
-                                  && p_candidate.get_yellow_square() > p_candidate.get_blue_triangle();}
-                            ,"jaune > (bleu && violeti)"
-                            }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {return p_candidate.get_purple_circle() > p_candidate.get_yellow_square()
-                                  && p_candidate.get_purple_circle() > p_candidate.get_blue_triangle();}
-                             , "violet > (jaune && bleu)"
-                            }
-                           }
-                          )
-                         }
-                        );
-        register_checker(std::shared_ptr<checker_if>
-                         {new checker_base<2>
-                          (16
-                          ,"Le nombre de chiffres pairs compare au nombre de chiffres impairs"
-                          ,{checker_func{[](const candidate &p_candidate) -> bool
-                                         {unsigned int l_nb_impair = (p_candidate.get_purple_circle() % 2) +
-                                                                     (p_candidate.get_yellow_square() % 2) +
-                                                                     (p_candidate.get_blue_triangle() % 2);
-                                          return 3 - l_nb_impair > l_nb_impair;
-                                         }
-                                        ,"Pair > Impair"
-                                        }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {unsigned int l_nb_impair = (p_candidate.get_purple_circle() % 2) +
-                                                         (p_candidate.get_yellow_square() % 2) +
-                                                         (p_candidate.get_blue_triangle() % 2);
-                              return 3 - l_nb_impair < l_nb_impair;
-                             }
-                            ,"Pair < impair"
-                            }
-                           }
-                          )
-                         }
-                        );
-        register_checker(std::shared_ptr<checker_if>
-                         {new checker_base<4>
-                          (17
-                          ,"Le nombre de chiffre pair dans le code"
-                          ,{checker_func{[](const candidate &p_candidate) -> bool
-                                         {return 3 == (p_candidate.get_yellow_square() % 2)
-                                                    + (p_candidate.get_purple_circle() % 2)
-                                                    + (p_candidate.get_blue_triangle() % 2);
-                                         }
-                                        ,"aucun chiffre pair"
-                                        }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {return 2 == (p_candidate.get_yellow_square() % 2)
-                                        + (p_candidate.get_purple_circle() % 2)
-                                        + (p_candidate.get_blue_triangle() % 2);
-                             }
-                            ,"un chiffres pair"
-                            }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {return 1 == (p_candidate.get_yellow_square() % 2)
-                                        + (p_candidate.get_purple_circle() % 2)
-                                        + (p_candidate.get_blue_triangle() % 2);
-                             }
-                             ,"deux chiffre pair"
-                            }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {return 0 == (p_candidate.get_yellow_square() % 2)
-                                        + (p_candidate.get_purple_circle() % 2)
-                                        + (p_candidate.get_blue_triangle() % 2);
-                             }
-                            ,"trois chiffres pair"
-                            }
-                           }
-                          )
-                         }
-                        );
-        register_checker(std::shared_ptr<checker_if>
-                         {new checker_base<2>
-                          (18
-                          ,"La somme de tous les chiffres est paire ou impaire"
-                          ,{checker_func{[](const candidate &p_candidate) -> bool
-                                         {return !((p_candidate.get_yellow_square()
-                                                  + p_candidate.get_purple_circle()
-                                                  + p_candidate.get_blue_triangle()
-                                                   ) % 2
-                                                  );
-                                         }
-                                        ,"La somme des chiffres est paire"
-                                        }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {return ((p_candidate.get_yellow_square()
-                                     + p_candidate.get_purple_circle()
-                                     + p_candidate.get_blue_triangle()
-                                      ) % 2
-                                     );
-                             }
-                            ,"La somme des chiffres est impaire"
-                            }
-                           }
-                          )
-                         }
-                        );
-        register_checker(std::shared_ptr<checker_if>
-                         {new checker_base<3>
-                          (19
-                          ,"La somme du triangle bleu et du carre jaune comparee a 6"
-                          ,{checker_func{[](const candidate &p_candidate) -> bool
-                                         {return (p_candidate.get_blue_triangle() + p_candidate.get_yellow_square()) < 6;}
-                                        ,"bleu + jaune < 6"
-                                        }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {return (p_candidate.get_blue_triangle() + p_candidate.get_yellow_square()) == 6;}
-                            ,"bleu + jaune = 6"
-                            }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {return (p_candidate.get_blue_triangle() + p_candidate.get_yellow_square()) > 6;}
-                             , "bleu + jaune > 6"
-                            }
-                           }
-                          )
-                         }
-                        );
-        register_checker(std::shared_ptr<checker_if>
-                         {new checker_base<3>
-                          (20
-                          ,"Un chiffre se repete dans le code"
-                          ,{checker_func{[](const candidate &p_candidate) -> bool
-                                         {return (p_candidate.get_blue_triangle() == p_candidate.get_yellow_square() && p_candidate.get_blue_triangle() == p_candidate.get_purple_circle());}
-                                        ,"un chiffre triple"
-                                        }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {return 2 == ((p_candidate.get_blue_triangle() == p_candidate.get_yellow_square()) +
-                                           (p_candidate.get_blue_triangle() == p_candidate.get_purple_circle()) +
-                                           (p_candidate.get_yellow_square() == p_candidate.get_purple_circle())
-                                          );
-                             }
-                            ,"un chiffre double"
-                            }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {return (p_candidate.get_blue_triangle() != p_candidate.get_yellow_square() &&
-                                      p_candidate.get_blue_triangle() != p_candidate.get_purple_circle() &&
-                                      p_candidate.get_yellow_square() != p_candidate.get_purple_circle()
-                                     );
-                             }
-                             , "pas de repetition"
-                            }
-                           }
-                          )
-                         }
-                        );
-        register_checker(std::shared_ptr<checker_if>
-                         {new checker_base<2>
-                          (21
-                          ,"Un chiffre est prsent exactement 2 fois dans le code"
-                          ,{checker_func{[](const candidate &p_candidate) -> bool
-                                         {unsigned int l_repeat[5] = {0,0,0,0,0};
-                                          l_repeat[p_candidate.get_blue_triangle()]++;
-                                          l_repeat[p_candidate.get_yellow_square()]++;
-                                          l_repeat[p_candidate.get_purple_circle()]++;
-                                         return l_repeat[p_candidate.get_blue_triangle()] != 2 && l_repeat[p_candidate.get_yellow_square()] != 2 && l_repeat[p_candidate.get_purple_circle()] != 2;
-                                         }
-                                        ,"Pas de paire"
-                                        }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {unsigned int l_repeat[5] = {0,0,0,0,0};
-                              l_repeat[p_candidate.get_blue_triangle()]++;
-                              l_repeat[p_candidate.get_yellow_square()]++;
-                              l_repeat[p_candidate.get_purple_circle()]++;
-                              return l_repeat[p_candidate.get_blue_triangle()] == 2 || l_repeat[p_candidate.get_yellow_square()] == 2 || l_repeat[p_candidate.get_purple_circle()] == 2;
-                             }
-                            ,"Une paire"
-                            }
-                           }
-                          )
-                         }
-                        );
-        register_checker(std::shared_ptr<checker_if>
-                         {new checker_base<3>
-                          (23
-                          ,"La somme de tous les chiffres comparee a 6"
-                          ,{checker_func{[](const candidate &p_candidate) -> bool
-                                         {return (p_candidate.get_blue_triangle() + p_candidate.get_yellow_square() + p_candidate.get_purple_circle()) < 6;}
-                                        ,"La somme est plus petite que 6"
-                                        }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {return (p_candidate.get_blue_triangle() + p_candidate.get_yellow_square() + p_candidate.get_purple_circle()) == 6;}
-                            ,"La omme est egale a 6"
-                            }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {return (p_candidate.get_blue_triangle() + p_candidate.get_yellow_square() + p_candidate.get_purple_circle()) > 6;}
-                             , "La somme est superieure a 6"
-                            }
-                           }
-                          )
-                         }
-                        );
-        register_checker(std::shared_ptr<checker_if>
-                         {new checker_base<3>
-                          (24
-                          ,"Il y a une suite croissante de chiffres consecutifs"
-                          ,{checker_func{[](const candidate &p_candidate) -> bool
-                                         {return ((p_candidate.get_blue_triangle() == (p_candidate.get_yellow_square() - 1))
-                                               && (p_candidate.get_yellow_square() == (p_candidate.get_purple_circle() - 1))
-                                                 );
-                                         }
-                                        ,"3 chiffres en ordre croissant consecutifs"
-                                        }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {return ((p_candidate.get_blue_triangle() == (p_candidate.get_yellow_square() - 1)) 
-                                    ^ (p_candidate.get_yellow_square() == (p_candidate.get_purple_circle() - 1))
-                                     );
-                             }
-                            ,"2 chiffres en ordre croissant consecutif"
-                            }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {return ((p_candidate.get_blue_triangle() != (p_candidate.get_yellow_square() - 1)) 
-                                   && (p_candidate.get_yellow_square() != (p_candidate.get_purple_circle() - 1))
-                                     );
-                             }
-                             ,"Pas de chiffres en ordre croissant consecutif"
-                            }
-                           }
-                          )
-                         }
-                        );
-        register_checker(std::shared_ptr<checker_if>
-                         {new checker_base<3>
-                          (25
-                          ,"Il y a une suite croissante ou decroissante de chiffres consecutifs"
-                          ,{checker_func{[](const candidate &p_candidate) -> bool
-                                         {return (p_candidate.get_blue_triangle() != (p_candidate.get_yellow_square() + 1) && p_candidate.get_yellow_square() != (p_candidate.get_purple_circle() + 1) &&
-                                                  p_candidate.get_blue_triangle() != (p_candidate.get_yellow_square() - 1) && p_candidate.get_yellow_square() != (p_candidate.get_purple_circle() - 1)
-                                                 );
-                                         }
-                                        ,"Pas de suite croissante ou decroissante de chiffre consecutifs"
-                                        }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {return ((p_candidate.get_blue_triangle() == (p_candidate.get_yellow_square() - 1)) && (p_candidate.get_yellow_square() != (p_candidate.get_purple_circle() - 1))) ||
-                                     ((p_candidate.get_blue_triangle() != (p_candidate.get_yellow_square() - 1)) && (p_candidate.get_yellow_square() == (p_candidate.get_purple_circle() - 1))) ||
-                                     ((p_candidate.get_blue_triangle() == (p_candidate.get_yellow_square() + 1)) && (p_candidate.get_yellow_square() != (p_candidate.get_purple_circle() + 1))) ||
-                                     ((p_candidate.get_blue_triangle() != (p_candidate.get_yellow_square() + 1)) && (p_candidate.get_yellow_square() == (p_candidate.get_purple_circle() + 1)))
-                                     ;
-                             }
-                            ,"2 chiffres en ordre croissant ou decroissant consecutifs"
-                            }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {return ((p_candidate.get_blue_triangle() == (p_candidate.get_yellow_square()  - 1) && p_candidate.get_yellow_square() == (p_candidate.get_purple_circle() - 1)) ||
-                                      (p_candidate.get_blue_triangle() == (p_candidate.get_yellow_square()  + 1) && p_candidate.get_yellow_square() == (p_candidate.get_purple_circle() + 1))
-                                     );
-                             }
-                             , "3 chiffres en ordre croissant ou decroissant consecutifs"
-                            }
-                           }
-                          )
-                         }
-                        );
-        register_checker(std::shared_ptr<checker_if>
-                         {new checker_base<3>
-                          (28
-                          ,"Une couleur specifique est egale a 1"
-                          ,{checker_func{[](const candidate &p_candidate) -> bool
-                                         {return p_candidate.get_blue_triangle() == 1;}
-                                        ,"Bleu egal a 1"
-                                        }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {return p_candidate.get_yellow_square() == 1;}
-                            ,"Jaune egal a 1"
-                            }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {return p_candidate.get_purple_circle() == 1;}
-                             , "Violet est egal a 1"
-                            }
-                           }
-                          )
-                         }
-                        );
-        register_checker(std::shared_ptr<checker_if>
-                         {new checker_base<3>
-                          (32
-                          ,"Une couleur specifique est plus grande que 3"
-                          ,{checker_func{[](const candidate &p_candidate) -> bool
-                                         {return p_candidate.get_blue_triangle() > 3;}
-                                        ,"Bleu > 3"
-                                        }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {return p_candidate.get_yellow_square() > 3;}
-                            ,"Jaune > 3"
-                            }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {return p_candidate.get_purple_circle() > 3;}
-                             , "Violet > 3"
-                            }
-                           }
-                          )
-                         }
-                        );
-        register_checker(std::shared_ptr<checker_if>
-                         {new checker_base<6>
-                          (33
-                          ,"Une couleur specifique est paire ou impaire"
-                          ,{checker_func{[](const candidate &p_candidate) -> bool
-                                         {return !(p_candidate.get_blue_triangle() % 2);}
-                                        ,"bleu est pair"
-                                        }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {return !(p_candidate.get_yellow_square() % 2);}
-                            ,"jaune est pair"
-                            }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {return !(p_candidate.get_purple_circle() % 2);}
-                             , "violet est pair"
-                            }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {return (p_candidate.get_blue_triangle() % 2);}
-                            ,"bleu est impair"
-                            }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {return (p_candidate.get_yellow_square() % 2);}
-                            ,"jaune est impair"
-                            }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {return (p_candidate.get_purple_circle() % 2);}
-                             , "violet est impair"
-                            }
-                           }
-                          )
-                         }
-                        );
-        register_checker(std::shared_ptr<checker_if>
-                         {new checker_base<3>
-                          (34
-                          ,"Quelle couleur a le chiffre plus petit ( ou a egalite avec le chiffre le plus petit )"
-                          ,{checker_func{[](const candidate &p_candidate) -> bool
-                                         {return p_candidate.get_blue_triangle() <= p_candidate.get_yellow_square()
-                                             &&  p_candidate.get_blue_triangle() <= p_candidate.get_purple_circle();
-                                         }
-                                        ,"bleu <= (jaune && violet)"
-                                        }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {return p_candidate.get_yellow_square() <= p_candidate.get_purple_circle()
-                                  && p_candidate.get_yellow_square() <= p_candidate.get_blue_triangle();
-                             }
-                            ,"jaune <= (bleu && violeti)"
-                            }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {return p_candidate.get_purple_circle() <= p_candidate.get_yellow_square()
-                                  && p_candidate.get_purple_circle() <= p_candidate.get_blue_triangle();}
-                             , "violet <= (jaune && bleu)"
-                            }
-                           }
-                          )
-                         }
-                        );
-        register_checker(std::shared_ptr<checker_if>
-                         {new checker_base<3>
-                          (35
-                          ,"Quelle couleur a le chiffre plus grand ( ou a egalite avec le chiffre le plus grand )"
-                          ,{checker_func{[](const candidate &p_candidate) -> bool
-                                         {return p_candidate.get_blue_triangle() >= p_candidate.get_yellow_square()
-                                             &&  p_candidate.get_blue_triangle() >= p_candidate.get_purple_circle();
-                                         }
-                                        ,"bleu >= (jaune && violet)"
-                                        }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {return p_candidate.get_yellow_square() >= p_candidate.get_purple_circle()
-                                  && p_candidate.get_yellow_square() >= p_candidate.get_blue_triangle();
-                             }
-                            ,"jaune >= (bleu && violeti)"
-                            }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {return p_candidate.get_purple_circle() >= p_candidate.get_yellow_square()
-                                  && p_candidate.get_purple_circle() >= p_candidate.get_blue_triangle();}
-                             , "violet >= (jaune && bleu)"
-                            }
-                           }
-                          )
-                         }
-                        );
-        register_checker(std::shared_ptr<checker_if>
-                         {new checker_base<3>
-                          (36
-                          ,"La somme de tous les chiffres est un multiple de 3 ou 4 ou 5"
-                          ,{checker_func{[](const candidate &p_candidate) -> bool
-                                         {return !((p_candidate.get_blue_triangle() + p_candidate.get_yellow_square() + p_candidate.get_purple_circle()) % 3);}
-                                        ,"La somme de tous les chiffres est un multiple de 3"
-                                        }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {return !((p_candidate.get_blue_triangle() + p_candidate.get_yellow_square() + p_candidate.get_purple_circle()) % 4);}
-                            ,"La somme de tous les chiffres est un multiple de 4"
-                            }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {return !((p_candidate.get_blue_triangle() + p_candidate.get_yellow_square() + p_candidate.get_purple_circle()) % 5);}
-                             , "La somme de tous les chiffres est un multiple de 5"
-                            }
-                           }
-                          )
-                         }
-                        );
-        register_checker(std::shared_ptr<checker_if>
-                         {new checker_base<6>
-                          (42
-                          ,"Quelle couleur est le plus petit ou le plus grand"
-                          ,{checker_func{[](const candidate &p_candidate) -> bool
-                                         {return p_candidate.get_blue_triangle() < p_candidate.get_yellow_square()
-                                             &&  p_candidate.get_blue_triangle() < p_candidate.get_purple_circle();}
-                                        ,"bleu < (jaune && violet)"
-                                        }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {return p_candidate.get_yellow_square() < p_candidate.get_purple_circle()
-                                  && p_candidate.get_yellow_square() < p_candidate.get_blue_triangle();}
-                            ,"jaune < (bleu && violeti)"
-                            }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {return p_candidate.get_purple_circle() < p_candidate.get_yellow_square()
-                                  && p_candidate.get_purple_circle() < p_candidate.get_blue_triangle();}
-                             , "violet < (jaune && bleu)"
-                            }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {return p_candidate.get_blue_triangle() > p_candidate.get_yellow_square()
-                                 &&  p_candidate.get_blue_triangle() > p_candidate.get_purple_circle();}
-                             ,"bleu > (jaune && violet)"
-                            }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {return p_candidate.get_yellow_square() > p_candidate.get_purple_circle()
-                                  && p_candidate.get_yellow_square() > p_candidate.get_blue_triangle();}
-                            ,"jaune > (bleu && violeti)"
-                            }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {return p_candidate.get_purple_circle() > p_candidate.get_yellow_square()
-                                  && p_candidate.get_purple_circle() > p_candidate.get_blue_triangle();}
-                             , "violet > (jaune && bleu)"
-                            }
-                           }
-                          )
-                         }
-                        );
-        register_checker(std::shared_ptr<checker_if>
-                         {new checker_base<6>
-                          (46
-                          ,"Combien il y a de 3 ou combien il y a de 4 dans le code"
-                          ,{checker_func{[](const candidate &p_candidate) -> bool
-                                         {uint32_t l_nb = 0;
-                                          l_nb += (p_candidate.get_blue_triangle() == 3);
-                                          l_nb += (p_candidate.get_yellow_square() == 3);
-                                          l_nb += (p_candidate.get_purple_circle() == 3);
-					  return !l_nb;
-                                         }
-                                        ,"Pas de 3"
-                                        }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {uint32_t l_nb = 0;
-                              l_nb += (p_candidate.get_blue_triangle() == 3);
-                              l_nb += (p_candidate.get_yellow_square() == 3);
-                              l_nb += (p_candidate.get_purple_circle() == 3);
-                              return 1 == l_nb;
-                             }
-                            ,"Un 3"
-                            }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {uint32_t l_nb = 0;
-                              l_nb += (p_candidate.get_blue_triangle() == 3);
-                              l_nb += (p_candidate.get_yellow_square() == 3);
-                              l_nb += (p_candidate.get_purple_circle() == 3);
-                              return 2 == l_nb;
-                             }
-                             , "Deux 3"
-                            }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {uint32_t l_nb = 0;
-                              l_nb += (p_candidate.get_blue_triangle() == 4);
-                              l_nb += (p_candidate.get_yellow_square() == 4);
-                              l_nb += (p_candidate.get_purple_circle() == 4);
-                              return !l_nb;
-                             }
-                             ,"Pas de 4"
-                            }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {uint32_t l_nb = 0;
-                              l_nb += (p_candidate.get_blue_triangle() == 4);
-                              l_nb += (p_candidate.get_yellow_square() == 4);
-                              l_nb += (p_candidate.get_purple_circle() == 4);
-                              return 1 == l_nb;
-                             }
-                            ,"Un 4"
-                            }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {uint32_t l_nb = 0;
-                              l_nb += (p_candidate.get_blue_triangle() == 4);
-                              l_nb += (p_candidate.get_yellow_square() == 4);
-                              l_nb += (p_candidate.get_purple_circle() == 4);
-                              return 2 == l_nb;
-                             }
-                             , "Deux 4"
-                            }
-                           }
-                          )
-                         }
-                        );
-        register_checker(std::shared_ptr<checker_if>
-                         {new checker_base<9>
-                          (48
-                          ,"Une couleur specifique comparee a une autre couleur specifique"
-                          ,{checker_func{[](const candidate &p_candidate) -> bool
-                                         {return p_candidate.get_blue_triangle() < p_candidate.get_yellow_square();}
-                                        ,"bleu < jaune"
-                                        }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {return p_candidate.get_blue_triangle() < p_candidate.get_purple_circle();}
-                            ,"bleu < violet"
-                            }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {return p_candidate.get_yellow_square() < p_candidate.get_purple_circle();}
-                            , "jaune < violet"
-                            }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {return p_candidate.get_blue_triangle() == p_candidate.get_yellow_square();}
-                            ,"jaune = violet"
-                            }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {return p_candidate.get_blue_triangle() == p_candidate.get_purple_circle();}
-                            ,"bleu = violet"
-                            }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {return p_candidate.get_yellow_square() == p_candidate.get_purple_circle();}
-                            , "jaune = violet"
-                            }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {return p_candidate.get_blue_triangle() > p_candidate.get_yellow_square();}
-                            ,"jaune > violet"
-                            }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {return p_candidate.get_blue_triangle() > p_candidate.get_purple_circle();}
-                            ,"bleu > violet"
-                            }
-                           ,{[](const candidate &p_candidate) -> bool
-                             {return p_candidate.get_yellow_square() > p_candidate.get_purple_circle();}
-                            , "jaune > violet"
-                            }
-                           }
-                          )
-                         }
-                        );
+        (void)get_registry();
     }
 
     //-------------------------------------------------------------------------
-    std::shared_ptr<checker_if>
-    solver::get_checker(unsigned int p_id)
+    const checker_registry &
+    solver::get_registry()
+    {
+        // Initialisation of function static variable is thread safe
+        static const checker_registry l_registry{create_all_checkers()};
+        return l_registry;
+    }
+
+    //-------------------------------------------------------------------------
+    std::vector<std::shared_ptr<checker_if>>
+    solver::create_all_checkers()
     {
-        auto l_iter = m_all_checkers.find(p_id);
-        if(m_all_checkers.end() == l_iter)
+        std::vector<std::shared_ptr<checker_if>> l_checkers = card_catalogue::load_embedded();
+        if(const char * l_file_name = std::getenv("TURING_MACHINE_SOLVER_CARDS"))
         {
-            throw quicky_exception::quicky_logic_exception("No checker with ID " + std::to_string(p_id), __LINE__, __FILE__);
+            card_catalogue::merge(l_checkers, card_catalogue::load_file(l_file_name));
         }
-        return l_iter->second;
+        return l_checkers;
     }
 
     //-------------------------------------------------------------------------
-    void
-    solver::register_checker(const std::shared_ptr<checker_if> & p_checker)
+    std::shared_ptr<checker_if>
+    solver::get_checker(unsigned int p_id)
+    {
+        return get_registry().get_checker(p_id);
+    }
+
+    //-------------------------------------------------------------------------
+    std::vector<unsigned int>
+    solver::get_checker_ids()
     {
-        assert(!m_all_checkers.contains(p_checker->get_id()));
-        m_all_checkers.insert(make_pair(p_checker->get_id(), p_checker));
+        return get_registry().get_checker_ids();
     }
 
     //-------------------------------------------------------------------------
     void
     solver::relate_candidate_checker(const candidate & p_candidate
                                     ,const potential_checkers & p_checkers
+                                    ,std::map<potential_checkers, candidate> & p_checkers_to_candidate
                                     ,std::set<potential_checkers> & p_bad_checkers
                                     ,std::set<candidate> & p_candidate_with_bad_checkers
                                     )
     {
-        assert(!m_candidate_to_checkers.contains(p_candidate));
-        auto l_iter = m_checkers_to_candidate.find(p_checkers);
-        if(m_checkers_to_candidate.end() == l_iter)
+        instrumentation::timer l_timer{instrumentation::phase::UNIQUENESS};
+        auto l_iter = p_checkers_to_candidate.find(p_checkers);
+        if(p_checkers_to_candidate.end() == l_iter)
         {
             if(!p_bad_checkers.contains(p_checkers))
             {
-                m_candidate_to_checkers.insert(std::make_pair(p_candidate, p_checkers));
-                m_checkers_to_candidate.insert(std::make_pair(p_checkers, p_candidate));
+                p_checkers_to_candidate.insert(std::make_pair(p_checkers, p_candidate));
             }
         }
         else
         {
+            instrumentation::add(instrumentation::counter::DUPLICATE_SIGNATURES);
             p_candidate_with_bad_checkers.insert(l_iter->second);
-            m_checkers_to_candidate.erase(l_iter);
+            p_checkers_to_candidate.erase(l_iter);
             p_bad_checkers.insert(p_checkers);
         }
     }
 
+    //-------------------------------------------------------------------------
+    void
+    solver::set_verbose(bool p_verbose)
+    {
+        m_sink = p_verbose ? &output_sink::get_console() : nullptr;
+    }
+
+    //-------------------------------------------------------------------------
+    void
+    solver::set_output(output_sink * p_sink)
+    {
+        m_sink = p_sink;
+    }
+
+    //-------------------------------------------------------------------------
+    size_t
+    solver::get_memory_footprint() const
+    {
+        // Conditions of codes are stored in solver itself
+        return sizeof(solver) + m_checkers.capacity() * sizeof(std::shared_ptr<checker_if>);
+    }
+
     //-------------------------------------------------------------------------
     unsigned int
     solver::get_remaining_candidates() const
     {
-        return m_candidate_to_checkers.size();
+        return static_cast<unsigned int>(m_remaining.count());
+    }
+
+    //-------------------------------------------------------------------------
+    code_set
+    solver::get_remaining_codes() const
+    {
+        return m_remaining;
     }
 
 
@@ -0,0 +1,352 @@
+/*    This file is part of turing_machine_solver
+      Copyright (C) 2024  Julien Thevenon ( julien_thevenon at yahoo.fr )
+
+      This program is free software: you can redistribute it and/or modify
+      it under the terms of the GNU General Public License as published by
+      the Free Software Foundation, either version 3 of the License, or
+      (at your option) any later version.
+
+      This program is distributed in the hope that it will be useful,
+      but WITHOUT ANY WARRANTY; without even the implied warranty of
+      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+      GNU General Public License for more details.
+
+      You should have received a copy of the GNU General Public License
+      along with this program.  If not, see <http://www.gnu.org/licenses/>
+*/
+
+#ifndef TURING_MACHINE_SOLVER_SOLVER_CACHE_H
+#define TURING_MACHINE_SOLVER_SOLVER_CACHE_H
+
+#include "solver.h"
+#include "work_stealing_pool.h"
+#include "quicky_exception.h"
+#include <vector>
+#include <map>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <fstream>
+#include <algorithm>
+#include <charconv>
+#include <optional>
+#include <string_view>
+
+namespace turing_machine_solver
+{
+    /**
+     * Thread safe least recently used cache of solvers just after
+     * construction, keyed by checker ids. Checker order is part of the key
+     * because it defines checker indexes used during the game. A game gets a
+     * copy of the cached solver, which avoids candidates and conditions
+     * computation. Keys can be saved in a warm file to rebuild the cache
+     * when program restarts
+     */
+    class solver_cache
+    {
+    public:
+
+        /**
+         * @param p_memory_cap maximal number of bytes used by cached solvers
+         */
+        inline explicit
+        solver_cache(size_t p_memory_cap);
+
+        /**
+         * Solver in its initial state for these checkers
+         * @param p_checkers_id checker ids in game order
+         * @param p_verbose display setting of returned solver
+         */
+        [[nodiscard]] inline
+        solver
+        get(const std::vector<unsigned int> & p_checkers_id
+           ,bool p_verbose = false
+           );
+
+        [[nodiscard]] inline
+        uint64_t
+        get_nb_hits() const;
+
+        [[nodiscard]] inline
+        uint64_t
+        get_nb_misses() const;
+
+        [[nodiscard]] inline
+        size_t
+        get_nb_entries() const;
+
+        /**
+         * Approximate number of bytes used by cached solvers
+         */
+        [[nodiscard]] inline
+        size_t
+        get_memory_usage() const;
+
+        /**
+         * Save keys of cached solvers, most recently used first
+         */
+        inline
+        void
+        save(const std::string & p_file_name) const;
+
+        /**
+         * Build solvers whose keys have been saved, hits and misses are not
+         * counted. Nothing is done if file does not exist, lines that are not
+         * a list of known checker ids are skipped
+         * @param p_file_name warm file
+         * @param p_nb_threads number of threads, 0 means hardware concurrency
+         */
+        inline
+        void
+        load(const std::string & p_file_name
+            ,unsigned int p_nb_threads = 0
+            );
+
+    private:
+
+        typedef std::vector<unsigned int> key_t;
+
+        struct entry
+        {
+            std::shared_ptr<const solver> m_solver;
+            size_t m_size;
+            std::list<key_t>::iterator m_lru_position;
+        };
+
+        /**
+         * Checker ids of a warm file line
+         * @return key, empty if line is invalid or an id is unknown
+         */
+        [[nodiscard]] inline static
+        std::optional<key_t>
+        parse_key(std::string_view p_line);
+
+        /**
+         * Insert a solver and evict least recently used ones to respect
+         * memory cap. Mutex must be locked
+         */
+        inline
+        void
+        insert(const key_t & p_key
+              ,std::shared_ptr<const solver> p_solver
+              );
+
+        size_t m_memory_cap;
+
+        size_t m_memory_usage;
+
+        uint64_t m_nb_hits;
+
+        uint64_t m_nb_misses;
+
+        std::map<key_t, entry> m_entries;
+
+        /**
+         * Keys from most recently to least recently used
+         */
+        std::list<key_t> m_lru;
+
+        mutable std::mutex m_mutex;
+    };
+
+    //-------------------------------------------------------------------------
+    solver_cache::solver_cache(size_t p_memory_cap)
+    :m_memory_cap{p_memory_cap}
+    ,m_memory_usage{0}
+    ,m_nb_hits{0}
+    ,m_nb_misses{0}
+    {
+    }
+
+    //-------------------------------------------------------------------------
+    solver
+    solver_cache::get(const std::vector<unsigned int> & p_checkers_id
+                     ,bool p_verbose
+                     )
+    {
+        std::shared_ptr<const solver> l_solver;
+        {
+            std::lock_guard<std::mutex> l_lock{m_mutex};
+            auto l_iter = m_entries.find(p_checkers_id);
+            if(m_entries.end() != l_iter)
+            {
+                ++m_nb_hits;
+                m_lru.splice(m_lru.begin(), m_lru, l_iter->second.m_lru_position);
+                l_solver = l_iter->second.m_solver;
+            }
+            else
+            {
+                ++m_nb_misses;
+            }
+        }
+        if(!l_solver)
+        {
+            // Construction is done without lock so other games are not blocked
+            l_solver = std::make_shared<const solver>(p_checkers_id, false);
+            std::lock_guard<std::mutex> l_lock{m_mutex};
+            insert(p_checkers_id, l_solver);
+        }
+        solver l_result{*l_solver};
+        l_result.set_verbose(p_verbose);
+        return l_result;
+    }
+
+    //-------------------------------------------------------------------------
+    void
+    solver_cache::insert(const key_t & p_key
+                        ,std::shared_ptr<const solver> p_solver
+                        )
+    {
+        if(m_entries.contains(p_key))
+        {
+            return;
+        }
+        size_t l_size = p_solver->get_memory_footprint();
+        if(l_size > m_memory_cap)
+        {
+            return;
+        }
+        while(m_memory_usage + l_size > m_memory_cap)
+        {
+            auto l_iter = m_entries.find(m_lru.back());
+            m_memory_usage -= l_iter->second.m_size;
+            m_entries.erase(l_iter);
+            m_lru.pop_back();
+        }
+        m_lru.push_front(p_key);
+        m_entries.insert({p_key, entry{std::move(p_solver), l_size, m_lru.begin()}});
+        m_memory_usage += l_size;
+    }
+
+    //-------------------------------------------------------------------------
+    uint64_t
+    solver_cache::get_nb_hits() const
+    {
+        std::lock_guard<std::mutex> l_lock{m_mutex};
+        return m_nb_hits;
+    }
+
+    //-------------------------------------------------------------------------
+    uint64_t
+    solver_cache::get_nb_misses() const
+    {
+        std::lock_guard<std::mutex> l_lock{m_mutex};
+        return m_nb_misses;
+    }
+
+    //-------------------------------------------------------------------------
+    size_t
+    solver_cache::get_nb_entries() const
+    {
+        std::lock_guard<std::mutex> l_lock{m_mutex};
+        return m_entries.size();
+    }
+
+    //-------------------------------------------------------------------------
+    size_t
+    solver_cache::get_memory_usage() const
+    {
+        std::lock_guard<std::mutex> l_lock{m_mutex};
+        return m_memory_usage;
+    }
+
+    //-------------------------------------------------------------------------
+    void
+    solver_cache::save(const std::string & p_file_name) const
+    {
+        std::ofstream l_output_file{p_file_name, std::ios::trunc};
+        if(!l_output_file.is_open())
+        {
+            throw quicky_exception::quicky_runtime_exception("Unable to open " + p_file_name, __LINE__, __FILE__);
+        }
+        std::lock_guard<std::mutex> l_lock{m_mutex};
+        for(const auto & l_key: m_lru)
+        {
+            for(unsigned int l_index = 0; l_index < l_key.size(); ++l_index)
+            {
+                l_output_file << (l_index ? "," : "") << l_key[l_index];
+            }
+            l_output_file << std::endl;
+        }
+    }
+
+    //-------------------------------------------------------------------------
+    std::optional<solver_cache::key_t>
+    solver_cache::parse_key(std::string_view p_line)
+    {
+        while(!p_line.empty() && '\r' == p_line.back())
+        {
+            p_line.remove_suffix(1);
+        }
+        if(p_line.empty())
+        {
+            return std::nullopt;
+        }
+        key_t l_key;
+        while(true)
+        {
+            size_t l_end = std::min(p_line.find(','), p_line.size());
+            unsigned int l_id;
+            auto [l_ptr, l_status] = std::from_chars(p_line.data(), p_line.data() + l_end, l_id);
+            if(l_status != std::errc() || l_ptr != p_line.data() + l_end || !solver::get_registry().contains(l_id))
+            {
+                return std::nullopt;
+            }
+            l_key.emplace_back(l_id);
+            if(l_end == p_line.size())
+            {
+                return l_key;
+            }
+            p_line.remove_prefix(l_end + 1);
+        }
+    }
+
+    //-------------------------------------------------------------------------
+    void
+    solver_cache::load(const std::string & p_file_name
+                      ,unsigned int p_nb_threads
+                      )
+    {
+        std::ifstream l_input_file{p_file_name};
+        if(!l_input_file.is_open())
+        {
+            return;
+        }
+        std::vector<key_t> l_keys;
+        std::string l_line;
+        while(std::getline(l_input_file, l_line))
+        {
+            if(auto l_key = parse_key(l_line))
+            {
+                l_keys.emplace_back(*l_key);
+            }
+        }
+        std::vector<std::shared_ptr<const solver>> l_solvers(l_keys.size());
+        work_stealing_pool l_pool{p_nb_threads};
+        l_pool.run(l_keys.size()
+                  ,[&](size_t p_index, unsigned int)
+                   {
+                       // Key rejected by solver is skipped like a corrupt line
+                       try
+                       {
+                           l_solvers[p_index] = std::make_shared<const solver>(l_keys[p_index], false);
+                       }
+                       catch(quicky_exception::quicky_logic_exception &)
+                       {
+                       }
+                   }
+                  );
+        // Insert least recently used first to restore saved order
+        std::lock_guard<std::mutex> l_lock{m_mutex};
+        for(size_t l_index = l_keys.size(); l_index > 0; --l_index)
+        {
+            if(l_solvers[l_index - 1])
+            {
+                insert(l_keys[l_index - 1], l_solvers[l_index - 1]);
+            }
+        }
+    }
+}
+#endif //TURING_MACHINE_SOLVER_SOLVER_CACHE_H
+// EOF
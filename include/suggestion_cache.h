@@ -0,0 +1,491 @@
+/*    This file is part of turing_machine_solver
+      Copyright (C) 2024  Julien Thevenon ( julien_thevenon at yahoo.fr )
+
+      This program is free software: you can redistribute it and/or modify
+      it under the terms of the GNU General Public License as published by
+      the Free Software Foundation, either version 3 of the License, or
+      (at your option) any later version.
+
+      This program is distributed in the hope that it will be useful,
+      but WITHOUT ANY WARRANTY; without even the implied warranty of
+      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+      GNU General Public License for more details.
+
+      You should have received a copy of the GNU General Public License
+      along with this program.  If not, see <http://www.gnu.org/licenses/>
+*/
+
+#ifndef TURING_MACHINE_SOLVER_SUGGESTION_CACHE_H
+#define TURING_MACHINE_SOLVER_SUGGESTION_CACHE_H
+
+#include "planner.h"
+#include "query_suggestion.h"
+#include "condition_table.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace turing_machine_solver
+{
+    /**
+     * 128 bits hash of a game state: checker ids in game order, remaining
+     * codes and remaining criteria indexes
+     */
+    class state_fingerprint
+    {
+    public:
+        inline
+        state_fingerprint(const std::vector<unsigned int> & p_checkers_id
+                         ,const code_set & p_codes
+                         ,const std::vector<unsigned int> & p_criteria
+                         );
+
+        [[nodiscard]] inline
+        bool
+        operator==(const state_fingerprint & p_fingerprint) const = default;
+
+        uint64_t m_high;
+
+        uint64_t m_low;
+
+    private:
+
+        inline
+        void
+        add(uint64_t p_word);
+
+        /**
+         * Finalizer of splitmix64
+         */
+        [[nodiscard]] inline static
+        uint64_t
+        mix(uint64_t p_word);
+    };
+
+    /**
+     * Planner suggestion for a state and number of remaining criteria after
+     * each checker answer. Suggestion keeps its exactness and lower bound
+     */
+    class cached_suggestion
+    {
+    public:
+        query_suggestion m_suggestion;
+
+        unsigned int m_nb_accepted;
+
+        unsigned int m_nb_rejected;
+
+        /**
+         * Time budget given to planner, a non exact suggestion is computed
+         * again for a budget at least twice larger
+         */
+        std::chrono::steady_clock::duration m_budget;
+    };
+
+    /**
+     * Thread safe cache of planner suggestions keyed by state fingerprint,
+     * shared by games reaching the same state. Entries are split into
+     * stripes locked independently and each stripe has a fixed number of
+     * entries evicted by CLOCK algorithm, so memory is bounded and lookups
+     * of different stripes do not contend. A suggestion that is not exact
+     * is upgraded when a caller gives a larger budget
+     */
+    class suggestion_cache
+    {
+    public:
+
+        /**
+         * @param p_capacity maximal number of entries
+         * @param p_nb_stripes number of independently locked stripes
+         */
+        inline explicit
+        suggestion_cache(size_t p_capacity
+                        ,unsigned int p_nb_stripes = 64
+                        );
+
+        /**
+         * Cache used by all games of process
+         */
+        [[nodiscard]] inline static
+        suggestion_cache &
+        get_shared();
+
+        /**
+         * Cached suggestion of a state, computed without lock if missing or
+         * if cached one is not exact and was computed with less than half
+         * of budget
+         * @param p_key state fingerprint
+         * @param p_budget time budget of caller
+         * @param p_compute function returning suggestion of state within
+         * budget
+         */
+        template <typename FUNC>
+        [[nodiscard]]
+        cached_suggestion
+        get(const state_fingerprint & p_key
+           ,std::chrono::steady_clock::duration p_budget
+           ,FUNC && p_compute
+           );
+
+        /**
+         * Planner suggestion for a game state, planner is only called if
+         * state is not cached
+         * @param p_planner planner of checkers
+         * @param p_checkers_id checker ids in game order
+         * @param p_criteria indexes of remaining criteria
+         * @param p_budget time after which planner returns its best query
+         * @param p_codes codes that can be proposed
+         */
+        [[nodiscard]] inline
+        cached_suggestion
+        suggest(planner & p_planner
+               ,const std::vector<unsigned int> & p_checkers_id
+               ,const std::vector<unsigned int> & p_criteria
+               ,std::chrono::steady_clock::duration p_budget
+               ,const code_set & p_codes
+               );
+
+        [[nodiscard]] inline
+        uint64_t
+        get_nb_hits() const;
+
+        [[nodiscard]] inline
+        uint64_t
+        get_nb_misses() const;
+
+        [[nodiscard]] inline
+        uint64_t
+        get_nb_evictions() const;
+
+        /**
+         * Number of non exact suggestions computed again with a larger
+         * budget, also counted as misses
+         */
+        [[nodiscard]] inline
+        uint64_t
+        get_nb_upgrades() const;
+
+        /**
+         * Ratio of lookups finding their state, 0 before first lookup
+         */
+        [[nodiscard]] inline
+        double
+        get_hit_rate() const;
+
+        [[nodiscard]] inline
+        size_t
+        get_nb_entries() const;
+
+        [[nodiscard]] inline
+        size_t
+        get_capacity() const;
+
+        static constexpr size_t m_shared_capacity = 65536;
+
+    private:
+
+        struct slot
+        {
+            state_fingerprint m_key;
+            cached_suggestion m_value;
+            bool m_referenced;
+        };
+
+        struct hasher
+        {
+            size_t
+            operator()(const state_fingerprint & p_key) const
+            {
+                return static_cast<size_t>(p_key.m_low);
+            }
+        };
+
+        struct stripe
+        {
+            std::unordered_map<state_fingerprint, size_t, hasher> m_index;
+            std::vector<slot> m_slots;
+            size_t m_hand = 0;
+            mutable std::mutex m_mutex;
+        };
+
+        [[nodiscard]] inline
+        stripe &
+        get_stripe(const state_fingerprint & p_key);
+
+        [[nodiscard]] inline
+        std::optional<cached_suggestion>
+        find(const state_fingerprint & p_key);
+
+        /**
+         * Insert a suggestion, evicting first entry of stripe not referenced
+         * since clock hand last passed if stripe is full. If state is
+         * already cached the best of both suggestions is kept
+         */
+        inline
+        cached_suggestion
+        insert(const state_fingerprint & p_key
+              ,const cached_suggestion & p_value
+              );
+
+        size_t m_stripe_capacity;
+
+        std::unique_ptr<stripe[]> m_stripes;
+
+        unsigned int m_nb_stripes;
+
+        std::atomic<uint64_t> m_nb_hits;
+
+        std::atomic<uint64_t> m_nb_misses;
+
+        std::atomic<uint64_t> m_nb_evictions;
+
+        std::atomic<uint64_t> m_nb_upgrades;
+    };
+
+    //-------------------------------------------------------------------------
+    state_fingerprint::state_fingerprint(const std::vector<unsigned int> & p_checkers_id
+                                        ,const code_set & p_codes
+                                        ,const std::vector<unsigned int> & p_criteria
+                                        )
+    :m_high{0x243F6A8885A308D3ULL}
+    ,m_low{0x13198A2E03707344ULL}
+    {
+        add(p_checkers_id.size());
+        for(auto l_id: p_checkers_id)
+        {
+            add(l_id);
+        }
+        add((p_codes & code_set{~uint64_t(0)}).to_ullong());
+        add((p_codes >> 64).to_ullong());
+        add(p_criteria.size());
+        for(auto l_index: p_criteria)
+        {
+            add(l_index);
+        }
+    }
+
+    //-------------------------------------------------------------------------
+    void
+    state_fingerprint::add(uint64_t p_word)
+    {
+        // Halves are mixed differently so they are independent hashes
+        m_high = mix(m_high ^ p_word);
+        m_low = mix(m_low + p_word * 0x9E3779B97F4A7C15ULL);
+    }
+
+    //-------------------------------------------------------------------------
+    uint64_t
+    state_fingerprint::mix(uint64_t p_word)
+    {
+        p_word = (p_word ^ (p_word >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        p_word = (p_word ^ (p_word >> 27)) * 0x94D049BB133111EBULL;
+        return p_word ^ (p_word >> 31);
+    }
+
+    //-------------------------------------------------------------------------
+    suggestion_cache::suggestion_cache(size_t p_capacity
+                                      ,unsigned int p_nb_stripes
+                                      )
+    :m_stripe_capacity{std::max<size_t>(1, p_capacity / std::max(1u, p_nb_stripes))}
+    ,m_stripes{std::make_unique<stripe[]>(std::max(1u, p_nb_stripes))}
+    ,m_nb_stripes{std::max(1u, p_nb_stripes)}
+    ,m_nb_hits{0}
+    ,m_nb_misses{0}
+    ,m_nb_evictions{0}
+    ,m_nb_upgrades{0}
+    {
+        for(unsigned int l_index = 0; l_index < m_nb_stripes; ++l_index)
+        {
+            m_stripes[l_index].m_index.reserve(m_stripe_capacity);
+            m_stripes[l_index].m_slots.reserve(m_stripe_capacity);
+        }
+    }
+
+    //-------------------------------------------------------------------------
+    suggestion_cache &
+    suggestion_cache::get_shared()
+    {
+        // Initialisation of function static variable is thread safe
+        static suggestion_cache l_cache{m_shared_capacity};
+        return l_cache;
+    }
+
+    //-------------------------------------------------------------------------
+    template <typename FUNC>
+    cached_suggestion
+    suggestion_cache::get(const state_fingerprint & p_key
+                         ,std::chrono::steady_clock::duration p_budget
+                         ,FUNC && p_compute
+                         )
+    {
+        std::optional<cached_suggestion> l_cached = find(p_key);
+        // Budget must at least double so timing jitter does not trigger
+        // upgrades
+        if(l_cached && (l_cached->m_suggestion.is_exact() || 2 * l_cached->m_budget >= p_budget))
+        {
+            m_nb_hits.fetch_add(1, std::memory_order_relaxed);
+            return *l_cached;
+        }
+        m_nb_misses.fetch_add(1, std::memory_order_relaxed);
+        if(l_cached)
+        {
+            m_nb_upgrades.fetch_add(1, std::memory_order_relaxed);
+        }
+        // Computation is done without lock so other games are not blocked
+        return insert(p_key, p_compute());
+    }
+
+    //-------------------------------------------------------------------------
+    cached_suggestion
+    suggestion_cache::suggest(planner & p_planner
+                             ,const std::vector<unsigned int> & p_checkers_id
+                             ,const std::vector<unsigned int> & p_criteria
+                             ,std::chrono::steady_clock::duration p_budget
+                             ,const code_set & p_codes
+                             )
+    {
+        return get(state_fingerprint{p_checkers_id, p_codes, p_criteria}
+                  ,p_budget
+                  ,[&]()
+                   {
+                       query_suggestion l_suggestion = p_planner.suggest(p_criteria, std::chrono::steady_clock::now() + p_budget, p_codes);
+                       unsigned int l_nb_accepted = p_planner.count_accepted(p_criteria, l_suggestion);
+                       return cached_suggestion{l_suggestion, l_nb_accepted, static_cast<unsigned int>(p_criteria.size()) - l_nb_accepted, p_budget};
+                   }
+                  );
+    }
+
+    //-------------------------------------------------------------------------
+    suggestion_cache::stripe &
+    suggestion_cache::get_stripe(const state_fingerprint & p_key)
+    {
+        // High half selects stripe as low half is used by stripe hash map
+        return m_stripes[p_key.m_high % m_nb_stripes];
+    }
+
+    //-------------------------------------------------------------------------
+    std::optional<cached_suggestion>
+    suggestion_cache::find(const state_fingerprint & p_key)
+    {
+        stripe & l_stripe = get_stripe(p_key);
+        std::lock_guard<std::mutex> l_lock{l_stripe.m_mutex};
+        auto l_iter = l_stripe.m_index.find(p_key);
+        if(l_stripe.m_index.end() == l_iter)
+        {
+            return std::nullopt;
+        }
+        slot & l_slot = l_stripe.m_slots[l_iter->second];
+        l_slot.m_referenced = true;
+        return l_slot.m_value;
+    }
+
+    //-------------------------------------------------------------------------
+    cached_suggestion
+    suggestion_cache::insert(const state_fingerprint & p_key
+                            ,const cached_suggestion & p_value
+                            )
+    {
+        stripe & l_stripe = get_stripe(p_key);
+        std::lock_guard<std::mutex> l_lock{l_stripe.m_mutex};
+        // State may be cached by an upgraded lookup or by another game
+        // meanwhile. An exact suggestion is never replaced, otherwise best
+        // score is kept with largest budget
+        if(auto l_iter = l_stripe.m_index.find(p_key); l_stripe.m_index.end() != l_iter)
+        {
+            cached_suggestion & l_cached = l_stripe.m_slots[l_iter->second].m_value;
+            if(!l_cached.m_suggestion.is_exact())
+            {
+                std::chrono::steady_clock::duration l_budget = std::max(l_cached.m_budget, p_value.m_budget);
+                if(p_value.m_suggestion.is_exact() || p_value.m_suggestion.get_score() <= l_cached.m_suggestion.get_score())
+                {
+                    l_cached = p_value;
+                }
+                l_cached.m_budget = l_budget;
+            }
+            return l_cached;
+        }
+        if(l_stripe.m_slots.size() < m_stripe_capacity)
+        {
+            l_stripe.m_index.emplace(p_key, l_stripe.m_slots.size());
+            l_stripe.m_slots.push_back({p_key, p_value, false});
+            return p_value;
+        }
+        while(l_stripe.m_slots[l_stripe.m_hand].m_referenced)
+        {
+            l_stripe.m_slots[l_stripe.m_hand].m_referenced = false;
+            l_stripe.m_hand = (l_stripe.m_hand + 1) % m_stripe_capacity;
+        }
+        slot & l_slot = l_stripe.m_slots[l_stripe.m_hand];
+        l_stripe.m_index.erase(l_slot.m_key);
+        l_stripe.m_index.emplace(p_key, l_stripe.m_hand);
+        l_slot = {p_key, p_value, false};
+        l_stripe.m_hand = (l_stripe.m_hand + 1) % m_stripe_capacity;
+        m_nb_evictions.fetch_add(1, std::memory_order_relaxed);
+        return p_value;
+    }
+
+    //-------------------------------------------------------------------------
+    uint64_t
+    suggestion_cache::get_nb_hits() const
+    {
+        return m_nb_hits.load(std::memory_order_relaxed);
+    }
+
+    //-------------------------------------------------------------------------
+    uint64_t
+    suggestion_cache::get_nb_misses() const
+    {
+        return m_nb_misses.load(std::memory_order_relaxed);
+    }
+
+    //-------------------------------------------------------------------------
+    uint64_t
+    suggestion_cache::get_nb_evictions() const
+    {
+        return m_nb_evictions.load(std::memory_order_relaxed);
+    }
+
+    //-------------------------------------------------------------------------
+    uint64_t
+    suggestion_cache::get_nb_upgrades() const
+    {
+        return m_nb_upgrades.load(std::memory_order_relaxed);
+    }
+
+    //-------------------------------------------------------------------------
+    double
+    suggestion_cache::get_hit_rate() const
+    {
+        uint64_t l_nb_hits = get_nb_hits();
+        uint64_t l_nb_lookups = l_nb_hits + get_nb_misses();
+        return l_nb_lookups ? static_cast<double>(l_nb_hits) / static_cast<double>(l_nb_lookups) : 0;
+    }
+
+    //-------------------------------------------------------------------------
+    size_t
+    suggestion_cache::get_nb_entries() const
+    {
+        size_t l_result = 0;
+        for(unsigned int l_index = 0; l_index < m_nb_stripes; ++l_index)
+        {
+            std::lock_guard<std::mutex> l_lock{m_stripes[l_index].m_mutex};
+            l_result += m_stripes[l_index].m_slots.size();
+        }
+        return l_result;
+    }
+
+    //-------------------------------------------------------------------------
+    size_t
+    suggestion_cache::get_capacity() const
+    {
+        return m_stripe_capacity * m_nb_stripes;
+    }
+}
+#endif //TURING_MACHINE_SOLVER_SUGGESTION_CACHE_H
+// EOF
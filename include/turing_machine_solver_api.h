@@ -0,0 +1,165 @@
+/*    This file is part of turing_machine_solver
+      Copyright (C) 2024  Julien Thevenon ( julien_thevenon at yahoo.fr )
+
+      This program is free software: you can redistribute it and/or modify
+      it under the terms of the GNU General Public License as published by
+      the Free Software Foundation, either version 3 of the License, or
+      (at your option) any later version.
+
+      This program is distributed in the hope that it will be useful,
+      but WITHOUT ANY WARRANTY; without even the implied warranty of
+      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+      GNU General Public License for more details.
+
+      You should have received a copy of the GNU General Public License
+      along with this program.  If not, see <http://www.gnu.org/licenses/>
+*/
+
+#ifndef TURING_MACHINE_SOLVER_API_H
+#define TURING_MACHINE_SOLVER_API_H
+
+/**
+ * C interface of solver. Nothing is displayed, errors are reported by
+ * status codes and a message stored in game. Codes are given in 3 digits
+ * format (blue, yellow, purple), checker indexes follow order of checker
+ * ids given when game is opened.
+ * Game object can be placed in a buffer supplied by caller, of at least
+ * tms_game_storage_size() bytes aligned on tms_game_storage_alignment().
+ * This is struct placement only: solver state, criteria and planner owned
+ * by the game are still allocated by the library when game is opened.
+ * All functions can be called concurrently on different games.
+ */
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TMS_API_VERSION 2
+
+typedef enum
+{
+    TMS_OK = 0,
+    TMS_INVALID_ARGUMENT = 1,
+    TMS_BUFFER_TOO_SMALL = 2,
+    TMS_NO_SOLUTION = 3,
+    TMS_INTERNAL_ERROR = 4
+} tms_status;
+
+typedef struct tms_game tms_game;
+
+typedef struct tms_database tms_database;
+
+/**
+ * Version of interface, to compare with TMS_API_VERSION
+ */
+unsigned int tms_api_version(void);
+
+/**
+ * Size of game structure, not including state allocated by library
+ */
+size_t tms_game_storage_size(void);
+
+size_t tms_game_storage_alignment(void);
+
+/**
+ * Open a game
+ * @param p_checkers_id ids of checkers
+ * @param p_nb_checkers number of checkers
+ * @param p_storage buffer where game structure is built, allocated by
+ * library if NULL. Game state is allocated by library in both cases
+ * @param p_storage_size size of buffer
+ * @param p_game opened game
+ */
+tms_status tms_game_open(const unsigned int * p_checkers_id
+                        ,size_t p_nb_checkers
+                        ,void * p_storage
+                        ,size_t p_storage_size
+                        ,tms_game ** p_game
+                        );
+
+/**
+ * Analyze answer of a checker for a code. Like in interactive mode,
+ * conditions of a code are kept for all its checks
+ * @param p_remaining number of remaining candidates, can be NULL
+ */
+tms_status tms_game_apply(tms_game * p_game
+                         ,unsigned int p_code
+                         ,unsigned int p_checker_index
+                         ,int p_result
+                         ,unsigned int * p_remaining
+                         );
+
+/**
+ * Copy remaining codes in increasing order
+ * @param p_codes caller buffer
+ * @param p_capacity number of codes buffer can contain, 125 is always enough
+ * @param p_nb_codes number of remaining codes, set even if buffer is too small
+ */
+tms_status tms_game_remaining_codes(const tms_game * p_game
+                                   ,unsigned int * p_codes
+                                   ,size_t p_capacity
+                                   ,size_t * p_nb_codes
+                                   );
+
+/**
+ * Suggest next query, taken from process cache if a game already reached
+ * the same state
+ * @param p_budget_us time budget in microseconds
+ * @param p_code code to propose
+ * @param p_checker_index checker to ask
+ * @param p_expected expected number of remaining criteria, can be NULL
+ */
+tms_status tms_game_suggest(tms_game * p_game
+                           ,unsigned int p_budget_us
+                           ,unsigned int * p_code
+                           ,unsigned int * p_checker_index
+                           ,double * p_expected
+                           );
+
+/**
+ * Message of last error of a game, empty if none
+ */
+const char * tms_game_last_error(const tms_game * p_game);
+
+/**
+ * Destroy a game, buffer supplied at opening is not released
+ */
+void tms_game_close(tms_game * p_game);
+
+/**
+ * Open a read only database of puzzles with a single solution, as built by
+ * --build-database. It can be shared by concurrent searches
+ * @param p_file_name database file
+ * @param p_database opened database
+ */
+tms_status tms_database_open(const char * p_file_name
+                            ,tms_database ** p_database
+                            );
+
+/**
+ * Search a puzzle in database
+ * @param p_checkers_id ids of checkers, in any order
+ * @param p_nb_checkers number of checkers
+ * @param p_code solution code, set if puzzle is found
+ * @param p_found 1 if puzzle is in database, 0 otherwise
+ */
+tms_status tms_database_find(const tms_database * p_database
+                            ,const unsigned int * p_checkers_id
+                            ,size_t p_nb_checkers
+                            ,unsigned int * p_code
+                            ,int * p_found
+                            );
+
+/**
+ * Unmap a database
+ */
+void tms_database_close(tms_database * p_database);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //TURING_MACHINE_SOLVER_API_H
+// EOF
@@ -0,0 +1,192 @@
+/*    This file is part of turing_machine_solver
+      Copyright (C) 2024  Julien Thevenon ( julien_thevenon at yahoo.fr )
+
+      This program is free software: you can redistribute it and/or modify
+      it under the terms of the GNU General Public License as published by
+      the Free Software Foundation, either version 3 of the License, or
+      (at your option) any later version.
+
+      This program is distributed in the hope that it will be useful,
+      but WITHOUT ANY WARRANTY; without even the implied warranty of
+      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+      GNU General Public License for more details.
+
+      You should have received a copy of the GNU General Public License
+      along with this program.  If not, see <http://www.gnu.org/licenses/>
+*/
+
+#ifndef TURING_MACHINE_SOLVER_WORK_STEALING_POOL_H
+#define TURING_MACHINE_SOLVER_WORK_STEALING_POOL_H
+
+#include <deque>
+#include <vector>
+#include <mutex>
+#include <thread>
+#include <functional>
+#include <exception>
+#include <optional>
+#include <algorithm>
+
+namespace turing_machine_solver
+{
+    /**
+     * Run indexed tasks on several threads. Each thread owns a queue of task
+     * indexes, when its queue is empty it steals tasks from the back of other
+     * queues so that tasks with very different costs keep all threads busy
+     */
+    class work_stealing_pool
+    {
+    public:
+        /**
+         * @param p_nb_threads number of threads, 0 means hardware concurrency
+         */
+        inline explicit
+        work_stealing_pool(unsigned int p_nb_threads = 0);
+
+        [[nodiscard]] inline
+        unsigned int
+        get_nb_threads() const;
+
+        /**
+         * Execute tasks and wait for their completion. First exception
+         * thrown by a task is rethrown once all threads are stopped
+         * @param p_tasks indexes of tasks to execute
+         * @param p_func task function, called with task index and thread index
+         */
+        inline
+        void
+        run(const std::vector<size_t> & p_tasks
+           ,const std::function<void(size_t, unsigned int)> & p_func
+           );
+
+        /**
+         * Execute tasks 0 to p_nb_tasks - 1
+         */
+        inline
+        void
+        run(size_t p_nb_tasks
+           ,const std::function<void(size_t, unsigned int)> & p_func
+           );
+
+    private:
+
+        class task_queue
+        {
+        public:
+            std::mutex m_mutex;
+            std::deque<size_t> m_tasks;
+        };
+
+        [[nodiscard]] inline
+        std::optional<size_t>
+        get_task(unsigned int p_thread_index);
+
+        unsigned int m_nb_threads;
+
+        std::vector<task_queue> m_queues;
+    };
+
+    //-------------------------------------------------------------------------
+    work_stealing_pool::work_stealing_pool(unsigned int p_nb_threads)
+    :m_nb_threads{p_nb_threads ? p_nb_threads : std::max(1u, std::thread::hardware_concurrency())}
+    ,m_queues(m_nb_threads)
+    {
+    }
+
+    //-------------------------------------------------------------------------
+    unsigned int
+    work_stealing_pool::get_nb_threads() const
+    {
+        return m_nb_threads;
+    }
+
+    //-------------------------------------------------------------------------
+    std::optional<size_t>
+    work_stealing_pool::get_task(unsigned int p_thread_index)
+    {
+        {
+            std::lock_guard<std::mutex> l_lock(m_queues[p_thread_index].m_mutex);
+            auto & l_tasks = m_queues[p_thread_index].m_tasks;
+            if(!l_tasks.empty())
+            {
+                size_t l_task = l_tasks.front();
+                l_tasks.pop_front();
+                return l_task;
+            }
+        }
+        for(unsigned int l_offset = 1; l_offset < m_nb_threads; ++l_offset)
+        {
+            auto & l_victim = m_queues[(p_thread_index + l_offset) % m_nb_threads];
+            std::lock_guard<std::mutex> l_lock(l_victim.m_mutex);
+            if(!l_victim.m_tasks.empty())
+            {
+                size_t l_task = l_victim.m_tasks.back();
+                l_victim.m_tasks.pop_back();
+                return l_task;
+            }
+        }
+        return std::nullopt;
+    }
+
+    //-------------------------------------------------------------------------
+    void
+    work_stealing_pool::run(const std::vector<size_t> & p_tasks
+                           ,const std::function<void(size_t, unsigned int)> & p_func
+                           )
+    {
+        for(size_t l_index = 0; l_index < p_tasks.size(); ++l_index)
+        {
+            m_queues[l_index % m_nb_threads].m_tasks.push_back(p_tasks[l_index]);
+        }
+        std::mutex l_exception_mutex;
+        std::exception_ptr l_exception;
+        auto l_worker = [&](unsigned int p_thread_index)
+        {
+            while(auto l_task = get_task(p_thread_index))
+            {
+                try
+                {
+                    p_func(*l_task, p_thread_index);
+                }
+                catch(...)
+                {
+                    std::lock_guard<std::mutex> l_lock(l_exception_mutex);
+                    if(!l_exception)
+                    {
+                        l_exception = std::current_exception();
+                    }
+                }
+            }
+        };
+        std::vector<std::thread> l_threads;
+        for(unsigned int l_thread_index = 1; l_thread_index < m_nb_threads; ++l_thread_index)
+        {
+            l_threads.emplace_back(l_worker, l_thread_index);
+        }
+        l_worker(0);
+        for(auto & l_thread: l_threads)
+        {
+            l_thread.join();
+        }
+        if(l_exception)
+        {
+            std::rethrow_exception(l_exception);
+        }
+    }
+
+    //-------------------------------------------------------------------------
+    void
+    work_stealing_pool::run(size_t p_nb_tasks
+                           ,const std::function<void(size_t, unsigned int)> & p_func
+                           )
+    {
+        std::vector<size_t> l_tasks(p_nb_tasks);
+        for(size_t l_index = 0; l_index < p_nb_tasks; ++l_index)
+        {
+            l_tasks[l_index] = l_index;
+        }
+        run(l_tasks, p_func);
+    }
+}
+#endif //TURING_MACHINE_SOLVER_WORK_STEALING_POOL_H
+// EOF
@@ -0,0 +1,250 @@
+/*    This file is part of turing_machine_solver
+      Copyright (C) 2024  Julien Thevenon ( julien_thevenon at yahoo.fr )
+
+      This program is free software: you can redistribute it and/or modify
+      it under the terms of the GNU General Public License as published by
+      the Free Software Foundation, either version 3 of the License, or
+      (at your option) any later version.
+
+      This program is distributed in the hope that it will be useful,
+      but WITHOUT ANY WARRANTY; without even the implied warranty of
+      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+      GNU General Public License for more details.
+
+      You should have received a copy of the GNU General Public License
+      along with this program.  If not, see <http://www.gnu.org/licenses/>
+*/
+#include "solver.h"
+#include "checker_registry.h"
+#include "game_runner.h"
+#include "benchmark.h"
+#include "multi_game_engine.h"
+#include "quicky_exception.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <chrono>
+#include <vector>
+
+using namespace turing_machine_solver;
+
+namespace
+{
+    /**
+     * Checker lists of construction cases: functional test games, card 48
+     * which has the highest grade and grade 6 cards 33, 42 and 46
+     */
+    const std::vector<std::vector<unsigned int>> g_checker_lists{{13, 19, 33, 42}
+                                                                ,{7, 9, 15, 16}
+                                                                ,{4, 9, 11, 14, 48}
+                                                                ,{2, 5, 33, 42, 46}
+                                                                ,{8, 12, 17, 21, 33, 48}
+                                                                ,{16, 21, 33, 42, 46, 48}
+                                                                };
+
+    /**
+     * Games of functional tests
+     */
+    const std::vector<std::pair<std::string, std::string>> g_scripts{{"difficult_4_chk_1", "4,13,19,33,42,345,0,0,2,0,3,1,233,1,0,-1,354,0,0,1,1,-1,355,0,1,1,1,2,0"}
+                                                                    ,{"easy_4_chck_1", "4,7,9,15,16,334,1,0,2,0,-1,243,1,0,2,1"}
+                                                                    };
+
+    //-------------------------------------------------------------------------
+    std::string
+    to_string(const std::vector<unsigned int> & p_ids)
+    {
+        std::string l_result;
+        for(auto l_id: p_ids)
+        {
+            l_result += (l_result.empty() ? "" : "-") + std::to_string(l_id);
+        }
+        return l_result;
+    }
+
+    //-------------------------------------------------------------------------
+    void
+    run_cases(benchmark & p_benchmark)
+    {
+        p_benchmark.run("register_all_checkers"
+                       ,[]()
+                        {
+                            checker_registry l_registry{solver::create_all_checkers()};
+                        }
+                       );
+
+        for(const auto & l_ids: g_checker_lists)
+        {
+            std::string l_suffix = std::to_string(l_ids.size()) + "/" + to_string(l_ids);
+            p_benchmark.run("construct/" + l_suffix
+                           ,[&]()
+                            {
+                                solver l_solver{l_ids, false};
+                            }
+                           );
+
+            solver l_solver{l_ids, false};
+            std::vector<candidate> l_candidates;
+            code_set l_codes = l_solver.get_remaining_codes();
+            for(unsigned int l_index = 0; l_index < condition_table::m_nb_codes; ++l_index)
+            {
+                if(l_codes.test(l_index))
+                {
+                    l_candidates.emplace_back(condition_table::index_code(l_index));
+                }
+            }
+            p_benchmark.run("get_related_checkers/" + l_suffix
+                           ,[&]()
+                            {
+                                for(const auto & l_candidate: l_candidates)
+                                {
+                                    (void)l_solver.get_related_checkers(l_candidate);
+                                }
+                            }
+                           );
+        }
+
+        for(const auto & [l_name, l_script]: g_scripts)
+        {
+            auto [l_ids, l_checks] = game_runner::parse_checks(l_script);
+            const solver l_initial_solver{l_ids, false};
+            // Copy of initial solver is prepared outside of measure
+            p_benchmark.run_timed("analyze_result/" + l_name
+                                 ,[&]()
+                                  {
+                                      solver l_solver{l_initial_solver};
+                                      auto l_start = std::chrono::steady_clock::now();
+                                      for(const auto & [l_code, l_checker_index, l_result]: l_checks)
+                                      {
+                                          l_solver.analyze_result(candidate{l_code}, l_checker_index, l_result);
+                                      }
+                                      return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - l_start);
+                                  }
+                                 );
+            // Game played in all lanes, one batch per check
+            p_benchmark.run_timed("analyze_results/64x" + l_name
+                                 ,[&]()
+                                  {
+                                      multi_game_engine l_engine{l_ids};
+                                      std::vector<game_answer> l_batch(multi_game_engine::m_nb_lanes);
+                                      for(unsigned int l_lane = 0; l_lane < multi_game_engine::m_nb_lanes; ++l_lane)
+                                      {
+                                          l_batch[l_lane].m_lane = l_engine.add_game();
+                                      }
+                                      auto l_start = std::chrono::steady_clock::now();
+                                      for(const auto & [l_code, l_checker_index, l_result]: l_checks)
+                                      {
+                                          if(l_engine.get_solved_games())
+                                          {
+                                              break;
+                                          }
+                                          unsigned int l_code_index = condition_table::code_index(candidate{l_code});
+                                          for(auto & l_answer: l_batch)
+                                          {
+                                              l_answer.m_code_index = l_code_index;
+                                              l_answer.m_checker_index = l_checker_index;
+                                              l_answer.m_result = l_result;
+                                          }
+                                          l_engine.analyze_results(l_batch);
+                                      }
+                                      return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - l_start);
+                                  }
+                                 );
+            p_benchmark.run("game/" + l_name
+                           ,[&]()
+                            {
+                                if(game_runner::run(l_script).get_status() != game_result::status::SOLVED)
+                                {
+                                    throw quicky_exception::quicky_logic_exception("Game " + l_name + " not solved", __LINE__, __FILE__);
+                                }
+                            }
+                           );
+        }
+    }
+
+    //-------------------------------------------------------------------------
+    void
+    save(const std::string & p_file_name
+        ,const benchmark & p_benchmark
+        ,void (benchmark::*p_method)(std::ostream &) const
+        )
+    {
+        std::ofstream l_file{p_file_name};
+        if(!l_file.is_open())
+        {
+            throw quicky_exception::quicky_runtime_exception("Unable to create " + p_file_name, __LINE__, __FILE__);
+        }
+        (p_benchmark.*p_method)(l_file);
+    }
+}
+
+//------------------------------------------------------------------------------
+int main(int argc,char ** argv)
+{
+    try
+    {
+        unsigned int l_nb_warmups = 3;
+        unsigned int l_nb_repetitions = 20;
+        std::string l_filter;
+        std::string l_json_name;
+        std::string l_csv_name;
+        for(int l_arg_index = 1; l_arg_index < argc; ++l_arg_index)
+        {
+            std::string l_option{argv[l_arg_index]};
+            if(l_arg_index + 1 >= argc)
+            {
+                throw quicky_exception::quicky_logic_exception("Usage: " + std::string(argv[0]) + " [--warmup <n>] [--reps <n>] [--filter <case name part>] [--json <file>] [--csv <file>]", __LINE__, __FILE__);
+            }
+            std::string l_value{argv[++l_arg_index]};
+            if("--warmup" == l_option)
+            {
+                l_nb_warmups = static_cast<unsigned int>(std::stoul(l_value));
+            }
+            else if("--reps" == l_option)
+            {
+                l_nb_repetitions = static_cast<unsigned int>(std::stoul(l_value));
+            }
+            else if("--filter" == l_option)
+            {
+                l_filter = l_value;
+            }
+            else if("--json" == l_option)
+            {
+                l_json_name = l_value;
+            }
+            else if("--csv" == l_option)
+            {
+                l_csv_name = l_value;
+            }
+            else
+            {
+                throw quicky_exception::quicky_logic_exception("Unknown option " + l_option, __LINE__, __FILE__);
+            }
+        }
+
+        benchmark l_benchmark{l_nb_warmups, l_nb_repetitions, l_filter};
+        run_cases(l_benchmark);
+        l_benchmark.display(std::cout);
+        if(!l_json_name.empty())
+        {
+            save(l_json_name, l_benchmark, &benchmark::save_json);
+        }
+        if(!l_csv_name.empty())
+        {
+            save(l_csv_name, l_benchmark, &benchmark::save_csv);
+        }
+    }
+    catch(quicky_exception::quicky_runtime_exception & e)
+    {
+        std::cout << "ERROR : " << e.what() << " at " << e.get_file() << ":" << e.get_line() <<std::endl ;
+        return(-1);
+    }
+    catch(quicky_exception::quicky_logic_exception & e)
+    {
+        std::cout << "ERROR : " << e.what() << " at " << e.get_file() << ":" << e.get_line() << std::endl ;
+        return(-1);
+    }
+    return 0;
+}
+//EOF
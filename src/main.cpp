@@ -15,59 +15,377 @@
       along with this program.  If not, see <http://www.gnu.org/licenses/>
 */
 #include "solver.h"
+#include "difficulty_rater.h"
+#include "planner.h"
+#include "game_runner.h"
+#include "log_replayer.h"
+#include "regression_runner.h"
+#include "differential_fuzzer.h"
+#include "bitset_solver.h"
+#include "map_solver.h"
+#include "multi_game_engine.h"
+#include "puzzle_enumerator.h"
+#include "puzzle_database.h"
+#include "puzzle_generator.h"
+#include "game_server.h"
+#include "interactive_game.h"
 #include "quicky_exception.h"
 #include "ask.h"
+#include "instrumentation.h"
+#include "allocation_counter.h"
+#include "card_catalogue.h"
 #include <iostream>
+#include <charconv>
+#include <limits>
+#include <cstdlib>
+#include <new>
+#include <string_view>
 
 using namespace turing_machine_solver;
 
+#ifdef ENABLE_ALLOCATION_CHECK
+// Replacement functions are visible to callers, free of memory returned by
+// replaced operator new is not a mismatch
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+
+//------------------------------------------------------------------------------
+void * operator new(std::size_t p_size)
+{
+    allocation_counter::record();
+    if(void * l_pointer = std::malloc(p_size ? p_size : 1))
+    {
+        return l_pointer;
+    }
+    throw std::bad_alloc();
+}
+
+//------------------------------------------------------------------------------
+void operator delete(void * p_pointer) noexcept
+{
+    std::free(p_pointer);
+}
+
+//------------------------------------------------------------------------------
+void operator delete(void * p_pointer, std::size_t) noexcept
+{
+    std::free(p_pointer);
+}
+#pragma GCC diagnostic pop
+#endif // ENABLE_ALLOCATION_CHECK
+
+namespace
+{
+    //------------------------------------------------------------------------------
+    /**
+     * Numeric command line argument
+     * @param p_argument argument text
+     * @param p_usage usage of command, reported if argument is not a number
+     */
+    template <typename T>
+    T
+    parse_argument(std::string_view p_argument
+                  ,const std::string & p_usage
+                  )
+    {
+        T l_result;
+        auto [l_ptr, l_status] = std::from_chars(p_argument.data(), p_argument.data() + p_argument.size(), l_result);
+        if(l_status != std::errc() || l_ptr != p_argument.data() + p_argument.size())
+        {
+            throw quicky_exception::quicky_logic_exception("Invalid number \"" + std::string(p_argument) + "\". " + p_usage, __LINE__, __FILE__);
+        }
+        return l_result;
+    }
+}
+
 //------------------------------------------------------------------------------
 int main(int argc,char ** argv)
 {
     try
     {
-        std::string l_input_values{argc == 2 ? argv[1] : ""};
-        ask l_ask{l_input_values};
+        // Timers and counters of solver phases, only filled when instrumentation is compiled in
+        if(const char * l_stats_name = std::getenv("TURING_MACHINE_SOLVER_STATS"))
+        {
+            instrumentation::dump_at_exit(l_stats_name);
+        }
 
-        std::cout << "How many checkers ?" << std::endl;
-        unsigned int nb_checkers{l_ask.next<unsigned int>()};
-        std::cout << "You define " << nb_checkers << " checkers" << std::endl;
+        if(argc > 1 && std::string(argv[1]) == "--rate")
+        {
+            std::string l_usage = "Usage: " + std::string(argv[0]) + " --rate <input file> <output file>|- [<nb threads>]";
+            if(argc < 4 || argc > 5)
+            {
+                throw quicky_exception::quicky_logic_exception(l_usage, __LINE__, __FILE__);
+            }
+            solver::register_all_checkers();
+            difficulty_rater::rate_file(argv[2], argv[3], argc == 5 ? parse_argument<unsigned int>(argv[4], l_usage) : 0);
+            return 0;
+        }
 
-        solver::register_all_checkers();
-        std::vector<unsigned int> l_checkers_id;
-        do
-        {
-            solver::display_all_checkers();
-            unsigned int l_id{l_ask.next<unsigned int>()};
-            l_checkers_id.emplace_back(l_id);
-        } while (l_checkers_id.size() < nb_checkers);
-
-        turing_machine_solver::solver l_solver(l_checkers_id);
-
-        do
-        {
-            std::cout << "Propose a candidate ?" << std::endl;
-            unsigned int l_candidate_num{l_ask.next<unsigned int>()};
-            candidate l_candidate{l_candidate_num};
-            potential_checkers l_checkers = l_solver.get_related_checkers(l_candidate);
-            int l_checker_index;
-            unsigned int l_remaining_check = 3;
-            do
-            {
-                std::cout << "Current candidate " << l_candidate << " -> " << l_checkers << std::endl;
-                std::cout << "Checker index ? ( -1 to propose a new candidate)" << std::endl;
-                l_checker_index = l_ask.next<int>();
-                if(l_checker_index != -1)
+        if(argc > 1 && std::string(argv[1]) == "--batch")
+        {
+            std::string l_usage = "Usage: " + std::string(argv[0]) + " --batch <input file> [<nb threads> [<solver cache file>]]";
+            if(argc < 3 || argc > 5)
+            {
+                throw quicky_exception::quicky_logic_exception(l_usage, __LINE__, __FILE__);
+            }
+            solver::register_all_checkers();
+            game_runner::run_file(argv[2]
+                                 ,std::cout
+                                 ,argc >= 4 ? parse_argument<unsigned int>(argv[3], l_usage) : 0
+                                 ,argc == 5 ? argv[4] : ""
+                                 );
+            return 0;
+        }
+
+        if(argc > 1 && std::string(argv[1]) == "--replay")
+        {
+            std::string l_usage = "Usage: " + std::string(argv[0]) + " --replay <log directory> [<nb threads> [<expected solutions file>]]";
+            if(argc < 3 || argc > 5)
+            {
+                throw quicky_exception::quicky_logic_exception(l_usage, __LINE__, __FILE__);
+            }
+            log_replayer l_replayer{argc == 5 ? argv[4] : ""};
+            unsigned int l_nb_failures = l_replayer.replay_directory(argv[2]
+                                                                    ,std::cout
+                                                                    ,argc >= 4 ? parse_argument<unsigned int>(argv[3], l_usage) : 0
+                                                                    );
+            return l_nb_failures ? 1 : 0;
+        }
+
+        if(argc > 1 && std::string(argv[1]) == "--regression")
+        {
+            std::string l_usage = "Usage: " + std::string(argv[0]) + " --regression <tests directory> [<nb threads>]";
+            if(argc < 3 || argc > 4)
+            {
+                throw quicky_exception::quicky_logic_exception(l_usage, __LINE__, __FILE__);
+            }
+            unsigned int l_nb_failures = regression_runner::run(argv[2], std::cout, argc == 4 ? parse_argument<unsigned int>(argv[3], l_usage) : 0);
+            return l_nb_failures ? 1 : 0;
+        }
+
+        if(argc > 1 && std::string(argv[1]) == "--cards")
+        {
+            if(argc > 3)
+            {
+                throw quicky_exception::quicky_logic_exception("Usage: " + std::string(argv[0]) + " --cards [<card catalogue file>]", __LINE__, __FILE__);
+            }
+            // Without file, display cards used by solver
+            auto l_start = std::chrono::steady_clock::now();
+            auto l_cards = argc == 3 ? card_catalogue::load_file(argv[2]) : solver::create_all_checkers();
+            auto l_duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - l_start);
+            card_catalogue::display(l_cards, std::cout);
+            std::cout << l_cards.size() << " cards loaded in " << l_duration.count() << "us" << std::endl;
+            return 0;
+        }
+
+        if(argc > 1 && std::string(argv[1]) == "--check-allocations")
+        {
+            if(argc != 3)
+            {
+                throw quicky_exception::quicky_logic_exception("Usage: " + std::string(argv[0]) + " --check-allocations <tests directory>", __LINE__, __FILE__);
+            }
+            if(!allocation_counter::m_enabled)
+            {
+                throw quicky_exception::quicky_logic_exception("Allocation counting is not compiled in, build with ENABLE_ALLOCATION_CHECK", __LINE__, __FILE__);
+            }
+            unsigned int l_nb_failures = regression_runner::check_allocations(argv[2], std::cout);
+            return l_nb_failures ? 1 : 0;
+        }
+
+        if(argc > 1 && std::string(argv[1]) == "--fuzz")
+        {
+            std::string l_usage = "Usage: " + std::string(argv[0]) + " --fuzz <time budget in s> [<nb threads> [<seed> [bitset|map|multi]]]";
+            if(argc < 3 || argc > 6 || (argc == 6 && std::string(argv[5]) != "bitset" && std::string(argv[5]) != "map" && std::string(argv[5]) != "multi"))
+            {
+                throw quicky_exception::quicky_logic_exception(l_usage, __LINE__, __FILE__);
+            }
+            uint64_t l_seed = argc >= 5 ? parse_argument<uint64_t>(argv[4], l_usage) : static_cast<uint64_t>(std::chrono::system_clock::now().time_since_epoch().count());
+            std::chrono::milliseconds l_budget = std::chrono::seconds(parse_argument<unsigned int>(argv[2], l_usage));
+            unsigned int l_nb_threads = argc >= 4 ? parse_argument<unsigned int>(argv[3], l_usage) : 0;
+            // Without engine name budget is shared by bitset engine, map
+            // reference engine and multi game engine
+            bool l_all_engines = argc < 6;
+            auto l_fuzz = [&]<typename ENGINE>(const std::string & p_name, std::chrono::milliseconds p_budget) -> bool
+            {
+                differential_fuzzer<ENGINE> l_fuzzer{l_seed};
+                auto l_start = std::chrono::steady_clock::now();
+                auto l_failure = l_fuzzer.run(p_budget, l_nb_threads);
+                auto l_duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - l_start);
+                std::cout << p_name << ": " << l_fuzzer.get_nb_cases() << " games with " << l_fuzzer.get_nb_checks() << " checks compared in " << l_duration.count() << "ms" << std::endl;
+                if(l_failure)
+                {
+                    std::cout << "DIVERGENCE " << *l_failure << " : " << differential_fuzzer<ENGINE>::compare(*l_failure) << std::endl;
+                }
+                return !l_failure;
+            };
+            bool l_ok = true;
+            if(l_all_engines || std::string(argv[5]) == "bitset")
+            {
+                l_ok = l_fuzz.template operator()<bitset_solver>("bitset", l_all_engines ? l_budget / 3 : l_budget);
+            }
+            if(l_ok && (l_all_engines || std::string(argv[5]) == "map"))
+            {
+                l_ok = l_fuzz.template operator()<map_solver>("map", l_all_engines ? l_budget / 3 : l_budget);
+            }
+            if(l_ok && (l_all_engines || std::string(argv[5]) == "multi"))
+            {
+                l_ok = l_fuzz.template operator()<multi_game_solver>("multi", l_all_engines ? l_budget - 2 * (l_budget / 3) : l_budget);
+            }
+            return l_ok ? 0 : 1;
+        }
+
+        if(argc > 1 && std::string(argv[1]) == "--generate")
+        {
+            std::string l_usage = "Usage: " + std::string(argv[0]) + " --generate <nb puzzles> [<seed> [<min size> <max size> [<min expected checks> <max expected checks>]]]";
+            if(argc != 3 && argc != 4 && argc != 6 && argc != 8)
+            {
+                throw quicky_exception::quicky_logic_exception(l_usage, __LINE__, __FILE__);
+            }
+            puzzle_generator l_generator{argc >= 4 ? parse_argument<uint64_t>(argv[3], l_usage) : static_cast<uint64_t>(std::chrono::system_clock::now().time_since_epoch().count())
+                                        ,argc >= 6 ? parse_argument<unsigned int>(argv[4], l_usage) : 4
+                                        ,argc >= 6 ? parse_argument<unsigned int>(argv[5], l_usage) : 6
+                                        ,argc == 8 ? parse_argument<double>(argv[6], l_usage) : 0
+                                        ,argc == 8 ? parse_argument<double>(argv[7], l_usage) : std::numeric_limits<double>::max()
+                                        };
+            auto l_nb_puzzles = parse_argument<unsigned long>(argv[2], l_usage);
+            auto l_start = std::chrono::steady_clock::now();
+            for(unsigned long l_index = 0; l_index < l_nb_puzzles; ++l_index)
+            {
+                std::cout << l_generator.generate() << '\n';
+            }
+            auto l_duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - l_start);
+            std::cout << l_nb_puzzles << " puzzles generated in " << l_duration.count() << "us from " << l_generator.get_nb_attempts() << " attempts" << std::endl;
+            return 0;
+        }
+
+        if(argc > 1 && std::string(argv[1]) == "--enumerate")
+        {
+            std::string l_usage = "Usage: " + std::string(argv[0]) + " --enumerate <output file> [<shard>/<nb shards> [<nb threads>]]";
+            if(argc < 3 || argc > 5)
+            {
+                throw quicky_exception::quicky_logic_exception(l_usage, __LINE__, __FILE__);
+            }
+            unsigned int l_shard = 0;
+            unsigned int l_nb_shards = 1;
+            if(argc > 3)
+            {
+                std::string l_shard_arg{argv[3]};
+                size_t l_separator = l_shard_arg.find('/');
+                if(std::string::npos == l_separator)
                 {
-                    std::cout << "Checker result ?" << std::endl;
-                    bool l_result{static_cast<bool>(l_ask.next<unsigned int>())};
-                    std::cout << "You entered result " << l_result << std::endl;
-                    --l_remaining_check;
-                    l_solver.analyze_result(l_checkers, static_cast<unsigned int>(l_checker_index), l_result);
+                    throw quicky_exception::quicky_logic_exception("Bad shard specification " + l_shard_arg, __LINE__, __FILE__);
                 }
-            } while(l_remaining_check && l_checker_index != -1 && l_solver.get_remaining_candidates() > 1);
+                l_shard = parse_argument<unsigned int>(std::string_view{l_shard_arg}.substr(0, l_separator), l_usage);
+                l_nb_shards = parse_argument<unsigned int>(std::string_view{l_shard_arg}.substr(l_separator + 1), l_usage);
+            }
+            solver::register_all_checkers();
+            puzzle_enumerator l_enumerator{solver::get_checker_ids()};
+            l_enumerator.run(l_shard, l_nb_shards, argv[2], argc == 5 ? parse_argument<unsigned int>(argv[4], l_usage) : 0);
+            return 0;
+        }
+
+        if(argc > 1 && std::string(argv[1]) == "--build-database")
+        {
+            if(argc < 4)
+            {
+                throw quicky_exception::quicky_logic_exception("Usage: " + std::string(argv[0]) + " --build-database <output file> <enumeration file>...", __LINE__, __FILE__);
+            }
+            uint64_t l_nb_records = puzzle_database::build({argv + 3, argv + argc}, argv[2]);
+            std::cout << l_nb_records << " puzzles stored in " << argv[2] << std::endl;
+            return 0;
+        }
 
-        } while(l_solver.get_remaining_candidates() > 1);
+        if(argc > 1 && std::string(argv[1]) == "--server")
+        {
+            std::string l_usage = "Usage: " + std::string(argv[0]) + " --server <socket path>|- [<session timeout in s> [<nb threads>]]";
+            if(argc < 3 || argc > 5)
+            {
+                throw quicky_exception::quicky_logic_exception(l_usage, __LINE__, __FILE__);
+            }
+            solver::register_all_checkers();
+            game_server l_server{std::chrono::seconds(argc >= 4 ? parse_argument<unsigned int>(argv[3], l_usage) : 600)};
+            if(std::string(argv[2]) == "-")
+            {
+                l_server.serve(std::cin, std::cout);
+            }
+            else
+            {
+                l_server.serve(std::string(argv[2]), argc == 5 ? parse_argument<unsigned int>(argv[4], l_usage) : 0);
+            }
+            return 0;
+        }
+
+        interactive_game l_game;
+        std::string l_input_values;
+        std::string l_log_name{"turing.log"};
+        bool l_echo = true;
+        int l_arg_index = 1;
+        while(l_arg_index < argc && std::string(argv[l_arg_index]).starts_with("--"))
+        {
+            std::string l_option{argv[l_arg_index]};
+            if("--nightmare" == l_option)
+            {
+                l_game.set_nightmare(true);
+            }
+            else if("--planner" == l_option && l_arg_index + 1 < argc)
+            {
+                // Time budget in milliseconds of query suggestion
+                l_game.set_planner_budget(parse_argument<unsigned int>(argv[++l_arg_index], "Usage: " + std::string(argv[0]) + " --planner <time budget in ms>"));
+            }
+            else if("--quiet" == l_option)
+            {
+                // Only questions and solution are displayed
+                output_sink::get_console().set_level(verbosity::QUIET);
+            }
+            else if("--debug" == l_option)
+            {
+                // Display all candidates and checker combinations examined by solver
+                output_sink::get_console().set_level(verbosity::DEBUG);
+            }
+            else if("--script" == l_option && l_arg_index + 1 < argc)
+            {
+                // Scripted values read from a file instead of command line
+                l_input_values = ask::read_script(argv[++l_arg_index]);
+            }
+            else if("--no-echo" == l_option)
+            {
+                l_echo = false;
+            }
+            else if("--no-log" == l_option)
+            {
+                l_log_name.clear();
+            }
+            else if("--database" == l_option && l_arg_index + 1 < argc)
+            {
+                // Database of puzzles with a single solution, consulted before solving
+                l_game.set_database(argv[++l_arg_index]);
+            }
+            else
+            {
+                throw quicky_exception::quicky_logic_exception("Unknown option " + l_option, __LINE__, __FILE__);
+            }
+            ++l_arg_index;
+        }
+        if(argc == l_arg_index + 1)
+        {
+            l_input_values = argv[l_arg_index];
+        }
+        ask l_ask{std::move(l_input_values), std::cout, l_log_name, l_echo};
+
+        solver::register_all_checkers();
+        // Scripted values are immediately available, game only waits for
+        // values typed on standard input
+        game_task l_task = l_game.play(l_ask);
+        std::string l_value;
+        while(!l_task.is_done() && std::cin >> l_value)
+        {
+            l_ask.push(l_value);
+        }
+        if(!l_task.is_done())
+        {
+            l_ask.close();
+        }
+        l_task.rethrow_if_failed();
     }
     catch(quicky_exception::quicky_runtime_exception & e)
     {
@@ -0,0 +1,358 @@
+/*    This file is part of turing_machine_solver
+      Copyright (C) 2024  Julien Thevenon ( julien_thevenon at yahoo.fr )
+
+      This program is free software: you can redistribute it and/or modify
+      it under the terms of the GNU General Public License as published by
+      the Free Software Foundation, either version 3 of the License, or
+      (at your option) any later version.
+
+      This program is distributed in the hope that it will be useful,
+      but WITHOUT ANY WARRANTY; without even the implied warranty of
+      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+      GNU General Public License for more details.
+
+      You should have received a copy of the GNU General Public License
+      along with this program.  If not, see <http://www.gnu.org/licenses/>
+*/
+#include "turing_machine_solver_api.h"
+#include "solver.h"
+#include "criteria_space.h"
+#include "planner.h"
+#include "suggestion_cache.h"
+#include "puzzle_database.h"
+#include "quicky_exception.h"
+#include <new>
+#include <optional>
+#include <cstring>
+
+using namespace turing_machine_solver;
+
+struct tms_game
+{
+    tms_game(const std::vector<unsigned int> & p_checkers_id
+            ,const std::vector<std::shared_ptr<checker_if>> & p_checkers
+            ,bool p_owns_storage
+            )
+    :m_checkers_id{p_checkers_id}
+    ,m_solver{solver::get_registry(), p_checkers_id, false}
+    ,m_space{p_checkers}
+    ,m_criteria{m_space.get_all_indexes()}
+    ,m_planner{m_space}
+    ,m_owns_storage{p_owns_storage}
+    ,m_error{}
+    {
+    }
+
+    void
+    set_error(const char * p_message)
+    {
+        std::strncpy(m_error, p_message, sizeof(m_error) - 1);
+    }
+
+    std::vector<unsigned int> m_checkers_id;
+
+    solver m_solver;
+
+    criteria_space m_space;
+
+    std::vector<unsigned int> m_criteria;
+
+    planner m_planner;
+
+    bool m_owns_storage;
+
+    char m_error[256];
+};
+
+struct tms_database
+{
+    explicit
+    tms_database(const std::string & p_file_name)
+    :m_database{p_file_name}
+    {
+    }
+
+    puzzle_database m_database;
+};
+
+namespace
+{
+    //-------------------------------------------------------------------------
+    /**
+     * Run an operation on a game converting exceptions to status
+     */
+    template <typename FUNC>
+    tms_status
+    protect(tms_game * p_game
+           ,FUNC p_func
+           )
+    {
+        if(!p_game)
+        {
+            return TMS_INVALID_ARGUMENT;
+        }
+        p_game->m_error[0] = '\0';
+        try
+        {
+            return p_func();
+        }
+        catch(quicky_exception::quicky_logic_exception & e)
+        {
+            p_game->set_error(e.what());
+            return TMS_INVALID_ARGUMENT;
+        }
+        catch(std::exception & e)
+        {
+            p_game->set_error(e.what());
+            return TMS_INTERNAL_ERROR;
+        }
+    }
+
+    //-------------------------------------------------------------------------
+    unsigned int
+    to_code(const candidate & p_candidate)
+    {
+        return 100 * p_candidate.get_blue_triangle() + 10 * p_candidate.get_yellow_square() + p_candidate.get_purple_circle();
+    }
+}
+
+//-----------------------------------------------------------------------------
+unsigned int
+tms_api_version(void)
+{
+    return TMS_API_VERSION;
+}
+
+//-----------------------------------------------------------------------------
+size_t
+tms_game_storage_size(void)
+{
+    return sizeof(tms_game);
+}
+
+//-----------------------------------------------------------------------------
+size_t
+tms_game_storage_alignment(void)
+{
+    return alignof(tms_game);
+}
+
+//-----------------------------------------------------------------------------
+tms_status
+tms_game_open(const unsigned int * p_checkers_id
+             ,size_t p_nb_checkers
+             ,void * p_storage
+             ,size_t p_storage_size
+             ,tms_game ** p_game
+             )
+{
+    if(!p_checkers_id || !p_nb_checkers || !p_game)
+    {
+        return TMS_INVALID_ARGUMENT;
+    }
+    *p_game = nullptr;
+    if(p_storage && (p_storage_size < sizeof(tms_game) || reinterpret_cast<uintptr_t>(p_storage) % alignof(tms_game)))
+    {
+        return TMS_BUFFER_TOO_SMALL;
+    }
+    try
+    {
+        std::vector<unsigned int> l_checkers_id{p_checkers_id, p_checkers_id + p_nb_checkers};
+        std::vector<std::shared_ptr<checker_if>> l_checkers;
+        for(auto l_id: l_checkers_id)
+        {
+            l_checkers.emplace_back(solver::get_registry().get_checker(l_id));
+        }
+        *p_game = p_storage ? new(p_storage) tms_game{l_checkers_id, l_checkers, false} : new tms_game{l_checkers_id, l_checkers, true};
+        return TMS_OK;
+    }
+    catch(quicky_exception::quicky_logic_exception &)
+    {
+        return TMS_INVALID_ARGUMENT;
+    }
+    catch(std::exception &)
+    {
+        return TMS_INTERNAL_ERROR;
+    }
+}
+
+//-----------------------------------------------------------------------------
+tms_status
+tms_game_apply(tms_game * p_game
+              ,unsigned int p_code
+              ,unsigned int p_checker_index
+              ,int p_result
+              ,unsigned int * p_remaining
+              )
+{
+    return protect(p_game
+                  ,[&]()
+                   {
+                       if(p_checker_index >= p_game->m_space.get_nb_checkers())
+                       {
+                           p_game->set_error("Bad checker index");
+                           return TMS_INVALID_ARGUMENT;
+                       }
+                       candidate l_candidate{p_code};
+                       p_game->m_solver.analyze_result(l_candidate, p_checker_index, p_result);
+                       p_game->m_planner.filter(p_game->m_criteria, condition_table::code_index(l_candidate), p_checker_index, p_result);
+                       if(p_remaining)
+                       {
+                           *p_remaining = p_game->m_solver.get_remaining_candidates();
+                       }
+                       return TMS_OK;
+                   }
+                  );
+}
+
+//-----------------------------------------------------------------------------
+tms_status
+tms_game_remaining_codes(const tms_game * p_game
+                        ,unsigned int * p_codes
+                        ,size_t p_capacity
+                        ,size_t * p_nb_codes
+                        )
+{
+    if(!p_game || !p_nb_codes || (p_capacity && !p_codes))
+    {
+        return TMS_INVALID_ARGUMENT;
+    }
+    code_set l_codes = p_game->m_solver.get_remaining_codes();
+    *p_nb_codes = l_codes.count();
+    size_t l_index = 0;
+    for(unsigned int l_code_index = 0; l_code_index < condition_table::m_nb_codes && l_index < p_capacity; ++l_code_index)
+    {
+        if(l_codes.test(l_code_index))
+        {
+            p_codes[l_index++] = to_code(condition_table::index_code(l_code_index));
+        }
+    }
+    return *p_nb_codes > p_capacity ? TMS_BUFFER_TOO_SMALL : TMS_OK;
+}
+
+//-----------------------------------------------------------------------------
+tms_status
+tms_game_suggest(tms_game * p_game
+                ,unsigned int p_budget_us
+                ,unsigned int * p_code
+                ,unsigned int * p_checker_index
+                ,double * p_expected
+                )
+{
+    if(!p_code || !p_checker_index)
+    {
+        return TMS_INVALID_ARGUMENT;
+    }
+    return protect(p_game
+                  ,[&]()
+                   {
+                       if(p_game->m_criteria.empty())
+                       {
+                           p_game->set_error("No criteria compatible with answers");
+                           return TMS_NO_SOLUTION;
+                       }
+                       query_suggestion l_suggestion = suggestion_cache::get_shared().suggest(p_game->m_planner
+                                                                                             ,p_game->m_checkers_id
+                                                                                             ,p_game->m_criteria
+                                                                                             ,std::chrono::microseconds(p_budget_us)
+                                                                                             ,p_game->m_solver.get_remaining_codes()
+                                                                                             ).m_suggestion;
+                       *p_code = to_code(l_suggestion.get_candidate());
+                       *p_checker_index = l_suggestion.get_checker_index();
+                       if(p_expected)
+                       {
+                           *p_expected = l_suggestion.get_score();
+                       }
+                       return TMS_OK;
+                   }
+                  );
+}
+
+//-----------------------------------------------------------------------------
+const char *
+tms_game_last_error(const tms_game * p_game)
+{
+    return p_game ? p_game->m_error : "";
+}
+
+//-----------------------------------------------------------------------------
+void
+tms_game_close(tms_game * p_game)
+{
+    if(!p_game)
+    {
+        return;
+    }
+    if(p_game->m_owns_storage)
+    {
+        delete p_game;
+    }
+    else
+    {
+        p_game->~tms_game();
+    }
+}
+
+//-----------------------------------------------------------------------------
+tms_status
+tms_database_open(const char * p_file_name
+                 ,tms_database ** p_database
+                 )
+{
+    if(!p_file_name || !p_database)
+    {
+        return TMS_INVALID_ARGUMENT;
+    }
+    *p_database = nullptr;
+    try
+    {
+        *p_database = new tms_database{p_file_name};
+        return TMS_OK;
+    }
+    catch(quicky_exception::quicky_runtime_exception &)
+    {
+        // Missing file or file which is not a database
+        return TMS_INVALID_ARGUMENT;
+    }
+    catch(std::exception &)
+    {
+        return TMS_INTERNAL_ERROR;
+    }
+}
+
+//-----------------------------------------------------------------------------
+tms_status
+tms_database_find(const tms_database * p_database
+                 ,const unsigned int * p_checkers_id
+                 ,size_t p_nb_checkers
+                 ,unsigned int * p_code
+                 ,int * p_found
+                 )
+{
+    if(!p_database || !p_checkers_id || !p_nb_checkers || !p_code || !p_found)
+    {
+        return TMS_INVALID_ARGUMENT;
+    }
+    try
+    {
+        std::optional<puzzle_record> l_record = p_database->m_database.find({p_checkers_id, p_checkers_id + p_nb_checkers});
+        *p_found = l_record.has_value();
+        if(l_record)
+        {
+            *p_code = to_code(condition_table::index_code(l_record->get_code_index()));
+        }
+        return TMS_OK;
+    }
+    catch(std::exception &)
+    {
+        return TMS_INTERNAL_ERROR;
+    }
+}
+
+//-----------------------------------------------------------------------------
+void
+tms_database_close(tms_database * p_database)
+{
+    delete p_database;
+}
+//EOF